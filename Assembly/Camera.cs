@@ -16,37 +16,37 @@ namespace MintyEngine
     {
         public Perspective Perspective
         {
-            get => (Perspective)Runtime.Camera_GetPerspective(Entity.ID);
-            set => Runtime.Camera_SetPerspective(Entity.ID, (int)value);
+            get => (Perspective)Runtime.Camera_GetPerspective(Entity.ID, ref Entity.Handle);
+            set => Runtime.Camera_SetPerspective(Entity.ID, ref Entity.Handle, (int)value);
         }
 
         public float FOV
         {
-            get => Runtime.Camera_GetFov(Entity.ID);
-            set => Runtime.Camera_SetFov(Entity.ID, (float)value);
+            get => Runtime.Camera_GetFov(Entity.ID, ref Entity.Handle);
+            set => Runtime.Camera_SetFov(Entity.ID, ref Entity.Handle, (float)value);
         }
 
         public float Near
         {
-            get => Runtime.Camera_GetNear(Entity.ID);
-            set => Runtime.Camera_SetNear(Entity.ID, (float)value);
+            get => Runtime.Camera_GetNear(Entity.ID, ref Entity.Handle);
+            set => Runtime.Camera_SetNear(Entity.ID, ref Entity.Handle, (float)value);
         }
 
         public float Far
         {
-            get => Runtime.Camera_GetFar(Entity.ID);
-            set => Runtime.Camera_SetFar(Entity.ID, (float)value);
+            get => Runtime.Camera_GetFar(Entity.ID, ref Entity.Handle);
+            set => Runtime.Camera_SetFar(Entity.ID, ref Entity.Handle, (float)value);
         }
 
         public Color Color
         {
-            get => Color.FromInt(Runtime.Camera_GetColor(Entity.ID));
-            set => Runtime.Camera_SetColor(Entity.ID, value.ToInt());
+            get => Color.FromInt(Runtime.Camera_GetColor(Entity.ID, ref Entity.Handle));
+            set => Runtime.Camera_SetColor(Entity.ID, ref Entity.Handle, value.ToInt());
         }
 
         internal Camera()
         { }
 
-        public void SetAsMain() => Runtime.Camera_SetAsMain(Entity.ID);
+        public void SetAsMain() => Runtime.Camera_SetAsMain(Entity.ID, ref Entity.Handle);
     }
 }
@@ -13,6 +13,9 @@ namespace MintyEngine
     {
         internal readonly ulong ID;
 
+        // the native Entity, cached by the Runtime so it does not need to find it by its ID each call
+        internal EntityHandle Handle;
+
         public string Name
         {
             get => Runtime.Entity_GetName(ID);
@@ -27,8 +30,8 @@ namespace MintyEngine
 
         public bool Enabled
         {
-            get => Runtime.Entity_GetEnabled(ID);
-            set => Runtime.Entity_SetEnabled(ID, value);
+            get => Runtime.Entity_GetEnabled(ID, ref Handle);
+            set => Runtime.Entity_SetEnabled(ID, ref Handle, value);
         }
 
         public Entity Parent
@@ -0,0 +1,15 @@
+﻿using System.Runtime.InteropServices;
+
+namespace MintyEngine
+{
+    /// <summary>
+    /// The native Entity that an Entity refers to, cached by the Runtime.
+    /// The handle is only used while the generation matches the loaded EntityRegistry. A generation of 0 is never valid.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct EntityHandle
+    {
+        internal uint Entity;
+        internal uint Generation;
+    }
+}
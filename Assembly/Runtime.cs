@@ -13,6 +13,8 @@ namespace MintyEngine
         #region Time
         [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Time_GetTotalTime();
         [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Time_GetElapsedTime();
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Time_GetFixedStep();
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Time_GetFixedAlpha();
         #endregion
 
         #region Console
@@ -38,8 +40,8 @@ namespace MintyEngine
         [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Entity_SetName(ulong id, string name);
         [MethodImpl(MethodImplOptions.InternalCall)] internal extern static string Entity_GetTag(ulong id);
         [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Entity_SetTag(ulong id, string tag);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static bool Entity_GetEnabled(ulong id);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Entity_SetEnabled(ulong id, bool enabled);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static bool Entity_GetEnabled(ulong id, ref EntityHandle handle);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Entity_SetEnabled(ulong id, ref EntityHandle handle, bool enabled);
         [MethodImpl(MethodImplOptions.InternalCall)] internal extern static object Entity_AddComponent(ulong id, Type type);
         [MethodImpl(MethodImplOptions.InternalCall)] internal extern static object Entity_GetComponent(ulong id, Type type);
         [MethodImpl(MethodImplOptions.InternalCall)] internal extern static bool Entity_RemoveComponent(ulong id, Type type);
@@ -65,29 +67,31 @@ namespace MintyEngine
         #region Components
 
         #region Camera
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static int Camera_GetPerspective(ulong id);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetPerspective(ulong id, int perspective);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Camera_GetFov(ulong id);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetFov(ulong id, float perspective);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Camera_GetNear(ulong id);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetNear(ulong id, float perspective);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Camera_GetFar(ulong id);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetFar(ulong id, float perspective);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetAsMain(ulong id);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetColor(ulong id, int color);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static int Camera_GetColor(ulong id);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static int Camera_GetPerspective(ulong id, ref EntityHandle handle);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetPerspective(ulong id, ref EntityHandle handle, int perspective);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Camera_GetFov(ulong id, ref EntityHandle handle);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetFov(ulong id, ref EntityHandle handle, float perspective);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Camera_GetNear(ulong id, ref EntityHandle handle);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetNear(ulong id, ref EntityHandle handle, float perspective);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static float Camera_GetFar(ulong id, ref EntityHandle handle);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetFar(ulong id, ref EntityHandle handle, float perspective);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetAsMain(ulong id, ref EntityHandle handle);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Camera_SetColor(ulong id, ref EntityHandle handle, int color);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static int Camera_GetColor(ulong id, ref EntityHandle handle);
         #endregion
 
         #region Transform
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetLocalPosition(ulong id, out Vector3 position);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_SetLocalPosition(ulong id, in Vector3 position);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetLocalRotation(ulong id, out Vector4 position);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_SetLocalRotation(ulong id, in Vector4 position);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetLocalScale(ulong id, out Vector3 position);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_SetLocalScale(ulong id, in Vector3 position);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetRight(ulong id, out Vector3 position);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetUp(ulong id, out Vector3 position);
-        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetForward(ulong id, out Vector3 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetLocalPosition(ulong id, ref EntityHandle handle, out Vector3 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_SetLocalPosition(ulong id, ref EntityHandle handle, in Vector3 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetLocalRotation(ulong id, ref EntityHandle handle, out Vector4 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_SetLocalRotation(ulong id, ref EntityHandle handle, in Vector4 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetLocalScale(ulong id, ref EntityHandle handle, out Vector3 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_SetLocalScale(ulong id, ref EntityHandle handle, in Vector3 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetRight(ulong id, ref EntityHandle handle, out Vector3 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetUp(ulong id, ref EntityHandle handle, out Vector3 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetForward(ulong id, ref EntityHandle handle, out Vector3 position);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_GetMany(ulong[] ids, TransformData[] transforms, int count);
+        [MethodImpl(MethodImplOptions.InternalCall)] internal extern static void Transform_SetMany(ulong[] ids, TransformData[] transforms, int count);
         #endregion
 
         #endregion
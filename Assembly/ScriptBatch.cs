@@ -0,0 +1,71 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Reflection;
+
+namespace MintyEngine
+{
+    /// <summary>
+    /// Calls the same method on many Scripts of the same type, with one call from the Runtime.
+    /// </summary>
+    internal static class ScriptBatch
+    {
+        /// <summary>
+        /// Calls a method on an array of Scripts.
+        /// </summary>
+        private abstract class Invoker
+        {
+            public abstract void Invoke(Script[] scripts, int count);
+        }
+
+        /// <summary>
+        /// Calls a method on an array of Scripts of type T, through a delegate bound to the method once.
+        /// </summary>
+        private sealed class Invoker<T> : Invoker where T : Script
+        {
+            private readonly Action<T> _method;
+
+            public Invoker(MethodInfo method)
+            {
+                _method = (Action<T>)Delegate.CreateDelegate(typeof(Action<T>), method);
+            }
+
+            public override void Invoke(Script[] scripts, int count)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    try
+                    {
+                        _method((T)scripts[i]);
+                    }
+                    catch (Exception e)
+                    {
+                        Debug.Error(e);
+                    }
+                }
+            }
+        }
+
+        private static readonly Dictionary<Type, Invoker> _updateInvokers = new Dictionary<Type, Invoker>();
+
+        /// <summary>
+        /// Called by the Runtime with every Script of one type that is updated this frame.
+        /// </summary>
+        /// <param name="scripts">The Scripts, which are all of the same type.</param>
+        /// <param name="count">The number of Scripts within the array to update.</param>
+        internal static void Update(Script[] scripts, int count)
+        {
+            if (count <= 0) return;
+
+            Type type = scripts[0].GetType();
+
+            if (!_updateInvokers.TryGetValue(type, out Invoker invoker))
+            {
+                MethodInfo method = type.GetMethod("OnUpdate", BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic, null, Type.EmptyTypes, null);
+                invoker = (Invoker)Activator.CreateInstance(typeof(Invoker<>).MakeGenericType(type), method);
+                _updateInvokers.Add(type, invoker);
+            }
+
+            invoker.Invoke(scripts, count);
+        }
+    }
+}
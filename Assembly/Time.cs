@@ -20,5 +20,21 @@ namespace MintyEngine
         {
             get => Runtime.Time_GetElapsedTime();
         }
+
+        /// <summary>
+        /// The length of one fixed update step, in seconds.
+        /// </summary>
+        public static float FixedStep
+        {
+            get => Runtime.Time_GetFixedStep();
+        }
+
+        /// <summary>
+        /// How far the current frame is between the last fixed update and the next one, from 0 to 1.
+        /// </summary>
+        public static float FixedAlpha
+        {
+            get => Runtime.Time_GetFixedAlpha();
+        }
     }
 }
@@ -12,37 +12,37 @@ namespace MintyEngine
         {
             get
             {
-                Runtime.Transform_GetLocalPosition(Entity.ID, out Vector3 position);
+                Runtime.Transform_GetLocalPosition(Entity.ID, ref Entity.Handle, out Vector3 position);
                 return position;
             }
-            set => Runtime.Transform_SetLocalPosition(Entity.ID, value);
+            set => Runtime.Transform_SetLocalPosition(Entity.ID, ref Entity.Handle, value);
         }
 
         public Quaternion LocalRotation
         {
             get
             {
-                Runtime.Transform_GetLocalRotation(Entity.ID, out Vector4 rotation);
+                Runtime.Transform_GetLocalRotation(Entity.ID, ref Entity.Handle, out Vector4 rotation);
                 return new Quaternion(rotation.X, rotation.Y, rotation.Z, rotation.W);
             }
-            set => Runtime.Transform_SetLocalRotation(Entity.ID, new Vector4(value.X, value.Y, value.Z, value.W));
+            set => Runtime.Transform_SetLocalRotation(Entity.ID, ref Entity.Handle, new Vector4(value.X, value.Y, value.Z, value.W));
         }
 
         public Vector3 LocalScale
         {
             get
             {
-                Runtime.Transform_GetLocalScale(Entity.ID, out Vector3 scale);
+                Runtime.Transform_GetLocalScale(Entity.ID, ref Entity.Handle, out Vector3 scale);
                 return scale;
             }
-            set => Runtime.Transform_SetLocalScale(Entity.ID, value);
+            set => Runtime.Transform_SetLocalScale(Entity.ID, ref Entity.Handle, value);
         }
 
         public Vector3 Right
         {
             get
             {
-                Runtime.Transform_GetRight(Entity.ID, out Vector3 right);
+                Runtime.Transform_GetRight(Entity.ID, ref Entity.Handle, out Vector3 right);
                 return right;
             }
         }
@@ -51,7 +51,7 @@ namespace MintyEngine
         {
             get
             {
-                Runtime.Transform_GetUp(Entity.ID, out Vector3 up);
+                Runtime.Transform_GetUp(Entity.ID, ref Entity.Handle, out Vector3 up);
                 return up;
             }
         }
@@ -60,12 +60,57 @@ namespace MintyEngine
         {
             get
             {
-                Runtime.Transform_GetForward(Entity.ID, out Vector3 forward);
+                Runtime.Transform_GetForward(Entity.ID, ref Entity.Handle, out Vector3 forward);
                 return forward;
             }
         }
 
+        // the IDs of the Entities passed to GetMany and SetMany, reused between calls
+        private static ulong[] _ids = new ulong[0];
+
         internal Transform()
         { }
+
+        /// <summary>
+        /// Gets the local position, rotation and scale of the Transforms on many Entities at once.
+        /// </summary>
+        /// <param name="entities">The Entities to get the Transforms of.</param>
+        /// <param name="transforms">The array to fill with the Transform data, in the same order as the Entities.</param>
+        /// <param name="count">The number of Entities to get the Transforms of.</param>
+        public static void GetMany(Entity[] entities, TransformData[] transforms, int count)
+        {
+            Runtime.Transform_GetMany(GetIDs(entities, transforms, count), transforms, count);
+        }
+
+        /// <summary>
+        /// Sets the local position, rotation and scale of the Transforms on many Entities at once.
+        /// </summary>
+        /// <param name="entities">The Entities to set the Transforms of.</param>
+        /// <param name="transforms">The Transform data to set, in the same order as the Entities.</param>
+        /// <param name="count">The number of Entities to set the Transforms of.</param>
+        public static void SetMany(Entity[] entities, TransformData[] transforms, int count)
+        {
+            Runtime.Transform_SetMany(GetIDs(entities, transforms, count), transforms, count);
+        }
+
+        private static ulong[] GetIDs(Entity[] entities, TransformData[] transforms, int count)
+        {
+            if (count < 0 || count > entities.Length || count > transforms.Length)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+
+            if (_ids.Length < count)
+            {
+                _ids = new ulong[count];
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                _ids[i] = entities[i].ID;
+            }
+
+            return _ids;
+        }
     }
 }
@@ -0,0 +1,15 @@
+﻿using System.Runtime.InteropServices;
+
+namespace MintyEngine
+{
+    /// <summary>
+    /// The local position, rotation and scale of a Transform, used to get or set many Transforms at once.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TransformData
+    {
+        public Vector3 LocalPosition;
+        public Quaternion LocalRotation;
+        public Vector3 LocalScale;
+    }
+}
@@ -3,7 +3,7 @@ push: object
     offset: 0
     size: 64
 uniform: camera
-    type: UNIFORM_BUFFER
+    type: UNIFORM_BUFFER_DYNAMIC
     stageFlags: VERTEX_BIT
     set: 0
     binding: 0
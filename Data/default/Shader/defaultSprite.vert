@@ -6,7 +6,7 @@ layout(set = 0, binding = 0) uniform CameraBufferObject {
     mat4 transform;
 } camera;
 
-layout(push_constant) uniform SpriteObject
+struct SpriteObject
 {
     mat4 transform;
     vec4 color;
@@ -14,12 +14,20 @@ layout(push_constant) uniform SpriteObject
     vec2 maxCoords;
     vec2 pivot;
     vec2 size;
-} object;
+};
+
+// every sprite drawn this frame, sprites sharing a material are drawn together as instances
+layout(std430, set = 0, binding = 1) readonly buffer SpriteInstances
+{
+    SpriteObject objects[];
+} instances;
 
 layout(location = 0) out vec4 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
 
 void main() {
+    SpriteObject object = instances.objects[gl_InstanceIndex];
+
     //gl_VertexIndex
     vec2 vertices[6] =
     {
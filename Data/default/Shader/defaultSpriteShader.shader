@@ -1,13 +1,15 @@
-push: object
-    stageFlags: VERTEX_BIT
-    offset: 0
-    size: 112
 uniform: camera
-    type: UNIFORM_BUFFER
+    type: UNIFORM_BUFFER_DYNAMIC
     stageFlags: VERTEX_BIT
     set: 0
     binding: 0
     size: 64
+uniform: instances
+    type: STORAGE_BUFFER
+    stageFlags: VERTEX_BIT
+    set: 0
+    binding: 1
+    size: 112
 uniform: texture
     type: COMBINED_IMAGE_SAMPLER
     stageFlags: FRAGMENT_BIT
@@ -363,17 +363,17 @@ void Mintye::AssetsWindow::set_path(Minty::Path const& path)
 
 			for (size_t j = 0; j < wrap.get_entry_count(); j++)
 			{
-				Wrap::Entry const& entry = wrap.get_entry(j);
+				Path const entryPath = wrap.get_entry_path(j);
 
 				// ignore meta
-				if (Asset::get_type(entry.path) == AssetType::Meta) continue;
+				if (Asset::get_type(entryPath) == AssetType::Meta) continue;
 
 				// for now, add directly
 				_files.push_back(FileData
 					{
-						.path = entry.path,
-						.canIncludeInScene = !cannotIncludeToScene.contains(Asset::get_type(entry.path)),
-						.includedInScene = scene && scene->is_registered(Path(wrap.get_base_path()) / entry.path),
+						.path = entryPath,
+						.canIncludeInScene = !cannotIncludeToScene.contains(Asset::get_type(entryPath)),
+						.includedInScene = scene && scene->is_registered(Path(wrap.get_base_path()) / entryPath),
 					});
 			}
 		}
@@ -21,6 +21,7 @@
 #include <filesystem> // for accessing file system
 #include <fstream> // for accessing files
 #include <chrono> // for time
+#include <map>
 #include <format>
 
 #include <cstdio>
@@ -869,6 +870,10 @@ void EditorApplication::draw_commands()
 	{
 		open_project_directory();
 	}
+	if (ImGui::Button("Benchmark Wraps"))
+	{
+		benchmark_project_wraps();
+	}
 
 	if (disabled)
 	{
@@ -1191,6 +1196,87 @@ void Mintye::EditorApplication::generate_wraps()
 	std::filesystem::copy("default.wrap", output / "default.wrap");
 }
 
+void Mintye::EditorApplication::benchmark_wraps()
+{
+	// wrap the assets into a scratch directory, so the build is not touched
+	Path directory = _project->get_build_path() / "Benchmark";
+	std::filesystem::create_directories(directory);
+
+	std::vector<Wrap::Source> sources = _project->get_wrap_sources();
+	uint32_t const count = static_cast<uint32_t>(sources.size());
+
+	// total size of the files being wrapped, so both paths are measured against the same input
+	size_t size = 0;
+	for (Wrap::Source const& source : sources)
+	{
+		if (std::filesystem::is_regular_file(source.physicalPath))
+		{
+			size += static_cast<size_t>(std::filesystem::file_size(source.physicalPath));
+		}
+	}
+	float const megabytes = static_cast<float>(size) / (1024.0f * 1024.0f);
+
+	// one emplace per asset, each opening, compressing, writing the table and closing on this thread
+	Stopwatch entryWatch = Stopwatch::start_new();
+	{
+		Wrap wrap(directory / String("entry").append(EXTENSION_WRAP), ASSETS_DIRECTORY_NAME, count, ASSETS_DIRECTORY_NAME);
+		for (Wrap::Source const& source : sources)
+		{
+			wrap.emplace(source.physicalPath, source.virtualPath, source.compression, source.reservedSize, source.codec);
+		}
+	}
+	entryWatch.stop();
+
+	// one batch, compressed in parallel and written once
+	Stopwatch batchWatch = Stopwatch::start_new();
+	{
+		Wrap wrap(directory / String("batch").append(EXTENSION_WRAP), ASSETS_DIRECTORY_NAME, count, ASSETS_DIRECTORY_NAME);
+		wrap.emplace(sources);
+	}
+	batchWatch.stop();
+
+	// read back every entry of the batch, grouped by codec, so the codecs can be compared on the same assets
+	struct DecodeStats
+	{
+		size_t count = 0;
+		size_t size = 0;
+		Stopwatch watch;
+	};
+	std::map<String, DecodeStats> decodeStats;
+	DecodeStats storedStats;
+	{
+		Wrap wrap(directory / String("batch").append(EXTENSION_WRAP));
+		std::vector<char> buffer;
+		for (size_t i = 0; i < wrap.get_entry_count(); i++)
+		{
+			Wrap::Entry const& entry = wrap.get_entry(i);
+			DecodeStats& stats = entry.compressionLevel ? decodeStats[get_compression_codec_name(static_cast<CompressionCodec>(entry.codec))] : storedStats;
+
+			stats.watch.start();
+			std::span<char const> data = wrap.read_entry_view(i, buffer);
+			stats.watch.stop();
+
+			stats.count++;
+			stats.size += data.size();
+		}
+	}
+
+	float const entrySeconds = std::max(entryWatch.elapsed_s(), 0.001f);
+	float const batchSeconds = std::max(batchWatch.elapsed_s(), 0.001f);
+	MINTY_LOG_FORMAT("Wrapped {} assets ({:.2f} MB) one at a time in {:.2f}s ({:.2f} MB/s).", count, megabytes, entrySeconds, megabytes / entrySeconds);
+	MINTY_LOG_FORMAT("Wrapped {} assets ({:.2f} MB) as a batch in {:.2f}s ({:.2f} MB/s), {:.2f}x faster.", count, megabytes, batchSeconds, megabytes / batchSeconds, entrySeconds / batchSeconds);
+	for (auto const& [name, stats] : decodeStats)
+	{
+		float const decodedMegabytes = static_cast<float>(stats.size) / (1024.0f * 1024.0f);
+		float const decodeSeconds = std::max(stats.watch.elapsed_s(), 0.000001f);
+		MINTY_LOG_FORMAT("Uncompressed {} {} assets ({:.2f} MB) in {:.4f}s ({:.2f} MB/s).", stats.count, name, decodedMegabytes, decodeSeconds, decodedMegabytes / decodeSeconds);
+	}
+	// stored assets are views into the mapped file, so there is no decode time to report
+	MINTY_LOG_FORMAT("Read {} stored assets ({:.2f} MB) without uncompressing.", storedStats.count, static_cast<float>(storedStats.size) / (1024.0f * 1024.0f));
+
+	std::filesystem::remove_all(directory);
+}
+
 void Mintye::EditorApplication::generate_assembly()
 {
 	ConsoleWindow* console = find_editor_window<ConsoleWindow>("Console");
@@ -1437,6 +1523,33 @@ void EditorApplication::build_project()
 		});
 }
 
+void EditorApplication::benchmark_project_wraps()
+{
+	ConsoleWindow* console = find_editor_window<ConsoleWindow>("Console");
+
+	if (_taskFactory.contains("benchmark"))
+	{
+		console->log_error("Cannot benchmark wraps: last benchmark has not finished.");
+		return;
+	}
+
+	if (!_project)
+	{
+		console->log_error("Cannot benchmark wraps: no project loaded.");
+		return;
+	}
+
+	console->log_important("benchmark wraps");
+
+	TaskGroup<void>* taskGroup = _taskFactory.create("benchmark", [console] {
+		console->log_important("Benchmark finished.");
+		});
+
+	taskGroup->create([this] {
+		benchmark_wraps();
+		});
+}
+
 void EditorApplication::run_project()
 {
 	ConsoleWindow* console = find_editor_window<ConsoleWindow>("Console");
@@ -204,6 +204,11 @@ namespace Mintye
 		/// <param name="info">The target info.</param>
 		void run_project();
 
+		/// <summary>
+		/// Wraps the target project's assets one at a time and as a batch, then reads them back, and logs the throughput of each step. Does not touch the build.
+		/// </summary>
+		void benchmark_project_wraps();
+
 #pragma region Files
 
 	private:
@@ -215,6 +220,9 @@ namespace Mintye
 
 		void generate_wraps();
 
+		// wraps the assets into a scratch directory and reads them back, and logs how long each step took
+		void benchmark_wraps();
+
 		void generate_assembly();
 
 		/// <summary>
@@ -224,13 +224,25 @@ size_t Mintye::Project::get_asset_count() const
 	return _fileCount;
 }
 
-void Mintye::Project::wrap_assets(Wrap& wrap) const
+std::vector<Wrap::Source> Mintye::Project::get_wrap_sources() const
 {
+	std::vector<Wrap::Source> sources;
+	sources.reserve(get_asset_count());
+
 	for (auto const& [extension, paths] : _files)
 	{
 		for (auto const& path : paths)
 		{
-			wrap.emplace(path, path);
+			CompressionSettings const compression = Asset::get_compression(Asset::get_type(path));
+			sources.push_back(Wrap::Source{ .physicalPath = path, .virtualPath = path, .compression = compression.level, .codec = compression.codec });
 		}
 	}
+
+	return sources;
+}
+
+void Mintye::Project::wrap_assets(Wrap& wrap) const
+{
+	// add them all at once, so they are compressed in parallel, each compressed based on its asset type
+	wrap.emplace(get_wrap_sources());
 }
@@ -135,6 +135,12 @@ namespace Mintye
 		/// <returns></returns>
 		size_t get_asset_count() const;
 
+		/// <summary>
+		/// Gets the sources used to add all of the assets in this Project to a wrap file, each compressed based on its asset type.
+		/// </summary>
+		/// <returns></returns>
+		std::vector<Minty::Wrap::Source> get_wrap_sources() const;
+
 		/// <summary>
 		/// Adds all of the assets in this Project to the given wrap file.
 		/// </summary>
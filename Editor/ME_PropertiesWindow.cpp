@@ -344,6 +344,12 @@ void Mintye::PropertiesWindow::draw_component(Minty::Node& node, size_t const i,
 		Reader reader(node, &data);
 		component->deserialize(reader);
 
+		// tags are looked up by value, so re-set it through the registry to keep the lookup current
+		if (node.get_name() == "Tag")
+		{
+			registry.set_tag(_targetEntity, static_cast<TagComponent*>(component)->tag);
+		}
+
 		// if certain component was updated, dirty the entity, update, continue
 		if (dirtyableComponentNames.contains(node.get_name()))
 		{
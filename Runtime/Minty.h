@@ -48,13 +48,17 @@ access to the entire engine without needing include each file.
 
 // ENTITIES
 #include "Minty/Entities/M_Entity.h"
+#include "Minty/Entities/M_EntityIndex.h"
 #include "Minty/Entities/M_EntityRegistry.h"
+#include "Minty/Entities/M_Prefab.h"
+#include "Minty/Entities/M_TransformHierarchy.h"
 
 // EVENTS
 #include "Minty/Events/M_Event.h"
 
 // FILES
 #include "Minty/Files/M_File.h"
+#include "Minty/Files/M_MappedFile.h"
 #include "Minty/Files/M_PhysicalFile.h"
 #include "Minty/Files/M_VirtualFile.h"
 #include "Minty/Files/M_Wrap.h"
@@ -81,6 +85,7 @@ access to the entire engine without needing include each file.
 #include "Minty/Math/M_Math.h"
 
 // MULTITHREADING
+#include "Minty/Multithreading/M_JobSystem.h"
 #include "Minty/Multithreading/M_Task.h"
 
 // RENDERING
@@ -93,21 +98,26 @@ access to the entire engine without needing include each file.
 #include "Minty/Rendering/M_DrawCallObjectInfo.h"
 #include "Minty/Rendering/M_Material.h"
 #include "Minty/Rendering/M_MaterialTemplate.h"
+#include "Minty/Rendering/M_MemoryAllocator.h"
 #include "Minty/Rendering/M_Mesh.h"
 #include "Minty/Rendering/M_MeshComponent.h"
 #include "Minty/Rendering/M_PushConstantInfo.h"
 #include "Minty/Rendering/M_RenderableComponent.h"
 #include "Minty/Rendering/M_RenderEngine.h"
 #include "Minty/Rendering/M_RenderObject.h"
+#include "Minty/Rendering/M_RenderQueue.h"
 #include "Minty/Rendering/M_RenderSystem.h"
+#include "Minty/Rendering/M_RingBuffer.h"
 #include "Minty/Rendering/M_Shader.h"
 #include "Minty/Rendering/M_ShaderPass.h"
 #include "Minty/Rendering/M_Sprite.h"
+#include "Minty/Rendering/M_SpriteBatch.h"
 #include "Minty/Rendering/M_SpriteComponent.h"
 #include "Minty/Rendering/M_SpritePushData.h"
 #include "Minty/Rendering/M_Texture.h"
 #include "Minty/Rendering/M_TextureAtlas.h"
 #include "Minty/Rendering/M_UniformConstantInfo.h"
+#include "Minty/Rendering/M_UploadQueue.h"
 #include "Minty/Rendering/M_Viewport.h"
 
 // SCENES
@@ -121,6 +131,7 @@ access to the entire engine without needing include each file.
 #include "Minty/Scripting/M_ScriptAssembly.h"
 #include "Minty/Scripting/M_ScriptClass.h"
 #include "Minty/Scripting/M_ScriptComponent.h"
+#include "Minty/Scripting/M_ScriptMethod.h"
 #include "Minty/Scripting/M_ScriptEngine.h"
 #include "Minty/Scripting/M_ScriptObject.h"
 #include "Minty/Scripting/M_ScriptSystem.h"
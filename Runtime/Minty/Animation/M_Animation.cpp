@@ -12,9 +12,221 @@
 #include "Minty/Serialization/M_Reader.h"
 #include "Minty/Serialization/M_Writer.h"
 #include "Minty/Tools/M_Text.h"
+#include "Minty/Assets/M_AssetEngine.h"
+#include "Minty/Components/M_TransformComponent.h"
+#include "Minty/Rendering/M_SpriteComponent.h"
+#include "Minty/Rendering/M_Sprite.h"
+#include "Minty/Audio/M_AudioSourceComponent.h"
+#include <numeric>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define MINTY_ANIMATION_SSE
+#include <xmmintrin.h>
+#endif
 
 using namespace Minty;
 
+#pragma region Properties
+
+template<typename T>
+struct AnimationRef : std::false_type {};
+
+template<typename T>
+struct AnimationRef<Ref<T>> : std::true_type
+{
+	typedef T type;
+};
+
+// parses the serialized value as the type of the variable
+template<typename U>
+static AnimationValue parse_animation_value(Node const& node)
+{
+	Node value = node;
+	value.set_name("value");
+	Node root;
+	root.add_child(value);
+	Reader reader(root);
+
+	if constexpr (std::is_same_v<U, int>)
+	{
+		return reader.read_int("value");
+	}
+	else if constexpr (std::is_same_v<U, float>)
+	{
+		return reader.read_float("value");
+	}
+	else if constexpr (std::is_same_v<U, Color>)
+	{
+		Color color;
+		reader.try_read_color("value", color);
+		return color;
+	}
+	else if constexpr (AnimationRef<U>::value)
+	{
+		// assets are found when they are set, in case they have not been loaded yet
+		return reader.read_uuid("value");
+	}
+	else
+	{
+		return reader.read_object<U>("value");
+	}
+}
+
+// creates a property that sets the given member directly
+template<typename T, typename U, U T::* Member>
+static AnimationProperty create_animation_property(bool const dirty = false)
+{
+	return AnimationProperty
+	{
+		.get = [](EntityRegistry& registry, Entity const entity) -> Component* { return registry.try_get<T>(entity); },
+		.parse = &parse_animation_value<U>,
+		.set = [](Component& component, AnimationValue const& value) -> void
+		{
+			if constexpr (AnimationRef<U>::value)
+			{
+				static_cast<T&>(component).*Member = AssetEngine::instance().get<typename AnimationRef<U>::type>(std::get<UUID>(value));
+			}
+			else
+			{
+				static_cast<T&>(component).*Member = std::get<U>(value);
+			}
+		},
+		.dirty = dirty,
+	};
+}
+
+#pragma endregion
+
+#pragma region Curves
+
+// packs the value into four components, returns false if it cannot be interpolated
+static bool to_curve_value(AnimationValue const& value, Vector4& result)
+{
+	return std::visit([&result](auto const& v) -> bool
+		{
+			typedef std::decay_t<decltype(v)> T;
+
+			if constexpr (std::is_same_v<T, float>)
+			{
+				result = Vector4(v, 0.0f, 0.0f, 0.0f);
+			}
+			else if constexpr (std::is_same_v<T, Vector2>)
+			{
+				result = Vector4(v.x, v.y, 0.0f, 0.0f);
+			}
+			else if constexpr (std::is_same_v<T, Vector3>)
+			{
+				result = Vector4(v.x, v.y, v.z, 0.0f);
+			}
+			else if constexpr (std::is_same_v<T, Quaternion>)
+			{
+				result = Vector4(v.x, v.y, v.z, v.w);
+			}
+			else if constexpr (std::is_same_v<T, Color>)
+			{
+				result = Vector4(v.r, v.g, v.b, v.a);
+			}
+			else
+			{
+				return false;
+			}
+
+			return true;
+		}, value);
+}
+
+static int to_curve_channel(float const value)
+{
+	return static_cast<int>(std::round(std::clamp(value, static_cast<float>(Color::MIN_CHANNEL), static_cast<float>(Color::MAX_CHANNEL))));
+}
+
+// unpacks the four components into a value of the same type as the given type
+static AnimationValue from_curve_value(Vector4 const& value, AnimationValue const& type)
+{
+	return std::visit([&value](auto const& v) -> AnimationValue
+		{
+			typedef std::decay_t<decltype(v)> T;
+
+			if constexpr (std::is_same_v<T, float>)
+			{
+				return value.x;
+			}
+			else if constexpr (std::is_same_v<T, Vector2>)
+			{
+				return Vector2(value.x, value.y);
+			}
+			else if constexpr (std::is_same_v<T, Vector3>)
+			{
+				return Vector3(value.x, value.y, value.z);
+			}
+			else if constexpr (std::is_same_v<T, Quaternion>)
+			{
+				Quaternion result;
+				result.x = value.x;
+				result.y = value.y;
+				result.z = value.z;
+				result.w = value.w;
+				return result;
+			}
+			else if constexpr (std::is_same_v<T, Color>)
+			{
+				return Color(to_curve_channel(value.x), to_curve_channel(value.y), to_curve_channel(value.z), to_curve_channel(value.w));
+			}
+			else
+			{
+				return v;
+			}
+		}, type);
+}
+
+// a + (b - a) * t
+static inline Vector4 lerp_curve(Vector4 const& a, Vector4 const& b, float const t)
+{
+#ifdef MINTY_ANIMATION_SSE
+	__m128 const va = _mm_loadu_ps(&a.x);
+	__m128 const vb = _mm_loadu_ps(&b.x);
+
+	Vector4 result;
+	_mm_storeu_ps(&result.x, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), _mm_set1_ps(t))));
+	return result;
+#else
+	return a + (b - a) * t;
+#endif
+}
+
+// Catmull-Rom spline from p1 to p2
+static inline Vector4 cubic_curve(Vector4 const& p0, Vector4 const& p1, Vector4 const& p2, Vector4 const& p3, float const t)
+{
+	// 0.5 * (2p1 + (p2 - p0)t + (2p0 - 5p1 + 4p2 - p3)t^2 + (3p1 - p0 - 3p2 + p3)t^3)
+#ifdef MINTY_ANIMATION_SSE
+	__m128 const v0 = _mm_loadu_ps(&p0.x);
+	__m128 const v1 = _mm_loadu_ps(&p1.x);
+	__m128 const v2 = _mm_loadu_ps(&p2.x);
+	__m128 const v3 = _mm_loadu_ps(&p3.x);
+
+	__m128 const a1 = _mm_sub_ps(v2, v0);
+	__m128 const a2 = _mm_sub_ps(_mm_add_ps(_mm_add_ps(v0, v0), _mm_mul_ps(v2, _mm_set1_ps(4.0f))), _mm_add_ps(_mm_mul_ps(v1, _mm_set1_ps(5.0f)), v3));
+	__m128 const a3 = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(v1, v2), _mm_set1_ps(3.0f)), _mm_sub_ps(v3, v0));
+
+	__m128 const vt = _mm_set1_ps(t);
+	__m128 result = _mm_add_ps(_mm_mul_ps(a3, vt), a2);
+	result = _mm_add_ps(_mm_mul_ps(result, vt), a1);
+	result = _mm_add_ps(_mm_mul_ps(result, vt), _mm_add_ps(v1, v1));
+
+	Vector4 output;
+	_mm_storeu_ps(&output.x, _mm_mul_ps(result, _mm_set1_ps(0.5f)));
+	return output;
+#else
+	Vector4 const a1 = p2 - p0;
+	Vector4 const a2 = 2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3;
+	Vector4 const a3 = 3.0f * (p1 - p2) + p3 - p0;
+
+	return 0.5f * (((a3 * t + a2) * t + a1) * t + 2.0f * p1);
+#endif
+}
+
+#pragma endregion
+
 Minty::Animation::Animation()
 	: Asset()
 	, _length()
@@ -22,10 +234,12 @@ Minty::Animation::Animation()
 	, _entities()
 	, _components()
 	, _variables()
-	, _values()
 	, _times()
-	, _steps()
+	, _tracks()
 	, _reset()
+	, _curves()
+	, _curveTimes()
+	, _curveValues()
 {}
 
 Minty::Animation::Animation(AnimationBuilder const& builder)
@@ -37,13 +251,16 @@ Minty::Animation::Animation(AnimationBuilder const& builder)
 	, _entities(builder.entities)
 	, _components(builder.components)
 	, _variables(builder.variables)
-	, _values(builder.values)
 	, _times()
-	, _steps()
+	, _tracks()
 	, _reset()
+	, _curves()
+	, _curveTimes()
+	, _curveValues()
 {
-	// take steps and compile them all
-	_steps.reserve(builder.steps.size());
+	// find the time index of each step
+	std::vector<std::pair<Index, AnimationStep>> steps;
+	steps.reserve(builder.steps.size());
 	for (auto const& pair : builder.steps)
 	{
 		// if this is the first time, or a new time, add to times
@@ -52,41 +269,171 @@ Minty::Animation::Animation(AnimationBuilder const& builder)
 			_times.push_back(pair.first);
 		}
 
-		// get that time id
-		step_time_t timeIndex = static_cast<step_time_t>(_times.size() - 1);
+		steps.push_back({ static_cast<Index>(_times.size() - 1), pair.second });
+	}
+
+	std::vector<std::pair<Index, AnimationStep>> resetSteps;
+	resetSteps.reserve(builder.resetSteps.size());
+	for (auto const& step : builder.resetSteps)
+	{
+		resetSteps.push_back({ static_cast<Index>(MAX_TIME_INDEX), step });
+	}
+
+	// compile them into tracks
+	_tracks = compile_tracks(steps, builder.values);
+	_reset = compile_tracks(resetSteps, builder.values);
+
+	for (AnimationCurveBuilder const& curve : builder.curves)
+	{
+		compile_curve(curve);
+	}
+}
+
+std::vector<Animation::AnimationTrack> Minty::Animation::compile_tracks(std::vector<std::pair<Index, AnimationStep>> const& steps, std::vector<Node> const& values) const
+{
+	std::vector<AnimationTrack> tracks;
+
+	for (auto const& [timeIndex, step] : steps)
+	{
+		// find the track for this variable, in the order they were first used
+		auto found = std::find_if(tracks.begin(), tracks.end(), [&step](AnimationTrack const& track)
+			{
+				return track.entityIndex == step.entityIndex && track.componentIndex == step.componentIndex && track.variableIndex == step.variableIndex;
+			});
+
+		if (found == tracks.end())
+		{
+			ComponentTypeID componentTypeId = ERROR_COMPONENT_TYPE_ID;
+			if (step.componentIndex < _components.size())
+			{
+				componentTypeId = EntityRegistry::get_component_type_id(_components.at(step.componentIndex));
+			}
+
+			AnimationProperty const* property = nullptr;
+			if (step.componentIndex < _components.size() && step.variableIndex < _variables.size())
+			{
+				property = find_property(_components.at(step.componentIndex), _variables.at(step.variableIndex));
+			}
+
+			tracks.push_back(AnimationTrack
+				{
+					.entityIndex = step.entityIndex,
+					.componentIndex = step.componentIndex,
+					.variableIndex = step.variableIndex,
+					.componentTypeId = componentTypeId,
+					.property = property,
+				});
+			found = tracks.end() - 1;
+		}
+
+		AnimationTrack& track = *found;
 
-		// add to steps
-		step_key_t key = compile_key(pair.second.entityIndex, pair.second.componentIndex, pair.second.variableIndex);
-		
-		auto found = _steps.find(key);
-		if (found == _steps.end())
+		// only the first step at each time is used, unless resetting
+		if (timeIndex != MAX_TIME_INDEX && !track.keys.empty() && track.keys.back().timeIndex == timeIndex)
 		{
-			// create new map
-			_steps.emplace(key, std::unordered_map<step_time_t, step_value_t>());
+			continue;
 		}
 
-		step_value_t value = compile_value(pair.second.valueIndex, pair.second.flags);
+		AnimationKey key
+		{
+			.timeIndex = timeIndex,
+			.flags = step.flags,
+			.valueIndex = step.valueIndex < values.size() ? step.valueIndex : MAX_VALUE_INDEX,
+		};
+
+		// parse the value once, so setting it does not need to parse anything
+		if (key.valueIndex != MAX_VALUE_INDEX && step.variableIndex < _variables.size())
+		{
+			Node const& value = values.at(key.valueIndex);
+
+			if (track.property)
+			{
+				key.value = track.property->parse(value);
+			}
+			else
+			{
+				Node child = value;
+				child.set_name(_variables.at(step.variableIndex));
+				key.node.add_child(child);
+			}
+		}
 
-		// add to map
-		_steps.at(key).emplace(timeIndex, value);
+		track.keys.push_back(key);
 	}
-	_reset.reserve(builder.resetSteps.size());
-	for (auto const& step : builder.resetSteps)
+
+	// the steps are given in time order
+	return tracks;
+}
+
+void Minty::Animation::compile_curve(AnimationCurveBuilder const& builder)
+{
+	if (builder.componentIndex >= _components.size() || builder.variableIndex >= _variables.size())
 	{
-		// get the key and value
-		step_key_t key = compile_key(step.entityIndex, step.componentIndex, step.variableIndex);
-		step_value_t value = compile_value(step.valueIndex, step.flags);
+		MINTY_ERROR_FORMAT("Animation curve has an invalid component or variable index in \"{}\".", get_path().generic_string());
+		return;
+	}
 
-		// add list if it dne for this key
-		auto found = _reset.find(key);
-		if (found == _reset.end())
+	String const& componentName = _components.at(builder.componentIndex);
+	String const& variableName = _variables.at(builder.variableIndex);
+
+	// curves are set directly, every frame
+	AnimationProperty const* property = find_property(componentName, variableName);
+	if (!property)
+	{
+		MINTY_ERROR_FORMAT("Cannot animate {}.{} with a curve: it has no animation property.", componentName, variableName);
+		return;
+	}
+
+	if (builder.keys.empty()) return;
+
+	// order the keys by time
+	std::vector<size_t> order(builder.keys.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&builder](size_t const left, size_t const right)
 		{
-			_reset.emplace(key, std::vector<step_value_t>());
+			return builder.keys.at(left).first < builder.keys.at(right).first;
+		});
+
+	AnimationCurve curve
+	{
+		.entityIndex = builder.entityIndex,
+		.property = property,
+		.interpolation = builder.interpolation,
+		.type = AnimationValue(),
+		.normalize = false,
+		.first = _curveTimes.size(),
+		.count = order.size(),
+	};
+
+	for (size_t const i : order)
+	{
+		AnimationValue value = property->parse(builder.keys.at(i).second);
+
+		Vector4 packed;
+		if (!to_curve_value(value, packed))
+		{
+			MINTY_ERROR_FORMAT("Cannot animate {}.{} with a curve: its values cannot be interpolated.", componentName, variableName);
+			_curveTimes.resize(curve.first);
+			_curveValues.resize(curve.first);
+			return;
 		}
 
-		// add to that list
-		_reset.at(key).push_back(value);
+		if (_curveTimes.size() == curve.first)
+		{
+			curve.type = value;
+			curve.normalize = std::holds_alternative<Quaternion>(value);
+		}
+		else if (curve.normalize && glm::dot(_curveValues.back(), packed) < 0.0f)
+		{
+			// keep rotations within the same hemisphere, so they blend the short way around
+			packed = -packed;
+		}
+
+		_curveTimes.push_back(builder.keys.at(i).first);
+		_curveValues.push_back(packed);
 	}
+
+	_curves.push_back(curve);
 }
 
 bool Minty::Animation::loops() const
@@ -94,7 +441,7 @@ bool Minty::Animation::loops() const
 	return _flags & ANIMATION_FLAGS_LOOPS;
 }
 
-bool Minty::Animation::animate(float& time, float const elapsedTime, Index& index, Entity const thisEntity, Scene& scene) const
+bool Minty::Animation::animate(float& time, float const elapsedTime, Index& index, Entity const thisEntity, AnimationBinding& binding, Scene& scene) const
 {
 	if (time >= _length)
 	{
@@ -119,20 +466,19 @@ bool Minty::Animation::animate(float& time, float const elapsedTime, Index& inde
 		endIndex++;
 	}
 
-	// go through each step list
-	for (auto const& pair : _steps)
+	EntityRegistry& registry = scene.get_entity_registry();
+	bind(binding, registry);
+
+	// go through each track
+	for (AnimationTrack const& track : _tracks)
 	{
-		// start at end, apply first value that shows up, if any
-		for (int64_t i = endIndex; i >= index; i--)
-		{
-			auto found = pair.second.find(static_cast<Index>(i));
-			if (found != pair.second.end())
-			{
-				// step found, so perform it and stop looking for steps since this is the last one linearly
-				perform_step(pair.first, found->first, found->second, thisEntity, scene);
-				break;
-			}
-		}
+		// apply the last key within [index, endIndex], if any
+		auto found = std::upper_bound(track.keys.begin(), track.keys.end(), endIndex, [](Index const value, AnimationKey const& key) { return value < key.timeIndex; });
+		if (found == track.keys.begin()) continue;
+		--found;
+		if (found->timeIndex < index) continue;
+
+		perform_step(track, *found, thisEntity, binding, registry);
 	}
 
 	// update index, so it will start after the last step performed
@@ -142,18 +488,107 @@ bool Minty::Animation::animate(float& time, float const elapsedTime, Index& inde
 	return time >= _length;
 }
 
-void Minty::Animation::reset(Entity const thisEntity, Scene& scene) const
+void Minty::Animation::reset(Entity const thisEntity, AnimationBinding& binding, Scene& scene) const
+{
+	EntityRegistry& registry = scene.get_entity_registry();
+	bind(binding, registry);
+
+	// perform each reset step
+	for (AnimationTrack const& track : _reset)
+	{
+		for (AnimationKey const& key : track.keys)
+		{
+			perform_step(track, key, thisEntity, binding, registry);
+		}
+	}
+}
+
+size_t Minty::Animation::get_curve_count() const
+{
+	return _curves.size();
+}
+
+void Minty::Animation::evaluate(float const time, Vector4* const results) const
+{
+	for (size_t i = 0; i < _curves.size(); i++)
+	{
+		AnimationCurve const& curve = _curves[i];
+		float const* times = _curveTimes.data() + curve.first;
+		Vector4 const* values = _curveValues.data() + curve.first;
+
+		// find the first key after the time
+		size_t const next = std::upper_bound(times, times + curve.count, time) - times;
+
+		// hold the first and last values outside of the keys
+		if (next == 0)
+		{
+			results[i] = values[0];
+			continue;
+		}
+		if (next == curve.count)
+		{
+			results[i] = values[curve.count - 1];
+			continue;
+		}
+
+		size_t const previous = next - 1;
+		float const duration = times[next] - times[previous];
+		float const t = duration > 0.0f ? (time - times[previous]) / duration : 1.0f;
+
+		switch (curve.interpolation)
+		{
+		case AnimationInterpolation::Linear:
+			results[i] = lerp_curve(values[previous], values[next], t);
+			break;
+		case AnimationInterpolation::Cubic:
+			results[i] = cubic_curve(values[previous ? previous - 1 : previous], values[previous], values[next], values[next + 1 < curve.count ? next + 1 : next], t);
+			break;
+		default:
+			results[i] = values[previous];
+			continue;
+		}
+
+		if (curve.normalize)
+		{
+			float const length = glm::length(results[i]);
+			if (length > 0.0f) results[i] /= length;
+		}
+	}
+}
+
+void Minty::Animation::apply(Vector4 const* const results, Entity const thisEntity, AnimationBinding& binding, EntityRegistry& registry) const
 {
-	// perform each step within _reset
-	for (auto const& pair : _reset)
+	bind(binding, registry);
+
+	for (size_t i = 0; i < _curves.size(); i++)
 	{
-		for (auto const value : pair.second)
+		AnimationCurve const& curve = _curves[i];
+
+		Entity entity = get_entity(curve.entityIndex, thisEntity, binding, registry);
+		if (entity == NULL_ENTITY) continue;
+
+		// curves do not add Components, only set them
+		Component* component = curve.property->get(registry, entity);
+		if (!component) continue;
+
+		curve.property->set(*component, from_curve_value(results[i], curve.type));
+
+		if (curve.property->dirty)
 		{
-			perform_step(pair.first, INVALID_STEP_VALUE, value, thisEntity, scene);
+			registry.dirty(entity);
 		}
 	}
 }
 
+void Minty::Animation::bind(AnimationBinding& binding, EntityRegistry& registry) const
+{
+	if (binding.animation == get_id()) return;
+
+	// find each Entity once, instead of on every step
+	binding.animation = get_id();
+	find_entities(binding, registry);
+}
+
 size_t get_split(size_t const index, std::vector<String> const& split, size_t const defaultValue)
 {
 	return (index < split.size() && split.at(index).size()) ? Parse::to_size(split.at(index)) : defaultValue;
@@ -176,88 +611,179 @@ AnimationStep Minty::Animation::parse_step(String const& string)
 	};
 }
 
-Animation::step_key_t Minty::Animation::compile_key(size_t const entityIndex, size_t const componentIndex, size_t const variableIndex) const
+AnimationCurveBuilder Minty::Animation::parse_curve(Node const& node)
 {
-	return
-		((entityIndex & MAX_ENTITY_INDEX) << ENTITY_OFFSET) |
-		((componentIndex & MAX_COMPONENT_INDEX) << COMPONENT_OFFSET) |
-		((variableIndex & MAX_VARIABLE_INDEX) << VARIABLE_OFFSET);
-}
+	// split the data by /'s
+	std::vector<String> split = Text::split(node.get_data(), '/');
 
-Animation::step_value_t Minty::Animation::compile_value(size_t const valueIndex, AnimationStepFlags const flags) const
-{
-	return
-		((valueIndex & MAX_VALUE_INDEX) << VALUE_OFFSET) |
-		((flags & MAX_FLAGS_INDEX) << FLAGS_OFFSET);
+	AnimationCurveBuilder builder
+	{
+		.entityIndex = get_split(0, split, Animation::MAX_ENTITY_INDEX),
+		.componentIndex = get_split(1, split, Animation::MAX_COMPONENT_INDEX),
+		.variableIndex = get_split(2, split, Animation::MAX_VARIABLE_INDEX),
+		.interpolation = AnimationInterpolation::Linear,
+	};
+
+	if (Node const* interpolationNode = node.find("interpolation"))
+	{
+		builder.interpolation = from_string_animation_interpolation(interpolationNode->get_data());
+	}
+
+	// each key is named by its time
+	if (Node const* keysNode = node.find("keys"))
+	{
+		builder.keys.reserve(keysNode->get_children().size());
+		for (Node const& keyNode : keysNode->get_children())
+		{
+			builder.keys.push_back({ Parse::to_float(keyNode.get_name()), keyNode });
+		}
+	}
+
+	return builder;
 }
 
-void Minty::Animation::perform_step(step_key_t const key, step_time_t const time, step_value_t const value, Entity const thisEntity, Scene& scene) const
+Entity Minty::Animation::get_entity(size_t const entityIndex, Entity const thisEntity, AnimationBinding& binding, EntityRegistry& registry) const
 {
-	// build the step
-	AnimationStep step = AnimationStep
-	{
-		.entityIndex = (key >> ENTITY_OFFSET) & MAX_ENTITY_INDEX,
-		.componentIndex = (key >> COMPONENT_OFFSET) & MAX_COMPONENT_INDEX,
-		.variableIndex = (key >> VARIABLE_OFFSET) & MAX_VARIABLE_INDEX,
-		.timeIndex = (time >> TIME_OFFSET) & MAX_TIME_INDEX,
-		.valueIndex = (value >> VALUE_OFFSET) & MAX_VALUE_INDEX,
-		.flags = static_cast<AnimationStepFlags>((value >> FLAGS_OFFSET) & MAX_FLAGS_INDEX),
-	};
+	// if entity index is 0xff (max ID), then it is referring to the argument Entity (this Entity, if you will)
+	if (entityIndex == MAX_ENTITY_INDEX) return thisEntity;
+
+	if (entityIndex >= binding.entities.size()) return NULL_ENTITY;
+
+	Entity entity = binding.entities[entityIndex];
+
+	// if it was destroyed, or not found yet, find them all again, but only if a name has changed since they were last found
+	if ((entity == NULL_ENTITY || !registry.valid(entity)) && binding.nameVersion != registry.get_name_version())
+	{
+		find_entities(binding, registry);
+		entity = binding.entities[entityIndex];
+	}
 
-	// perform the step using that
-	return perform_step(step, thisEntity, scene);
+	return entity;
 }
 
-void Minty::Animation::perform_step(AnimationStep const& step, Entity const thisEntity, Scene& scene) const
+void Minty::Animation::find_entities(AnimationBinding& binding, EntityRegistry& registry) const
 {
-	EntityRegistry& registry = scene.get_entity_registry();
+	binding.nameVersion = registry.get_name_version();
+	binding.entities.resize(_entities.size());
+	for (size_t i = 0; i < _entities.size(); i++)
+	{
+		binding.entities[i] = registry.find_by_name(_entities.at(i));
+	}
+}
 
+void Minty::Animation::perform_step(AnimationTrack const& track, AnimationKey const& key, Entity const thisEntity, AnimationBinding& binding, EntityRegistry& registry) const
+{
 	// get the entity
-	// if entity index is 0xff (max ID), then it is referring to the argument Entity (this Entity, if you will)
-	Entity entity = step.entityIndex == MAX_ENTITY_INDEX ? thisEntity : registry.find_by_name(_entities.at(step.entityIndex));
+	Entity entity = get_entity(track.entityIndex, thisEntity, binding, registry);
 	if (entity == NULL_ENTITY) return; // no entity, do not continue
 
 	// get the component from the entity, if one was given
-	if(step.componentIndex == MAX_COMPONENT_INDEX) return;
-	Component* component = registry.get_by_name(_components.at(step.componentIndex), entity);
+	if (track.componentIndex == MAX_COMPONENT_INDEX) return;
+	if (track.componentTypeId == ERROR_COMPONENT_TYPE_ID)
+	{
+		MINTY_ERROR_FORMAT("Cannot animate Component \"{}\". It has not been registered with the EntityRegistry.", _components.at(track.componentIndex));
+		return;
+	}
+	Component* component = track.property ? track.property->get(registry, entity) : registry.get_by_type_id(track.componentTypeId, entity);
 
 	// determine what to do based on the flags
-	if (step.flags & ANIMATION_STEP_FLAGS_ADD_REMOVE)
+	if (key.flags & ANIMATION_STEP_FLAGS_ADD_REMOVE)
 	{
 		// remove the component from the entity if it does contain it
 		if (component)
 		{
-			registry.erase_by_name(_components.at(step.componentIndex), entity);
+			registry.erase_by_type_id(track.componentTypeId, entity);
 		}
+
+		return;
 	}
 	else
 	{
 		// add the component to the entity if it does not contain it
 		if (!component)
 		{
-			registry.emplace_by_name(_components.at(step.componentIndex), entity);
+			component = registry.emplace_by_type_id(track.componentTypeId, entity);
+			if (!component) return;
 		}
 	}
 
 	// ignore if no variable name or value
-	if (step.variableIndex == MAX_VARIABLE_INDEX || step.valueIndex == MAX_VALUE_INDEX) return;
+	if (track.variableIndex == MAX_VARIABLE_INDEX || key.valueIndex == MAX_VALUE_INDEX) return;
 
-	// get the variable name that will be set
-	String const& name = _variables.at(step.variableIndex);
+	if (track.property)
+	{
+		// set the value directly
+		track.property->set(*component, key.value);
+
+		if (track.property->dirty)
+		{
+			registry.dirty(entity);
+		}
+	}
+	else
+	{
+		// deserialize using that one value
+		SerializationData data = SerializationData{
+			.scene = &registry.get_scene(),
+			.entity = thisEntity,
+		};
+		Reader reader(key.node, &data);
+		component->deserialize(reader);
+	}
+}
+
+void Minty::Animation::register_property(String const& componentName, String const& variableName, AnimationProperty const& property)
+{
+	get_properties()[std::format("{}.{}", componentName, variableName)] = property;
+}
+
+AnimationProperty const* Minty::Animation::find_property(String const& componentName, String const& variableName)
+{
+	std::unordered_map<String, AnimationProperty>& properties = get_properties();
+
+	auto found = properties.find(std::format("{}.{}", componentName, variableName));
+	if (found == properties.end()) return nullptr;
 
-	// get the value to set
-	Node value = _values.at(step.valueIndex);
-	value.set_name(name);
+	return &found->second;
+}
 
-	// create a reader and deserialize using that one value
-	SerializationData data = SerializationData{
-		.scene = &scene,
-		.entity = thisEntity,
+std::unordered_map<String, AnimationProperty>& Minty::Animation::get_properties()
+{
+	// the variables commonly animated on the built in Components
+	static std::unordered_map<String, AnimationProperty> properties
+	{
+		{ "Transform.position", create_animation_property<TransformComponent, Vector3, &TransformComponent::localPosition>(true) },
+		{ "Transform.rotation", create_animation_property<TransformComponent, Quaternion, &TransformComponent::localRotation>(true) },
+		{ "Transform.scale", create_animation_property<TransformComponent, Vector3, &TransformComponent::localScale>(true) },
+		{ "Sprite.sprite", create_animation_property<SpriteComponent, Ref<Sprite>, &SpriteComponent::sprite>() },
+		{ "Sprite.size", create_animation_property<SpriteComponent, Vector2, &SpriteComponent::size>() },
+		{ "Sprite.layer", create_animation_property<SpriteComponent, int, &SpriteComponent::layer>() },
+		{ "Sprite.order", create_animation_property<SpriteComponent, int, &SpriteComponent::order>() },
+		{ "Sprite.color", create_animation_property<SpriteComponent, Color, &SpriteComponent::color>() },
+		{ "AudioSource.volume", create_animation_property<AudioSourceComponent, float, &AudioSourceComponent::volume>() },
 	};
-	Node root;
-	root.add_child(value);
-	Reader reader(root, &data);
-	component->deserialize(reader);
+
+	return properties;
+}
+
+String Minty::to_string(AnimationInterpolation const value)
+{
+	switch (value)
+	{
+	case AnimationInterpolation::Step: return "Step";
+	case AnimationInterpolation::Linear: return "Linear";
+	case AnimationInterpolation::Cubic: return "Cubic";
+	default: return "";
+	}
+}
+
+AnimationInterpolation Minty::from_string_animation_interpolation(String const& value)
+{
+	if (value == "Step") return AnimationInterpolation::Step;
+	if (value == "Linear") return AnimationInterpolation::Linear;
+	if (value == "Cubic") return AnimationInterpolation::Cubic;
+
+	return static_cast<AnimationInterpolation>(0);
 }
 
 void Minty::Animation::serialize(Writer& writer) const
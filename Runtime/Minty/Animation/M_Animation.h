@@ -1,14 +1,21 @@
 #pragma once
 #include "Minty/Assets/M_Asset.h"
+#include "Minty/Components/M_Component.h"
 
 #include "Minty/Entities/M_Entity.h"
 #include "Minty/Types/M_Node.h"
+#include "Minty/Types/M_Vector.h"
+#include "Minty/Types/M_Quaternion.h"
+#include "Minty/Types/M_Color.h"
 #include <vector>
+#include <variant>
 #include <unordered_map>
 
 namespace Minty
 {
 	class Scene;
+	class EntityRegistry;
+	struct Component;
 
 	enum AnimationStepFlags
 	{
@@ -17,6 +24,30 @@ namespace Minty
 		ANIMATION_STEP_FLAGS_ALL = 0b0001,
 	};
 
+	/// <summary>
+	/// How the values between the keys of an AnimationCurve are found.
+	/// </summary>
+	enum class AnimationInterpolation
+	{
+		/// <summary>
+		/// Holds the value of the previous key.
+		/// </summary>
+		Step,
+
+		/// <summary>
+		/// Blends linearly between the previous and next keys.
+		/// </summary>
+		Linear,
+
+		/// <summary>
+		/// Blends smoothly through the keys, using a Catmull-Rom spline.
+		/// </summary>
+		Cubic,
+	};
+
+	String to_string(AnimationInterpolation const value);
+	AnimationInterpolation from_string_animation_interpolation(String const& value);
+
 	/// <summary>
 	/// Holds all of the indices required for a step, to different component values.
 	/// </summary>
@@ -30,6 +61,76 @@ namespace Minty
 		AnimationStepFlags flags;
 	};
 
+	/// <summary>
+	/// A value set by an Animation, parsed once when the Animation is created.
+	/// Assets are held by their UUID.
+	/// </summary>
+	typedef std::variant<int, float, Vector2, Vector3, Quaternion, Color, UUID> AnimationValue;
+
+	/// <summary>
+	/// Sets one variable of one type of Component directly, without deserializing the Component.
+	/// </summary>
+	struct AnimationProperty
+	{
+		/// <summary>
+		/// Gets the Component from the Entity, or null if it does not have one.
+		/// </summary>
+		Component* (*get)(EntityRegistry& registry, Entity const entity);
+
+		/// <summary>
+		/// Parses the serialized value into the type of the variable.
+		/// </summary>
+		AnimationValue(*parse)(Node const& node);
+
+		/// <summary>
+		/// Sets the variable on the Component to the value.
+		/// </summary>
+		void (*set)(Component& component, AnimationValue const& value);
+
+		/// <summary>
+		/// True if the Entity should be marked dirty after the variable has been set.
+		/// </summary>
+		bool dirty;
+	};
+
+	/// <summary>
+	/// Holds the Entities an Animation acts upon, found once for each AnimatorComponent instead of on every step.
+	/// </summary>
+	struct AnimationBinding
+	{
+		/// <summary>
+		/// The ID of the Animation these Entities were found for.
+		/// </summary>
+		UUID animation = INVALID_UUID;
+
+		/// <summary>
+		/// The Entity for each Entity name within the Animation, or NULL_ENTITY if it was not found.
+		/// </summary>
+		std::vector<Entity> entities;
+
+		/// <summary>
+		/// The name version of the EntityRegistry when these Entities were found.
+		/// </summary>
+		size_t nameVersion = 0;
+	};
+
+	/// <summary>
+	/// Holds the keys of a curve that is interpolated over time.
+	/// </summary>
+	struct AnimationCurveBuilder
+	{
+		size_t entityIndex;
+		size_t componentIndex;
+		size_t variableIndex;
+
+		AnimationInterpolation interpolation;
+
+		/// <summary>
+		/// The time and value of each key.
+		/// </summary>
+		std::vector<std::pair<float, Node>> keys;
+	};
+
 	/// <summary>
 	/// Holds data to create a new Animation.
 	/// </summary>
@@ -78,6 +179,11 @@ namespace Minty
 		/// The steps taken when resetting this Animation.
 		/// </summary>
 		std::vector<AnimationStep> resetSteps;
+
+		/// <summary>
+		/// The curves within this Animation.
+		/// </summary>
+		std::vector<AnimationCurveBuilder> curves;
 	};
 
 	/// <summary>
@@ -95,27 +201,76 @@ namespace Minty
 		};
 
 	private:
-		constexpr static int ENTITY_OFFSET = 16;
-		constexpr static int COMPONENT_OFFSET = 8;
-		constexpr static int VARIABLE_OFFSET = 0;
-		constexpr static int TIME_OFFSET = 0;
-		constexpr static int VALUE_OFFSET = 4;
-		constexpr static int FLAGS_OFFSET = 0;
 		constexpr static size_t MAX_ENTITY_INDEX = 0xff;
 		constexpr static size_t MAX_COMPONENT_INDEX = 0xff;
 		constexpr static size_t MAX_VARIABLE_INDEX = 0xff;
 		constexpr static size_t MAX_TIME_INDEX = 0xffffffff;
 		constexpr static size_t MAX_VALUE_INDEX = 0xfffffff;
 		constexpr static size_t MAX_FLAGS_INDEX = 0xf;
-		typedef uint32_t step_key_t;
-		typedef uint32_t step_time_t;
-		typedef uint32_t step_value_t;
-		constexpr static step_key_t INVALID_STEP_KEY = (MAX_ENTITY_INDEX << ENTITY_OFFSET) | (MAX_COMPONENT_INDEX << COMPONENT_OFFSET) | (MAX_VARIABLE_INDEX | VARIABLE_OFFSET);
-		constexpr static step_time_t INVALID_STEP_TIME = (MAX_TIME_INDEX << TIME_OFFSET);
-		constexpr static step_value_t INVALID_STEP_VALUE = (MAX_VALUE_INDEX << VALUE_OFFSET) | (MAX_FLAGS_INDEX << FLAGS_OFFSET);
 
 	public:
 		typedef uint32_t Index;
+
+	private:
+		/// <summary>
+		/// A value to set at a point in time.
+		/// </summary>
+		struct AnimationKey
+		{
+			Index timeIndex;
+			AnimationStepFlags flags;
+
+			// the index of the value, or MAX_VALUE_INDEX if none
+			size_t valueIndex;
+
+			// the parsed value, if the track has a property
+			AnimationValue value;
+
+			// the value to deserialize, if the track has no property
+			Node node;
+		};
+
+		/// <summary>
+		/// All of the values set on one variable of one Component of one Entity, ordered by time.
+		/// </summary>
+		struct AnimationTrack
+		{
+			size_t entityIndex;
+			size_t componentIndex;
+			size_t variableIndex;
+
+			// the registered type of the Component, so it can be found without its name
+			ComponentTypeID componentTypeId;
+
+			// the property used to set the variable directly, or null if the Component must be deserialized
+			AnimationProperty const* property;
+
+			std::vector<AnimationKey> keys;
+		};
+
+		/// <summary>
+		/// A variable that is interpolated between keys. The keys are stored within the Animation's curve arrays.
+		/// </summary>
+		struct AnimationCurve
+		{
+			size_t entityIndex;
+
+			// the property used to set the variable, curves can only set variables with a property
+			AnimationProperty const* property;
+
+			AnimationInterpolation interpolation;
+
+			// a value of the type being set
+			AnimationValue type;
+
+			// true if the values are rotations, which must stay normalized
+			bool normalize;
+
+			// the range of keys within _curveTimes and _curveValues
+			size_t first;
+			size_t count;
+		};
+
 	private:
 		/// <summary>
 		/// The amount of time this Animation runs for, in seconds.
@@ -145,24 +300,29 @@ namespace Minty
 		std::vector<float> _times;
 
 		/// <summary>
-		/// A list of all values being set by this Animation.
+		/// The compiled steps within this Animation, one track for each variable being set.
+		/// </summary>
+		std::vector<AnimationTrack> _tracks;
+
+		/// <summary>
+		/// The compiled steps taken when the animation is reset.
 		/// </summary>
-		std::vector<Node> _values;
+		std::vector<AnimationTrack> _reset;
 
 		/// <summary>
-		/// The compilation of steps within this Animation.
-		/// [Entity index: 8 bits][Component index: 8 bits][Offset index: 8 bits][Time index: 18 bits][Value index: 18 bits][Flags: 4 bits]
-		/// 
-		/// Key: The combined IDs of Entity, Component, Variable
-		/// Value Key: Time ID
-		/// Value Value: Value and Flags
+		/// The interpolated variables within this Animation.
 		/// </summary>
-		std::unordered_map<step_key_t, std::unordered_map<step_time_t, step_value_t>> _steps;
+		std::vector<AnimationCurve> _curves;
 
 		/// <summary>
-		/// The steps taken when the animation is reset.
+		/// The time of each key, for every curve, ordered by time within each curve.
 		/// </summary>
-		std::unordered_map<step_key_t, std::vector<step_value_t>> _reset;
+		std::vector<float> _curveTimes;
+
+		/// <summary>
+		/// The value of each key, for every curve. Smaller values are padded to four components.
+		/// </summary>
+		std::vector<Vector4> _curveValues;
 
 	public:
 		/// <summary>
@@ -190,28 +350,91 @@ namespace Minty
 		/// <param name="elapsedTime">The time that has elapsed over the last frame.</param>
 		/// <param name="index">The index of the next step to perform.</param>
 		/// <param name="thisEntity">The entity in which this Animation is being acted upon.</param>
-		/// <param name="registry">The EntityRegistry in which thisEntity is in.</param>
+		/// <param name="binding">The Entities this Animation acts upon, for thisEntity. Updated if it was found for a different Animation.</param>
+		/// <param name="scene">The Scene in which thisEntity is in.</param>
 		/// <returns>True when the animation has completed, otherwise false.</returns>
-		bool animate(float& time, float const elapsedTime, Index& index, Entity const thisEntity, Scene& scene) const;
+		bool animate(float& time, float const elapsedTime, Index& index, Entity const thisEntity, AnimationBinding& binding, Scene& scene) const;
 
 		/// <summary>
 		/// Performs a reset on an Entity.
 		/// </summary>
 		/// <param name="thisEntity">The Entity to reset.</param>
+		/// <param name="binding">The Entities this Animation acts upon, for thisEntity. Updated if it was found for a different Animation.</param>
+		/// <param name="scene">The Scene in which thisEntity is in.</param>
+		void reset(Entity const thisEntity, AnimationBinding& binding, Scene& scene) const;
+
+		/// <summary>
+		/// Finds the Entities this Animation acts upon, if the binding was not already found for this Animation.
+		/// </summary>
+		/// <param name="binding">The binding to update.</param>
+		/// <param name="registry">The EntityRegistry to find the Entities in.</param>
+		void bind(AnimationBinding& binding, EntityRegistry& registry) const;
+
+		/// <summary>
+		/// Gets the number of curves within this Animation.
+		/// </summary>
+		/// <returns></returns>
+		size_t get_curve_count() const;
+
+		/// <summary>
+		/// Evaluates every curve at the given time. Does not modify any Entities, so it is safe to call from any thread.
+		/// </summary>
+		/// <param name="time">The time within the Animation.</param>
+		/// <param name="results">The values, one for each curve.</param>
+		void evaluate(float const time, Vector4* const results) const;
+
+		/// <summary>
+		/// Sets the evaluated curve values on the Entities.
+		/// </summary>
+		/// <param name="results">The values, one for each curve, from evaluate.</param>
+		/// <param name="thisEntity">The entity in which this Animation is being acted upon.</param>
+		/// <param name="binding">The Entities this Animation acts upon, for thisEntity. Updated if it was found for a different Animation.</param>
 		/// <param name="registry">The EntityRegistry in which thisEntity is in.</param>
-		void reset(Entity const thisEntity, Scene& scene) const;
+		void apply(Vector4 const* const results, Entity const thisEntity, AnimationBinding& binding, EntityRegistry& registry) const;
 
 	public:
 		static AnimationStep parse_step(String const& string);
 
+		/// <summary>
+		/// Parses a curve. The data holds the entity, component and variable indices, split by '/'.
+		/// </summary>
+		/// <param name="node">The node containing the curve.</param>
+		/// <returns></returns>
+		static AnimationCurveBuilder parse_curve(Node const& node);
+
+		/// <summary>
+		/// Registers a property, so Animations can set the variable directly.
+		/// Variables without a property are set by deserializing the Component with the one value.
+		/// </summary>
+		/// <param name="componentName">The name of the Component.</param>
+		/// <param name="variableName">The name of the variable, as it is serialized.</param>
+		/// <param name="property">The property.</param>
+		static void register_property(String const& componentName, String const& variableName, AnimationProperty const& property);
+
+		/// <summary>
+		/// Finds the property for the given variable.
+		/// </summary>
+		/// <param name="componentName">The name of the Component.</param>
+		/// <param name="variableName">The name of the variable, as it is serialized.</param>
+		/// <returns>The property, or null if none was registered.</returns>
+		static AnimationProperty const* find_property(String const& componentName, String const& variableName);
+
 	private:
-		step_key_t compile_key(size_t const entityIndex, size_t const componentIndex, size_t const variableIndex) const;
+		// compiles the steps into tracks, one per variable
+		std::vector<AnimationTrack> compile_tracks(std::vector<std::pair<Index, AnimationStep>> const& steps, std::vector<Node> const& values) const;
+
+		// compiles the curve keys into the contiguous curve arrays
+		void compile_curve(AnimationCurveBuilder const& builder);
+
+		// finds each Entity in the binding by name
+		void find_entities(AnimationBinding& binding, EntityRegistry& registry) const;
 
-		step_value_t compile_value(size_t const valueIndex, AnimationStepFlags const flags) const;
+		// gets the Entity at the given index, or thisEntity if the index is MAX_ENTITY_INDEX
+		Entity get_entity(size_t const entityIndex, Entity const thisEntity, AnimationBinding& binding, EntityRegistry& registry) const;
 
-		void perform_step(step_key_t const key, step_time_t const time, step_value_t const value, Entity const thisEntity, Scene& scene) const;
+		void perform_step(AnimationTrack const& track, AnimationKey const& key, Entity const thisEntity, AnimationBinding& binding, EntityRegistry& registry) const;
 
-		void perform_step(AnimationStep const& step, Entity const thisEntity, Scene& scene) const;
+		static std::unordered_map<String, AnimationProperty>& get_properties();
 	public:
 		void serialize(Writer& writer) const override;
 		void deserialize(Reader const& reader) override;
@@ -4,6 +4,7 @@
 #include "Minty/Animation/M_AnimatorComponent.h"
 #include "Minty/Rendering/M_SpriteComponent.h"
 #include "Minty/Components/M_EnabledComponent.h"
+#include "Minty/Components/M_DirtyComponent.h"
 #include "Minty/Assets/M_Asset.h"
 #include "Minty/Rendering/M_RenderEngine.h"
 #include "Minty/Rendering/M_RenderSystem.h"
@@ -13,9 +14,24 @@
 #include "Minty/Scenes/M_Scene.h"
 #include "Minty/Serialization/M_Reader.h"
 #include "Minty/Serialization/M_Writer.h"
+#include "Minty/Multithreading/M_JobSystem.h"
 
 using namespace Minty;
 
+// the number of animators evaluated by each Job
+constexpr static size_t ANIMATION_GRAIN_SIZE = 64;
+
+Minty::AnimationSystem::AnimationSystem(Scene& scene)
+	: System("Animation", scene)
+	, _evaluations()
+	, _curveValues()
+{
+	// the animation steps may add or remove any registered component, but the system does not need the whole engine to itself
+	declare_structural();
+	declare_writes<AnimatorComponent, DirtyComponent>();
+	declare_reads<EnabledComponent>();
+}
+
 void Minty::AnimationSystem::update(Time const time)
 {
 	float deltaTime = time.elapsed;
@@ -24,6 +40,9 @@ void Minty::AnimationSystem::update(Time const time)
 
 	AssetEngine& assets = AssetEngine::instance();
 
+	_evaluations.clear();
+	size_t curveCount = 0;
+
 	for (auto&& [entity, animatorComponent, enabled] : registry.view<AnimatorComponent, EnabledComponent const>().each())
 	{
 		// update the animator, get the current animation ID
@@ -38,7 +57,7 @@ void Minty::AnimationSystem::update(Time const time)
 			// get the animation so it can be used
 			if (animatorComponent.animation)
 			{
-				animatorComponent.animation->reset(entity, get_scene());
+				animatorComponent.animation->reset(entity, animatorComponent.binding, get_scene());
 			}
 
 			// reset animator for new animation
@@ -54,7 +73,22 @@ void Minty::AnimationSystem::update(Time const time)
 		}
 
 		// animate with it
-		if (animatorComponent.animation->animate(animatorComponent.time, deltaTime, animatorComponent.index, entity, get_scene()))
+		bool const completed = animatorComponent.animation->animate(animatorComponent.time, deltaTime, animatorComponent.index, entity, animatorComponent.binding, get_scene());
+
+		// evaluate the curves at the time reached, before looping back around
+		if (size_t const count = animatorComponent.animation->get_curve_count())
+		{
+			_evaluations.push_back(CurveEvaluation
+				{
+					.entity = entity,
+					.animatorComponent = &animatorComponent,
+					.time = animatorComponent.time,
+					.offset = curveCount,
+				});
+			curveCount += count;
+		}
+
+		if (completed)
 		{
 			// animation has completed, loop if supposed to
 			if (animatorComponent.animation->loops())
@@ -70,4 +104,22 @@ void Minty::AnimationSystem::update(Time const time)
 			}
 		}
 	}
+
+	if (_evaluations.empty()) return;
+
+	// evaluate every curve, which does not touch the registry, so it can be split between the workers
+	_curveValues.resize(curveCount);
+
+	JobSystem::instance().parallel_for(0, _evaluations.size(), [this](size_t const i)
+		{
+			CurveEvaluation const& evaluation = _evaluations[i];
+			evaluation.animatorComponent->animation->evaluate(evaluation.time, _curveValues.data() + evaluation.offset);
+		}, ANIMATION_GRAIN_SIZE);
+
+	// then set the values, which may mark Entities as dirty
+	for (CurveEvaluation const& evaluation : _evaluations)
+	{
+		AnimatorComponent& animatorComponent = *evaluation.animatorComponent;
+		animatorComponent.animation->apply(_curveValues.data() + evaluation.offset, evaluation.entity, animatorComponent.binding, registry);
+	}
 }
@@ -7,6 +7,8 @@
 
 namespace Minty
 {
+    struct AnimatorComponent;
+
     /// <summary>
     /// Handles User Interface (UI) inputs.
     /// </summary>
@@ -14,12 +16,26 @@ namespace Minty
         : public System
     {
     private:
+        /// <summary>
+        /// An animator whose curves are evaluated this frame.
+        /// </summary>
+        struct CurveEvaluation
+        {
+            Entity entity;
+            AnimatorComponent* animatorComponent;
+            float time;
+
+            // the index of the first curve value within _curveValues
+            size_t offset;
+        };
 
+    private:
+        // reused each frame, so evaluating does not allocate
+        std::vector<CurveEvaluation> _evaluations;
+        std::vector<Vector4> _curveValues;
 
     public:
-        AnimationSystem(Scene& scene)
-            : System("Animation", scene)
-        {}
+        AnimationSystem(Scene& scene);
 
         void update(Time const time) override;
 
@@ -32,6 +32,11 @@ namespace Minty
 		/// </summary>
 		Animation::Index index = 0;
 
+		/// <summary>
+		/// The Entities the current animation acts upon.
+		/// </summary>
+		AnimationBinding binding;
+
 		void reset();
 
 		void serialize(Writer& writer) const override;
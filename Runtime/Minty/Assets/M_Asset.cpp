@@ -54,6 +54,8 @@ AssetType Minty::Asset::get_type(Path const& assetPath)
 
 		{ ".scene", AssetType::Scene },
 
+		{ ".prefab", AssetType::Prefab },
+
 		{ ".obj", AssetType::Mesh },
 
 		{ ".wav", AssetType::AudioClip },
@@ -103,6 +105,8 @@ std::vector<Path> const& Minty::Asset::get_extensions(AssetType const type)
 
 		{ AssetType::Scene, { ".scene" }},
 
+		{ AssetType::Prefab, { ".prefab" }},
+
 		{ AssetType::Mesh, { ".obj" }},
 
 		{ AssetType::AudioClip, { ".wav", ".mp3" }},
@@ -139,6 +143,7 @@ bool Minty::Asset::is_readable(AssetType const type)
 		AssetType::Shader,
 		AssetType::ShaderCode,
 		AssetType::Scene,
+		AssetType::Prefab,
 		AssetType::Animation,
 		AssetType::Animator,
 	};
@@ -151,6 +156,38 @@ bool Minty::Asset::check_type(Path const& path, AssetType const type)
 	return get_type(path) == type;
 }
 
+CompressionSettings Minty::Asset::get_compression(AssetType const type)
+{
+	switch (type)
+	{
+	case AssetType::Texture:
+		// already compressed, so store as is
+		return CompressionSettings{ .codec = CompressionCodec::Zlib, .level = CompressionLevel::None };
+	case AssetType::AudioClip:
+	case AssetType::Mesh:
+	case AssetType::ShaderModule:
+		// large binary data that is loaded often, so use the codec that is fastest to uncompress
+		return CompressionSettings{ .codec = CompressionCodec::LZ4, .level = CompressionLevel::Fast };
+	case AssetType::Meta:
+	case AssetType::Text:
+	case AssetType::Script:
+	case AssetType::Sprite:
+	case AssetType::Material:
+	case AssetType::MaterialTemplate:
+	case AssetType::ShaderPass:
+	case AssetType::Shader:
+	case AssetType::ShaderCode:
+	case AssetType::Scene:
+	case AssetType::Prefab:
+	case AssetType::Animation:
+	case AssetType::Animator:
+		// text, so compress heavily
+		return CompressionSettings{ .codec = CompressionCodec::Zlib, .level = CompressionLevel::High };
+	default:
+		return CompressionSettings();
+	}
+}
+
 String Minty::to_string(AssetType const value)
 {
 	switch (value)
@@ -173,6 +210,7 @@ String Minty::to_string(AssetType const value)
 	case AssetType::Sprite: return "Sprite";
 	case AssetType::Mesh: return "Mesh";
 	case AssetType::Scene: return "Scene";
+	case AssetType::Prefab: return "Prefab";
 	default: return "";
 	}
 }
@@ -198,6 +236,7 @@ AssetType Minty::from_string_asset_type(String const& value)
 	if (value2 == "Sprite") return AssetType::Sprite;
 	if (value2 == "Mesh") return AssetType::Mesh;
 	if (value2 == "Scene") return AssetType::Scene;
+	if (value2 == "Prefab") return AssetType::Prefab;
 
 	return static_cast<AssetType>(0);
 }
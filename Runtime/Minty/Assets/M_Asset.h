@@ -4,6 +4,7 @@
 #include "Minty/Types/M_Node.h"
 #include "Minty/Types/M_Dynamic.h"
 #include "Minty/Types/M_UUID.h"
+#include "Minty/Tools/M_Compression.h"
 
 #include <filesystem>
 #include <array>
@@ -36,6 +37,7 @@ namespace Minty
 		Sprite,
 		Mesh,
 		Scene,
+		Prefab,
 	};
 
 	String to_string(AssetType const value);
@@ -105,6 +107,16 @@ namespace Minty
 
 		static bool check_type(Path const& path, AssetType const type);
 
+		/// <summary>
+		/// Gets the settings used to compress files of the given asset type when they are built into a Wrap file.
+		/// 
+		/// Files that are already compressed (images) are stored as is, so they can be viewed directly without uncompressing.
+		/// Text files compress well, so they use a high level.
+		/// </summary>
+		/// <param name="type"></param>
+		/// <returns></returns>
+		static CompressionSettings get_compression(AssetType const type);
+
 #pragma endregion
 	};
 }
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include "Minty/Audio/M_AudioClip.h"
 #include "Minty/Animation/M_Animation.h"
 #include "Minty/Animation/M_Animator.h"
+#include "Minty/Entities/M_Prefab.h"
 #include "Minty/Assets/M_GenericAsset.h"
 
 #ifdef MINTY_RELEASE
@@ -87,6 +88,7 @@ void load_descriptor_values(AssetEngine& engine, std::unordered_map<String, Dyna
 			break;
 		}
 		case VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+		case VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
 		{
 			// read raw data from files directly into the dynamic, for now
 			Dynamic d;
@@ -104,6 +106,7 @@ Minty::AssetEngine::AssetEngine()
 	, _assets()
 	, _assetsByType()
 	, _wrapper()
+	, _loads()
 {
 	MINTY_ASSERT_MESSAGE(!_instance, "There should only be one AssetEngine.");
 
@@ -126,6 +129,13 @@ Minty::AssetEngine::AssetEngine()
 
 Minty::AssetEngine::~AssetEngine()
 {
+	// the workers must be done with this engine before it goes away
+	for (std::shared_ptr<AssetLoad> const& load : _loads)
+	{
+		JobSystem::instance().wait(load->job);
+	}
+	_loads.clear();
+
 	unload_all();
 
 	_instance = nullptr;
@@ -147,6 +157,72 @@ bool Minty::AssetEngine::exists(Path const& path) const
 }
 
 Ref<Asset> Minty::AssetEngine::load_asset(Path const& path)
+{
+	AssetCreateFunc create = prepare_asset(path);
+
+	if (!create) return nullptr;
+
+	return create();
+}
+
+std::shared_ptr<AssetLoad> Minty::AssetEngine::load_asset_async(Path const& path)
+{
+	std::shared_ptr<AssetLoad> load = std::make_shared<AssetLoad>();
+	load->path = path;
+	_loads.push_back(load);
+
+	// read and decode the files on a worker
+	load->job = JobSystem::instance().schedule([this, load]()
+		{
+			load->create = prepare_asset(load->path);
+			load->ready = true;
+		});
+
+	return load;
+}
+
+void Minty::AssetEngine::update()
+{
+	// create the assets in the order they were requested, so dependencies are created first
+	while (!_loads.empty() && _loads.front()->ready)
+	{
+		std::shared_ptr<AssetLoad> load = _loads.front();
+		_loads.pop_front();
+
+		if (load->create)
+		{
+			load->asset = load->create();
+			load->create = nullptr;
+		}
+		load->done = true;
+	}
+}
+
+void Minty::AssetEngine::wait(AssetLoad const& load)
+{
+	while (true)
+	{
+		update();
+
+		if (load.done || _loads.empty())
+		{
+			return;
+		}
+
+		// wait for the next asset in line to be read, helping the workers while waiting
+		JobSystem::instance().wait(_loads.front()->job);
+	}
+}
+
+void Minty::AssetEngine::wait_all()
+{
+	while (!_loads.empty())
+	{
+		wait(*_loads.back());
+	}
+}
+
+AssetCreateFunc Minty::AssetEngine::prepare_asset(Path const& path)
 {
 	// get the asset type
 	AssetType type = Asset::get_type(path);
@@ -157,29 +233,31 @@ Ref<Asset> Minty::AssetEngine::load_asset(Path const& path)
 	switch (type)
 	{
 	case AssetType::Text:
-		return load_generic(path);
+		return prepare_generic(path);
 	case AssetType::Script:
-		return load_script(path);
+		return prepare_script(path);
 	case AssetType::Texture:
-		return load_texture(path);
+		return prepare_texture(path);
 	case AssetType::Sprite:
-		return load_sprite(path);
+		return prepare_sprite(path);
 	case AssetType::Material:
-		return load_material(path);
+		return prepare_material(path);
 	case AssetType::MaterialTemplate:
-		return load_material_template(path);
+		return prepare_material_template(path);
 	case AssetType::ShaderPass:
-		return load_shader_pass(path);
+		return prepare_shader_pass(path);
 	case AssetType::Shader:
-		return load_shader(path);
+		return prepare_shader(path);
 	case AssetType::Mesh:
-		return load_mesh(path);
+		return prepare_mesh(path);
 	case AssetType::AudioClip:
-		return load_audio_clip(path);
+		return prepare_audio_clip(path);
 	case AssetType::Animation:
-		return load_animation(path);
+		return prepare_animation(path);
 	case AssetType::Animator:
-		return load_animator(path);
+		return prepare_animator(path);
+	case AssetType::Prefab:
+		return prepare_prefab(path);
 	default:
 		MINTY_ERROR_FORMAT("load_asset not implemented for asset type: {}", path.extension().string());
 		return nullptr;
@@ -259,21 +337,38 @@ std::vector<char> Minty::AssetEngine::read_file(Path const& path) const
 	}
 }
 
+std::span<char const> Minty::AssetEngine::read_file_view(Path const& path, std::vector<char>& buffer) const
+{
+	switch (Application::instance().get_mode())
+	{
+	case ApplicationMode::Normal:
+		return _wrapper.read_view(path, buffer);
+	case ApplicationMode::Edit:
+		// if wrapper contains the file, read from wrapper, otherwise read from disk
+		if (_wrapper.contains(path)) return _wrapper.read_view(path, buffer);
+		buffer = File::read_all_chars(path);
+		return std::span<char const>(buffer.data(), buffer.size());
+	default:
+		MINTY_ABORT("Unrecognized ApplicationMode.");
+		return std::span<char const>();
+	}
+}
+
 String Minty::AssetEngine::read_text(Path const& path) const
 {
-	// read file as chars
-	std::vector<char> chars = read_file(path);
+	std::vector<char> buffer;
+	std::span<char const> data = read_file_view(path, buffer);
 
-	// add null char for good measure
-	chars.push_back('\0');
+	if (data.empty()) return String();
 
-	// turn into string
-	return String(chars.data());
+	// turn into string, stop at the null char if there is one
+	return String(data.data(), strnlen(data.data(), data.size()));
 }
 
 std::vector<Byte> Minty::AssetEngine::read_file_bytes(Path const& path) const
 {
-	std::vector<char> data = read_file(path);
+	std::vector<char> buffer;
+	std::span<char const> data = read_file_view(path, buffer);
 
 	std::vector<Byte> result(data.size());
 
@@ -284,25 +379,30 @@ std::vector<Byte> Minty::AssetEngine::read_file_bytes(Path const& path) const
 
 std::vector<String> Minty::AssetEngine::read_file_lines(Path const& path) const
 {
-	std::vector<char> data = read_file(path);
+	std::vector<char> buffer;
+	std::span<char const> data = read_file_view(path, buffer);
 
 	std::vector<String> result;
 
-	std::istringstream ss(String(data.data(), sizeof(char) * data.size()));
-
-	String line;
-	while (std::getline(ss, line))
+	// split the lines straight out of the view
+	char const* begin = data.data();
+	char const* end = data.data() + data.size();
+	while (begin < end)
 	{
+		char const* newLine = std::find(begin, end, '\n');
+
+		String& line = result.emplace_back(begin, newLine);
+
 		// remove the \r
 		line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
 
-		result.push_back(line);
+		begin = newLine + 1;
 	}
 
 	return result;
 }
 
-Ref <Texture> Minty::AssetEngine::load_texture(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_texture(Path const& path)
 {
 	CHECK(path);
 
@@ -324,35 +424,60 @@ Ref <Texture> Minty::AssetEngine::load_texture(Path const& path)
 		.mipmapMode = from_string_vk_sampler_mipmap_mode(reader.read_string("samplerMipmapMode", "NEAREST")),
 	};
 
-	return create<Texture>(builder);
+	if (builder.pixelFormat == PixelFormat::None)
+	{
+		MINTY_ERROR_FORMAT("Cannot load texture \"{}\" with a pixelFormat of None.", path.generic_string());
+		return nullptr;
+	}
+
+	// decode the pixels now, so only the upload is left
+	std::vector<char> buffer;
+	std::span<char const> fileData = read_file_view(path, buffer);
+	std::shared_ptr<Color> pixels(Texture::load_pixels(fileData, builder.pixelFormat, builder.width, builder.height), Texture::free_pixels);
+
+	if (!pixels)
+	{
+		MINTY_ERROR_FORMAT("Failed to load texture: {}", path.generic_string());
+		return nullptr;
+	}
+
+	return [this, builder, pixels]() mutable -> Ref<Asset>
+		{
+			builder.pixelData = pixels.get();
+			return create<Texture>(builder);
+		};
 }
 
-Ref <Sprite> Minty::AssetEngine::load_sprite(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_sprite(Path const& path)
 {
 	CHECK(path);
 
 	Node node = read_file_node(path);
 	Node meta = read_file_meta(path);
-	Reader reader(node);
 
-	SpriteBuilder builder
-	{
-		.id = meta.to_uuid(),
-		.path = path,
-		.texture = get<Texture>(reader.read_uuid("texture")),
-		.material = get<Material>(reader.read_uuid("material")),
-		.coordinateMode = from_string_coordinate_mode(reader.read_string("coordinateMode")),
-		.minCoords = reader.read_object("min", Vector2(0.0f, 0.0f)),
-		.maxCoords = reader.read_object("max", Vector2(1.0f, 1.0f)),
-		.pivot = reader.read_object("pivot", Vector2(0.5f, 0.5f)),
-	};
-
-	CHECK_DEPENDENCIES(path.filename().string(), builder.texture.get(), builder.material.get());
+	return [this, path, node, meta]() -> Ref<Asset>
+		{
+			Reader reader(node);
 
-	return create<Sprite>(builder);
+			SpriteBuilder builder
+			{
+				.id = meta.to_uuid(),
+				.path = path,
+				.texture = get<Texture>(reader.read_uuid("texture")),
+				.material = get<Material>(reader.read_uuid("material")),
+				.coordinateMode = from_string_coordinate_mode(reader.read_string("coordinateMode")),
+				.minCoords = reader.read_object("min", Vector2(0.0f, 0.0f)),
+				.maxCoords = reader.read_object("max", Vector2(1.0f, 1.0f)),
+				.pivot = reader.read_object("pivot", Vector2(0.5f, 0.5f)),
+			};
+
+			CHECK_DEPENDENCIES(path.filename().string(), builder.texture.get(), builder.material.get());
+
+			return create<Sprite>(builder);
+		};
 }
 
-Ref <Shader> Minty::AssetEngine::load_shader(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_shader(Path const& path)
 {
 	CHECK(path);
 
@@ -396,10 +521,13 @@ Ref <Shader> Minty::AssetEngine::load_shader(Path const& path)
 		builder.uniformConstantInfos.emplace(uniformConstantInfo.name, uniformConstantInfo);
 	}
 
-	return create<Shader>(builder);
+	return [this, builder]() -> Ref<Asset>
+		{
+			return create<Shader>(builder);
+		};
 }
 
-Ref <ShaderPass> Minty::AssetEngine::load_shader_pass(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_shader_pass(Path const& path)
 {
 	CHECK(path);
 
@@ -412,8 +540,7 @@ Ref <ShaderPass> Minty::AssetEngine::load_shader_pass(Path const& path)
 		.id = meta.to_uuid(),
 		.path = path,
 	};
-	builder.shader = get<Shader>(reader.read_uuid("shader"));
-	CHECK_DEPENDENCIES(path.filename().string(), builder.shader.get());
+	UUID shaderId = reader.read_uuid("shader");
 
 	builder.topology = from_string_vk_primitive_topology(reader.read_string("primitiveTopology"));
 	builder.polygonMode = from_string_vk_polygon_mode(reader.read_string("polygonMode"));
@@ -447,6 +574,9 @@ Ref <ShaderPass> Minty::AssetEngine::load_shader_pass(Path const& path)
 		builder.vertexAttributes.push_back(attribute);
 	}
 	nodes = node.find_all("stage");
+	// the stage code views may point into these, so keep them alive until the ShaderPass is created
+	auto codeBuffers = std::make_shared<std::vector<std::vector<char>>>();
+	codeBuffers->reserve(nodes.size());
 	for (auto const* child : nodes)
 	{
 		ShaderPassBuilder::ShaderStageInfo info;
@@ -454,85 +584,98 @@ Ref <ShaderPass> Minty::AssetEngine::load_shader_pass(Path const& path)
 
 		info.stage = from_string_vk_shader_stage_flag_bits(childReader.read_string("stage", childReader.to_string()));
 		String path = childReader.read_string("path");
-		info.code = read_file(path);
+		info.code = read_file_view(path, codeBuffers->emplace_back());
 		info.entry = childReader.read_string("entry", "main");
 
 		builder.stages.push_back(info);
 	}
 
-	return create<ShaderPass>(builder);
+	return [this, path, builder, shaderId, codeBuffers]() mutable -> Ref<Asset>
+		{
+			builder.shader = get<Shader>(shaderId);
+			CHECK_DEPENDENCIES(path.filename().string(), builder.shader.get());
+
+			return create<ShaderPass>(builder);
+		};
 }
 
-Ref <MaterialTemplate> Minty::AssetEngine::load_material_template(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_material_template(Path const& path)
 {
 	CHECK(path);
 
 	Node node = read_file_node(path);
 	Node meta = read_file_meta(path);
 
-	MaterialTemplateBuilder builder
-	{
-		.id = meta.to_uuid(),
-		.path = path,
-	};
+	return [this, path, node, meta]() -> Ref<Asset>
+		{
+			MaterialTemplateBuilder builder
+			{
+				.id = meta.to_uuid(),
+				.path = path,
+			};
 
-	int missingPasses = 0;
-	std::vector<Node const*> nodes = node.find_all("pass");
-	for (auto const* child : nodes)
-	{
-		Ref<ShaderPass> pass = get<ShaderPass>(child->to_uuid());
-		if (!pass) missingPasses++;
-		else builder.shaderPasses.push_back(pass);
-	}
+			int missingPasses = 0;
+			std::vector<Node const*> nodes = node.find_all("pass");
+			for (auto const* child : nodes)
+			{
+				Ref<ShaderPass> pass = get<ShaderPass>(child->to_uuid());
+				if (!pass) missingPasses++;
+				else builder.shaderPasses.push_back(pass);
+			}
 
-	CHECK_MISSING_DEPENDENCIES(path.filename().string(), missingPasses);
+			CHECK_MISSING_DEPENDENCIES(path.filename().string(), missingPasses);
 
-	if (Node const* child = node.find("defaults"))
-	{
-		// get shader uniform constant values so we know how to interpret the values in the materials
-		Ref<ShaderPass> shaderPass = builder.shaderPasses.front();
-		Ref<Shader> shader = shaderPass->get_shader();
+			if (Node const* child = node.find("defaults"))
+			{
+				// get shader uniform constant values so we know how to interpret the values in the materials
+				Ref<ShaderPass> shaderPass = builder.shaderPasses.front();
+				Ref<Shader> shader = shaderPass->get_shader();
 
-		load_descriptor_values(*this, builder.defaultValues, *child, shader->get_uniform_constant_infos(DESCRIPTOR_SET_MATERIAL));
-	}
+				load_descriptor_values(*this, builder.defaultValues, *child, shader->get_uniform_constant_infos(DESCRIPTOR_SET_MATERIAL));
+			}
 
-	return create<MaterialTemplate>(builder);
+			return create<MaterialTemplate>(builder);
+		};
 }
 
-Ref <Material> Minty::AssetEngine::load_material(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_material(Path const& path)
 {
 	CHECK(path);
 
 	Node node = read_file_node(path);
 	Node meta = read_file_meta(path);
-	Reader reader(node);
 
-	MaterialBuilder builder
-	{
-		.id = meta.to_uuid(),
-		.path = path,
-	};
+	return [this, path, node, meta]() -> Ref<Asset>
+		{
+			Reader reader(node);
 
-	builder.materialTemplate = get<MaterialTemplate>(reader.read_uuid("template"));
+			MaterialBuilder builder
+			{
+				.id = meta.to_uuid(),
+				.path = path,
+			};
 
-	CHECK_DEPENDENCIES(path.filename().string(), builder.materialTemplate.get());
+			builder.materialTemplate = get<MaterialTemplate>(reader.read_uuid("template"));
 
-	if (Node const* child = node.find("values"))
-	{
-		// get shader uniform constant values so we know how to interpret the values in the materials
-		MINTY_ASSERT(builder.materialTemplate != nullptr);
-		Ref<ShaderPass> shaderPass = builder.materialTemplate->get_shader_passes().front();
-		MINTY_ASSERT(shaderPass != nullptr);
-		Ref<Shader> shader = shaderPass->get_shader();
-		MINTY_ASSERT(shader != nullptr);
+			CHECK_DEPENDENCIES(path.filename().string(), builder.materialTemplate.get());
 
-		load_descriptor_values(*this, builder.values, *child, shader->get_uniform_constant_infos(DESCRIPTOR_SET_MATERIAL));
-	}
+			if (Node const* child = node.find("values"))
+			{
+				// get shader uniform constant values so we know how to interpret the values in the materials
+				MINTY_ASSERT(builder.materialTemplate != nullptr);
+				Ref<ShaderPass> shaderPass = builder.materialTemplate->get_shader_passes().front();
+				MINTY_ASSERT(shaderPass != nullptr);
+				Ref<Shader> shader = shaderPass->get_shader();
+				MINTY_ASSERT(shader != nullptr);
+
+				load_descriptor_values(*this, builder.values, *child, shader->get_uniform_constant_infos(DESCRIPTOR_SET_MATERIAL));
+			}
 
-	return create<Material>(builder);
+			return create<Material>(builder);
+		};
 }
 
-Ref <Mesh> Minty::AssetEngine::load_mesh(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_mesh(Path const& path)
 {
 	CHECK(path);
 
@@ -552,18 +695,27 @@ Ref <Mesh> Minty::AssetEngine::load_mesh(Path const& path)
 		.path = path,
 	};
 
-	Ref<Mesh> mesh = create<Mesh>(builder);
-
 	// determine how to load the file
+	auto vertices = std::make_shared<std::vector<Vertex3D>>();
+	auto indices = std::make_shared<std::vector<uint16_t>>();
 	if (extension == ".obj")
 	{
-		load_mesh_obj(path, *mesh);
+		read_mesh_obj(path, *vertices, *indices);
 	}
 
-	return mesh;
+	return [this, builder, vertices, indices]() -> Ref<Asset>
+		{
+			Ref<Mesh> mesh = create<Mesh>(builder);
+
+			// all vertices and indices populated
+			mesh->set_vertices(*vertices);
+			mesh->set_indices(*indices);
+
+			return mesh;
+		};
 }
 
-void Minty::AssetEngine::load_mesh_obj(Path const& path, Mesh& mesh)
+void Minty::AssetEngine::read_mesh_obj(Path const& path, std::vector<Vertex3D>& vertices, std::vector<uint16_t>& indices) const
 {
 	std::vector<String> lines = read_file_lines(path);
 
@@ -572,8 +724,6 @@ void Minty::AssetEngine::load_mesh_obj(Path const& path, Mesh& mesh)
 	std::vector<Vector3> normals;
 
 	std::unordered_map<Vector3Int, uint16_t> faces;
-	std::vector<Vertex3D> vertices;
-	std::vector<uint16_t> indices;
 
 	std::istringstream ss;
 	String token;
@@ -659,13 +809,9 @@ void Minty::AssetEngine::load_mesh_obj(Path const& path, Mesh& mesh)
 			}
 		}
 	}
-
-	// all vertices and indices populated
-	mesh.set_vertices(vertices);
-	mesh.set_indices(indices);
 }
 
-Ref <AudioClip> Minty::AssetEngine::load_audio_clip(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_audio_clip(Path const& path)
 {
 	CHECK(path);
 
@@ -683,11 +829,18 @@ Ref <AudioClip> Minty::AssetEngine::load_audio_clip(Path const& path)
 		.singleInstance = reader.read_bool("singleInstance", false)
 	};
 
-	// the clip will load the audio file via the path in the constructor
-	return create<AudioClip>(builder);
+	// the clip reads and decodes the audio file in the constructor, so do that here on the worker
+	// only the finished clip is published on the main thread
+	Owner<AudioClip> clip(builder);
+
+	return [this, clip]() -> Ref<Asset>
+		{
+			emplace(clip);
+			return clip.create_ref<Asset>();
+		};
 }
 
-Ref <Animation> Minty::AssetEngine::load_animation(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_animation(Path const& path)
 {
 	CHECK(path);
 
@@ -741,11 +894,21 @@ Ref <Animation> Minty::AssetEngine::load_animation(Path const& path)
 			builder.resetSteps.push_back(Animation::parse_step(resetNode.get_node_string()));
 		}
 	}
+	if (Node const* curvesNode = reader.get_node().find("curves"))
+	{
+		for (Node const& curveNode : curvesNode->get_children())
+		{
+			builder.curves.push_back(Animation::parse_curve(curveNode));
+		}
+	}
 
-	return create<Animation>(builder);
+	return [this, builder]() -> Ref<Asset>
+		{
+			return create<Animation>(builder);
+		};
 }
 
-Ref <Animator> Minty::AssetEngine::load_animator(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_animator(Path const& path)
 {
 	CHECK(path);
 
@@ -760,24 +923,51 @@ Ref <Animator> Minty::AssetEngine::load_animator(Path const& path)
 	};
 	reader.read_object_ref("fsm", builder.fsm);
 
-	return create<Animator>(builder);
+	return [this, builder]() -> Ref<Asset>
+		{
+			return create<Animator>(builder);
+		};
 }
 
-Ref<Asset> Minty::AssetEngine::load_script(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_prefab(Path const& path)
+{
+	CHECK(path);
+
+	Node meta = read_file_meta(path);
+
+	// the Entities are parsed here, then compiled the first time the Prefab is instantiated
+	PrefabBuilder builder
+	{
+		.id = meta.to_uuid(),
+		.path = path,
+		.node = read_file_node(path),
+	};
+
+	return [this, builder]() -> Ref<Asset>
+		{
+			return create<Prefab>(builder);
+		};
+}
+
+AssetCreateFunc Minty::AssetEngine::prepare_script(Path const& path)
 {
 	// load meta, get its id, that's it
 	CHECK(path);
 
 	Node meta = read_file_meta(path);
+	UUID id = meta.to_uuid();
 
-	// add to script engine for later use
-	ScriptEngine& scriptEngine = ScriptEngine::instance();
-	scriptEngine.register_script_id(meta.to_uuid(), path.stem().string());
+	return [this, path, id]() -> Ref<Asset>
+		{
+			// add to script engine for later use
+			ScriptEngine& scriptEngine = ScriptEngine::instance();
+			scriptEngine.register_script_id(id, path.stem().string());
 
-	return create<Asset>(meta.to_uuid(), path);
+			return create<Asset>(id, path);
+		};
 }
 
-Ref<GenericAsset> Minty::AssetEngine::load_generic(Path const& path)
+AssetCreateFunc Minty::AssetEngine::prepare_generic(Path const& path)
 {
 	CHECK(path);
 
@@ -797,7 +987,10 @@ Ref<GenericAsset> Minty::AssetEngine::load_generic(Path const& path)
 		.text = String(fileData.data()),
 	};
 
-	return create<GenericAsset>(builder);
+	return [this, builder]() -> Ref<Asset>
+		{
+			return create<GenericAsset>(builder);
+		};
 }
 
 void Minty::AssetEngine::unload(UUID const id)
@@ -4,6 +4,10 @@
 #include "Minty/Types/M_Types.h"
 #include "Minty/Assets/M_Asset.h"
 #include "Minty/Files/M_Wrapper.h"
+#include "Minty/Multithreading/M_JobSystem.h"
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -27,6 +31,89 @@ namespace Minty
 	class Animation;
 	class Animator;
 
+	class Prefab;
+
+	namespace Builtin
+	{
+		struct Vertex3D;
+	}
+
+	/// <summary>
+	/// Creates an Asset from the data that was read for it. Must be called on the main thread.
+	/// </summary>
+	typedef std::function<Ref<Asset>()> AssetCreateFunc;
+
+	/// <summary>
+	/// The state of an Asset that is being loaded asynchronously.
+	/// </summary>
+	struct AssetLoad
+	{
+		/// <summary>
+		/// The path to the Asset.
+		/// </summary>
+		Path path;
+
+		/// <summary>
+		/// Creates the Asset. Set on a worker thread, once the files have been read and decoded.
+		/// </summary>
+		AssetCreateFunc create;
+
+		/// <summary>
+		/// The Job reading and decoding the files.
+		/// </summary>
+		JobHandle job;
+
+		/// <summary>
+		/// True once the files have been read and decoded.
+		/// </summary>
+		std::atomic<bool> ready = false;
+
+		/// <summary>
+		/// The loaded Asset, or null if it failed to load. Set on the main thread.
+		/// </summary>
+		Ref<Asset> asset;
+
+		/// <summary>
+		/// True once the Asset has been created.
+		/// </summary>
+		bool done = false;
+	};
+
+	/// <summary>
+	/// A handle to an Asset that is being loaded asynchronously.
+	/// </summary>
+	/// <typeparam name="T">The type of Asset.</typeparam>
+	template<typename T>
+	class AssetHandle
+	{
+	private:
+		std::shared_ptr<AssetLoad> _load;
+
+	public:
+		AssetHandle() = default;
+
+		AssetHandle(std::shared_ptr<AssetLoad> const& load)
+			: _load(load) {}
+
+		/// <summary>
+		/// Checks if this handle refers to an Asset load.
+		/// </summary>
+		/// <returns></returns>
+		bool valid() const { return _load != nullptr; }
+
+		/// <summary>
+		/// Checks if the Asset has been created.
+		/// </summary>
+		/// <returns></returns>
+		bool done() const { return _load && _load->done; }
+
+		/// <summary>
+		/// Gets the Asset. Waits for it to be loaded if it has not been created yet. Must be called on the main thread.
+		/// </summary>
+		/// <returns>The Asset, or null if it failed to load.</returns>
+		Ref<T> get() const;
+	};
+
 	/// <summary>
 	/// Handles loading and unloading assets for use within the engine.
 	/// </summary>
@@ -39,6 +126,10 @@ namespace Minty
 
 		Wrapper _wrapper;
 
+		// assets being loaded asynchronously, in the order they were requested
+		// the files are read and decoded by the JobSystem
+		std::deque<std::shared_ptr<AssetLoad>> _loads;
+
 		static AssetEngine* _instance;
 	public:
 		AssetEngine();
@@ -52,6 +143,14 @@ namespace Minty
 
 		std::vector<char> read_file(Path const& path) const;
 
+		/// <summary>
+		/// Gets a view of the data from the file at the given path, without copying it when possible.
+		/// </summary>
+		/// <param name="path">The path to the file.</param>
+		/// <param name="buffer">The buffer to read or uncompress into, if the file cannot be viewed directly.</param>
+		/// <returns>A view of the file data, which is valid as long as the buffer is alive and unchanged.</returns>
+		std::span<char const> read_file_view(Path const& path, std::vector<char>& buffer) const;
+
 		String read_text(Path const& path) const;
 
 		// reads the file at the given path as a node
@@ -90,6 +189,43 @@ namespace Minty
 			return static_cast<Ref<T>>(load_asset(path));
 		}
 
+		/// <summary>
+		/// Starts loading a generic Asset. The files are read and decoded by a Job, then the Asset is created on the main thread.
+		/// </summary>
+		/// <param name="path"></param>
+		/// <returns></returns>
+		std::shared_ptr<AssetLoad> load_asset_async(Path const& path);
+
+		/// <summary>
+		/// Starts loading the asset of the given type T from the path.
+		/// 
+		/// Assets are created in the order they were requested, so dependencies should be requested first.
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		/// <param name="path"></param>
+		/// <returns>A handle to the Asset.</returns>
+		template<typename T>
+		AssetHandle<T> load_async(Path const& path)
+		{
+			return AssetHandle<T>(load_asset_async(path));
+		}
+
+		/// <summary>
+		/// Creates the assets that have finished loading asynchronously. Called once per frame.
+		/// </summary>
+		void update();
+
+		/// <summary>
+		/// Waits for the given load to finish, creating assets as they are ready. Runs other Jobs while waiting.
+		/// </summary>
+		/// <param name="load"></param>
+		void wait(AssetLoad const& load);
+
+		/// <summary>
+		/// Waits for all loads to finish, creating assets as they are ready.
+		/// </summary>
+		void wait_all();
+
 		/// <summary>
 		/// Creates an asset of the given type T, using its corresponding builder, of type U.
 		/// </summary>
@@ -119,41 +255,47 @@ namespace Minty
 		int check_dependencies(std::vector<void*> const& dependencies) const;
 
 	private:
+		// reads the asset at the given path, and returns a function to create it, or null if it cannot be loaded
+		// the reading is safe to do on a worker thread, but the returned function must be called on the main thread
+		AssetCreateFunc prepare_asset(Path const& path);
+
 		/// <summary>
-		/// Loads the Texture at the given Path and returns its ID.
+		/// Reads and decodes the Texture at the given Path.
 		/// </summary>
 		/// <param name="path">The path to the asset file.</param>
-		/// <returns>The UUID of the Texture, or 0 if the asset does not exist.</returns>
-		Ref<Texture> load_texture(Path const& path);
+		/// <returns>A function that creates the Texture, or null if the asset does not exist.</returns>
+		AssetCreateFunc prepare_texture(Path const& path);
 
 		/// <summary>
-		/// Loads the Sprite at the given Path and returns its ID.
+		/// Reads the Sprite at the given Path.
 		/// </summary>
 		/// <param name="path">The path to the asset file.</param>
-		/// <returns>The UUID of the Texture, or 0 if the asset does not exist.</returns>
-		Ref<Sprite> load_sprite(Path const& path);
+		/// <returns>A function that creates the Sprite, or null if the asset does not exist.</returns>
+		AssetCreateFunc prepare_sprite(Path const& path);
+
+		AssetCreateFunc prepare_shader(Path const& path);
 
-		Ref<Shader> load_shader(Path const& path);
+		AssetCreateFunc prepare_shader_pass(Path const& path);
 
-		Ref<ShaderPass> load_shader_pass(Path const& path);
+		AssetCreateFunc prepare_material_template(Path const& path);
 
-		Ref<MaterialTemplate> load_material_template(Path const& path);
+		AssetCreateFunc prepare_material(Path const& path);
 
-		Ref<Material> load_material(Path const& path);
+		AssetCreateFunc prepare_mesh(Path const& path);
 
-		Ref<Mesh> load_mesh(Path const& path);
+		void read_mesh_obj(Path const& path, std::vector<Builtin::Vertex3D>& vertices, std::vector<uint16_t>& indices) const;
 
-		void load_mesh_obj(Path const& path, Mesh& mesh);
+		AssetCreateFunc prepare_audio_clip(Path const& path);
 
-		Ref<AudioClip> load_audio_clip(Path const& path);
+		AssetCreateFunc prepare_animation(Path const& path);
 
-		Ref<Animation> load_animation(Path const& path);
+		AssetCreateFunc prepare_animator(Path const& path);
 
-		Ref<Animator> load_animator(Path const& path);
+		AssetCreateFunc prepare_prefab(Path const& path);
 
-		Ref<Asset> load_script(Path const& path);
+		AssetCreateFunc prepare_script(Path const& path);
 
-		Ref<GenericAsset> load_generic(Path const& path);
+		AssetCreateFunc prepare_generic(Path const& path);
 
 #pragma endregion
 
@@ -268,4 +410,16 @@ namespace Minty
 		static AssetEngine& instance() { return *_instance; }
 	};
 
-	}
\ No newline at end of file
+	template<typename T>
+	Ref<T> AssetHandle<T>::get() const
+	{
+		if (!_load) return nullptr;
+
+		if (!_load->done)
+		{
+			AssetEngine::instance().wait(*_load);
+		}
+
+		return static_cast<Ref<T>>(_load->asset);
+	}
+}
\ No newline at end of file
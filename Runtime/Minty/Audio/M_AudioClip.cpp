@@ -21,10 +21,11 @@ Minty::AudioClip::AudioClip(AudioClipBuilder const& builder)
 void Minty::AudioClip::load(Path const& path)
 {
 	AssetEngine& assets = AssetEngine::instance();
-	std::vector<Byte> fileData = assets.read_file_bytes(path);
+	std::vector<char> buffer;
+	std::span<char const> fileData = assets.read_file_view(path, buffer);
 
-	// load clip
-	SoLoud::result result = _clip.loadMem(fileData.data(), static_cast<unsigned int>(fileData.size()), true, false);
+	// load clip, copying the data since the view does not outlive this function
+	SoLoud::result result = _clip.loadMem(reinterpret_cast<unsigned char const*>(fileData.data()), static_cast<unsigned int>(fileData.size()), true, false);
 
 	if (result != SoLoud::SOLOUD_ERRORS::SO_NO_ERROR)
 	{
@@ -36,6 +36,10 @@ namespace Minty
 		/// </summary>
 		AudioClip();
 
+		/// <summary>
+		/// Creates an AudioClip, reading and decoding the sound file at the builder's path. Safe to call on a worker thread.
+		/// </summary>
+		/// <param name="builder">The settings for the AudioClip.</param>
 		AudioClip(AudioClipBuilder const& builder);
 
 	private:
@@ -18,7 +18,12 @@ using namespace Minty;
 
 Minty::AudioSystem::AudioSystem(Scene& scene)
 	: System::System("Audio", scene)
-{}
+{
+	// the audio engine is thread safe, so this can run on a worker
+	declare_reads<TransformComponent, DirtyComponent, EnabledComponent, AudioListenerComponent>();
+	declare_writes<AudioSourceComponent>();
+	set_main_thread(false);
+}
 
 void Minty::AudioSystem::update(Time const time)
 {
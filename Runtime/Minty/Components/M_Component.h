@@ -3,6 +3,16 @@
 
 namespace Minty
 {
+	/// <summary>
+	/// Identifies a registered type of Component or Script. Assigned in order as each type is registered.
+	/// </summary>
+	typedef uint32_t ComponentTypeID;
+
+	/// <summary>
+	/// An invalid ComponentTypeID.
+	/// </summary>
+	constexpr ComponentTypeID ERROR_COMPONENT_TYPE_ID = UINT32_MAX;
+
 	/// <summary>
 	/// The base class for all Components.
 	/// </summary>
@@ -9,7 +9,13 @@ using namespace Minty;
 
 Matrix4 Minty::TransformComponent::get_local_matrix() const
 {
-	return glm::translate(Matrix4(1.0f), localPosition) * glm::mat4_cast(localRotation) * glm::scale(Matrix4(1.0f), localScale);
+	// same as translate * rotate * scale, without multiplying the full matrices
+	Matrix4 result = glm::mat4_cast(localRotation);
+	result[0] *= localScale.x;
+	result[1] *= localScale.y;
+	result[2] *= localScale.z;
+	result[3] = Vector4(localPosition, 1.0f);
+	return result;
 }
 
 Vector3 Minty::TransformComponent::get_global_position() const
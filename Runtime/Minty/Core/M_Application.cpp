@@ -33,11 +33,17 @@ Minty::Application::Application(ApplicationBuilder const& builder)
 	, _defaultLayer()
 	, _running()
 	, _time()
+	, _timeStart()
+	, _timeEnd()
+	, _fixedAccumulator()
+	, _maxFixedSteps(builder.maxFixedSteps)
 {
 	MINTY_ASSERT(!_instance);
 
 	_instance = this;
 
+	set_fixed_time_step(builder.fixedTimeStep);
+
 	try
 	{
 		// create engines
@@ -119,8 +125,14 @@ void Minty::Application::run()
 
 			_window->on_update();
 
+			// create any assets that finished loading in the background
+			AssetEngine::instance().update();
+
 			if (!_minimized)
 			{
+				// run the simulation at a fixed rate
+				update_fixed();
+
 				// update all layers
 				for (Layer* layer : _layerManager)
 				{
@@ -160,6 +172,18 @@ void Minty::Application::push_overlay(Layer* const layer)
 	_layerManager.push_overlay(layer);
 }
 
+void Minty::Application::set_fixed_time_step(float const step)
+{
+	// also catches NaN, since the assert is compiled out in release
+	if (!(step > 0.0f))
+	{
+		MINTY_ERROR_FORMAT("Cannot set the fixed time step to {}. It must be greater than 0.", step);
+		return;
+	}
+
+	_time.fixed.step = step;
+}
+
 void Minty::Application::close()
 {
 	_running = false;
@@ -237,6 +261,11 @@ void Minty::Application::reset_time()
 
 	_time.total = 0.0f;
 	_time.elapsed = 0.0f;
+
+	_time.fixed.total = 0.0f;
+	_time.fixed.steps = 0u;
+	_time.fixed.alpha = 0.0f;
+	_fixedAccumulator = 0.0f;
 }
 
 void Minty::Application::update_time()
@@ -251,6 +280,50 @@ void Minty::Application::update_time()
 	_timeEnd = now;
 }
 
+void Minty::Application::update_fixed()
+{
+	float const step = _time.fixed.step;
+
+	// no valid step, so there is nothing to simulate, and dividing by it below would give NaN
+	if (!(step > 0.0f))
+	{
+		_time.fixed.steps = 0u;
+		_time.fixed.alpha = 0.0f;
+		return;
+	}
+
+	_fixedAccumulator += _time.elapsed;
+
+	// the time given to each fixed update is one step
+	Time fixedTime = _time;
+	fixedTime.elapsed = step;
+
+	uint32_t steps = 0u;
+	while (_fixedAccumulator >= step && steps < _maxFixedSteps)
+	{
+		_time.fixed.total += step;
+		fixedTime.total = _time.fixed.total;
+		fixedTime.fixed.total = _time.fixed.total;
+
+		for (Layer* layer : _layerManager)
+		{
+			layer->on_fixed_update(fixedTime);
+		}
+
+		_fixedAccumulator -= step;
+		steps++;
+	}
+
+	if (_fixedAccumulator >= step)
+	{
+		// too far behind to catch up, so drop the extra time instead of running even more steps next frame
+		_fixedAccumulator = std::fmod(_fixedAccumulator, step);
+	}
+
+	_time.fixed.steps = steps;
+	_time.fixed.alpha = _fixedAccumulator / step;
+}
+
 bool Minty::Application::on_window_close(WindowCloseEvent& event)
 {
 	close();
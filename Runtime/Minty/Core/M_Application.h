@@ -63,6 +63,10 @@ namespace Minty
 
 		// config
 		ApplicationMode mode = ApplicationMode::Normal;
+		// the length of one fixed update step, in seconds
+		float fixedTimeStep = 1.0f / 60.0f;
+		// the most fixed update steps ran in one frame, so a slow frame cannot snowball into slower frames
+		uint32_t maxFixedSteps = 5u;
 		String currentWorkingDirectory = ".";
 		ApplicationCommandLineArguments commandLineArguments;
 	};
@@ -86,6 +90,9 @@ namespace Minty
 		Time _time;
 		TimePoint _timeStart;
 		TimePoint _timeEnd;
+		// time not simulated by the fixed steps yet, in seconds
+		float _fixedAccumulator;
+		uint32_t _maxFixedSteps;
 
 		static Application* _instance;
 	public:
@@ -100,6 +107,20 @@ namespace Minty
 		SceneManager& get_scene_manager() const;
 		Time get_time() const { return _time; }
 
+		/// <summary>
+		/// Sets the length of one fixed update step, in seconds.
+		/// </summary>
+		/// <param name="step"></param>
+		void set_fixed_time_step(float const step);
+		float get_fixed_time_step() const { return _time.fixed.step; }
+
+		/// <summary>
+		/// Sets the most fixed update steps that can be ran in one frame. Any time past that is dropped.
+		/// </summary>
+		/// <param name="steps"></param>
+		void set_max_fixed_steps(uint32_t const steps) { _maxFixedSteps = steps; }
+		uint32_t get_max_fixed_steps() const { return _maxFixedSteps; }
+
 		void push_engine(Engine* const engine);
 		void set_loaded_scene(Ref<Scene> const scene);
 		void set_working_scene(Ref<Scene> const scene);
@@ -123,6 +144,7 @@ namespace Minty
 
 		void reset_time();
 		void update_time();
+		void update_fixed();
 
 		bool on_window_close(WindowCloseEvent& event);
 		bool on_window_resize(WindowResizeEvent& event);
@@ -37,10 +37,31 @@ namespace Minty
 	constexpr unsigned int DESCRIPTOR_SET_SHADER_PASS = 1;
 	constexpr unsigned int DESCRIPTOR_SET_MATERIAL = 2;
 
+	/// <summary>
+	/// The size of each block of device memory that buffers and images are sub-allocated from, in bytes.
+	/// </summary>
+	constexpr uint64_t MEMORY_BLOCK_SIZE = 64ull * 1024ull * 1024ull;
+
+	/// <summary>
+	/// The size of the persistently mapped buffer that per-frame uniform data and staging uploads are written to, in bytes.
+	/// </summary>
+	constexpr uint64_t RING_BUFFER_SIZE = 8ull * 1024ull * 1024ull;
+
+	/// <summary>
+	/// The number of sprite instances that the per-frame instance buffers can hold before they need to grow.
+	/// </summary>
+	constexpr uint32_t SPRITE_INSTANCE_CAPACITY = 1024;
+
+	/// <summary>
+	/// The name of the storage buffer that sprite shaders read instance data from, when drawing instanced.
+	/// </summary>
+	constexpr char const* SPRITE_INSTANCES_NAME = "instances";
+
 	constexpr char const* SCRIPT_METHOD_NAME_ONCREATE = "OnCreate";
 	constexpr char const* SCRIPT_METHOD_NAME_ONLOAD = "OnLoad";
 	constexpr char const* SCRIPT_METHOD_NAME_ONENABLE = "OnEnable";
 	constexpr char const* SCRIPT_METHOD_NAME_ONUPDATE = "OnUpdate";
+	constexpr char const* SCRIPT_METHOD_NAME_ONFIXEDUPDATE = "OnFixedUpdate";
 	constexpr char const* SCRIPT_METHOD_NAME_ONDISABLE = "OnDisable";
 	constexpr char const* SCRIPT_METHOD_NAME_ONUNLOAD = "OnUnload";
 	constexpr char const* SCRIPT_METHOD_NAME_ONDESTROY = "OnDestroy";
@@ -53,6 +74,9 @@ namespace Minty
 	constexpr char const* SCRIPT_METHOD_NAME_ONPOINTERUP = "OnPointerUp";
 	constexpr char const* SCRIPT_METHOD_NAME_ONPOINTERCLICK = "OnPointerClick";
 
+	constexpr char const* SCRIPT_BATCH_CLASS_NAME = "ScriptBatch";
+	constexpr char const* SCRIPT_BATCH_METHOD_NAME_UPDATE = "Update";
+
 	constexpr char const* SCRIPT_INPUT_TRIGGER_KEY = "TriggerKey";
 	constexpr char const* SCRIPT_INPUT_TRIGGER_MOUSE_CLICK = "TriggerMouseClick";
 	constexpr char const* SCRIPT_INPUT_TRIGGER_MOUSE_MOVE = "TriggerMouseMove";
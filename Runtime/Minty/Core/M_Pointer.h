@@ -64,8 +64,8 @@ namespace Minty
 			if (_counter) _counter->strongCount++;
 		}
 
-		// create new
-		template<typename... Args>
+		// create new, but never from another Owner, so copies and moves of a const Owner still use the copy constructor
+		template<typename... Args, typename = std::enable_if_t<!(sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, Owner> && ...))>>
 		explicit Owner(Args&&... args)
 			: _ptr(new T(std::forward<Args>(args)...))
 			, _counter(new Counter())
@@ -0,0 +1,110 @@
+#include "pch.h"
+#include "Minty/Entities/M_EntityIndex.h"
+
+using namespace Minty;
+
+Minty::EntityIndex::EntityIndex()
+	: _groups()
+	, _slots()
+	, _version()
+{}
+
+void Minty::EntityIndex::emplace(Entity const entity, String const& key)
+{
+	size_t const entityIndex = static_cast<size_t>(entt::to_entity(entity));
+
+	if (entityIndex < _slots.size())
+	{
+		Group* group = _slots[entityIndex].group;
+
+		// ignore if the key has not changed
+		if (group && group->first == key) return;
+
+		erase(entity);
+	}
+	else
+	{
+		_slots.resize(entityIndex + 1, Slot{ nullptr, 0 });
+	}
+
+	// add to the group for the key, creating it if needed
+	Group& group = *_groups.try_emplace(key).first;
+	_slots[entityIndex] = Slot{ &group, group.second.size() };
+	group.second.push_back(entity);
+
+	_version++;
+}
+
+void Minty::EntityIndex::erase(Entity const entity)
+{
+	size_t const entityIndex = static_cast<size_t>(entt::to_entity(entity));
+
+	if (entityIndex >= _slots.size()) return;
+
+	Slot& slot = _slots[entityIndex];
+
+	if (!slot.group) return;
+
+	std::vector<Entity>& entities = slot.group->second;
+
+	// move the last Entity into the removed Entity's place
+	Entity const last = entities.back();
+	entities[slot.index] = last;
+	_slots[static_cast<size_t>(entt::to_entity(last))].index = slot.index;
+	entities.pop_back();
+
+	// remove the group once nothing has its key
+	if (entities.empty())
+	{
+		String const key = slot.group->first;
+		_groups.erase(key);
+	}
+
+	slot = Slot{ nullptr, 0 };
+
+	_version++;
+}
+
+bool Minty::EntityIndex::contains(Entity const entity) const
+{
+	size_t const entityIndex = static_cast<size_t>(entt::to_entity(entity));
+
+	return entityIndex < _slots.size() && _slots[entityIndex].group;
+}
+
+Entity Minty::EntityIndex::find_first(String const& key) const
+{
+	auto found = _groups.find(key);
+
+	if (found == _groups.end())
+	{
+		return NULL_ENTITY;
+	}
+
+	return found->second.front();
+}
+
+std::span<Entity const> Minty::EntityIndex::find(String const& key) const
+{
+	auto found = _groups.find(key);
+
+	if (found == _groups.end())
+	{
+		return std::span<Entity const>();
+	}
+
+	return std::span<Entity const>(found->second);
+}
+
+size_t Minty::EntityIndex::get_version() const
+{
+	return _version;
+}
+
+void Minty::EntityIndex::clear()
+{
+	_groups.clear();
+	_slots.clear();
+
+	_version++;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "Minty/Types/M_Object.h"
+#include "Minty/Entities/M_Entity.h"
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Minty
+{
+	/// <summary>
+	/// Groups Entities by a String key, such as their name or tag, so the Entities with a key can be found without searching through all of them.
+	/// 
+	/// Each Entity has at most one key. Many Entities can share the same key.
+	/// </summary>
+	class EntityIndex
+		: public Object
+	{
+	private:
+		typedef std::pair<String const, std::vector<Entity>> Group;
+
+		// the slot of an Entity that has a key
+		struct Slot
+		{
+			// the group the Entity is in, or null if it has no key
+			// groups are never moved by the map, so they can be pointed to
+			Group* group;
+			// the index of the Entity within the group
+			size_t index;
+		};
+
+		// the Entities with each key
+		std::unordered_map<String, std::vector<Entity>> _groups;
+		// the slot of each Entity, by entity index
+		std::vector<Slot> _slots;
+		// incremented each time an Entity is added or removed
+		size_t _version;
+
+	public:
+		EntityIndex();
+
+		/// <summary>
+		/// Sets the key of the given Entity, replacing its old key, if any.
+		/// </summary>
+		/// <param name="entity">The Entity to add.</param>
+		/// <param name="key">The key of the Entity.</param>
+		void emplace(Entity const entity, String const& key);
+
+		/// <summary>
+		/// Removes the given Entity, if it has a key.
+		/// </summary>
+		/// <param name="entity">The Entity to remove.</param>
+		void erase(Entity const entity);
+
+		/// <summary>
+		/// Checks if the given Entity has a key.
+		/// </summary>
+		/// <param name="entity"></param>
+		/// <returns></returns>
+		bool contains(Entity const entity) const;
+
+		/// <summary>
+		/// Gets the first Entity with the given key.
+		/// </summary>
+		/// <param name="key"></param>
+		/// <returns>The Entity, or NULL_ENTITY if no Entity has the key.</returns>
+		Entity find_first(String const& key) const;
+
+		/// <summary>
+		/// Gets all of the Entities with the given key, in no particular order.
+		/// </summary>
+		/// <param name="key"></param>
+		/// <returns>A view of the Entities, which is valid until an Entity is added to or removed from this EntityIndex.</returns>
+		std::span<Entity const> find(String const& key) const;
+
+		/// <summary>
+		/// Gets a number that changes each time an Entity is added to or removed from this EntityIndex.
+		/// </summary>
+		/// <returns></returns>
+		size_t get_version() const;
+
+		/// <summary>
+		/// Removes all Entities.
+		/// </summary>
+		void clear();
+	};
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Minty/Entities/M_EntityRegistry.h"
+#include "Minty/Entities/M_Prefab.h"
 
 #include "Minty/Serialization/M_SerializationData.h"
 #include "Minty/Tools/M_Console.h"
@@ -34,20 +35,34 @@
 #include "Minty/Serialization/M_Reader.h"
 #include "Minty/Serialization/M_Writer.h"
 
+#include <atomic>
 #include <sstream>
 #include <map>
 
 using namespace Minty;
 
-std::map<String const, EntityRegistry::ComponentFuncs const> EntityRegistry::_components = std::map<String const, EntityRegistry::ComponentFuncs const>();
-std::map<uint32_t const, String const> EntityRegistry::_componentTypes = std::map<uint32_t const, String const>();
+std::vector<EntityRegistry::ComponentFuncs> EntityRegistry::_componentFuncs = std::vector<EntityRegistry::ComponentFuncs>();
+std::vector<String> EntityRegistry::_componentNames = std::vector<String>();
+std::map<String const, ComponentTypeID const> EntityRegistry::_componentIds = std::map<String const, ComponentTypeID const>();
+std::vector<ComponentTypeID> EntityRegistry::_componentTypes = std::vector<ComponentTypeID>();
+
+// gets the generation for a new EntityRegistry
+static uint32_t next_generation()
+{
+	static std::atomic<uint32_t> generation = 0;
+	return ++generation;
+}
 
 Minty::EntityRegistry::EntityRegistry(Scene& scene)
 	: SceneObject(scene)
 	, entt::registry()
 	, _idToEntity()
 	, _entityToId()
+	, _names()
 	, _tags()
+	, _hierarchyDirty()
+	, _hierarchyVersion()
+	, _generation(next_generation())
 {
 	// TODO: this does not account for when somebody gets the component by reference and updates it that wey
 	// make it so whenever a transform is editied, it is marked as dirty
@@ -57,6 +72,14 @@ Minty::EntityRegistry::EntityRegistry(Scene& scene)
 	on_update<UITransformComponent>().connect<&EntityRegistry::emplace_or_replace<DirtyComponent>>();
 	on_construct<CanvasComponent>().connect<&EntityRegistry::emplace_or_replace<DirtyComponent>>();
 	on_update<CanvasComponent>().connect<&EntityRegistry::emplace_or_replace<DirtyComponent>>();
+
+	// any new or removed relationship changes the hierarchy order
+	on_construct<RelationshipComponent>().connect<&EntityRegistry::on_relationship_changed>(*this);
+	on_destroy<RelationshipComponent>().connect<&EntityRegistry::on_relationship_changed>(*this);
+
+	// keep the name and tag lookups up to date when the Entities are destroyed
+	on_destroy<NameComponent>().connect<&EntityRegistry::on_name_destroyed>(*this);
+	on_destroy<TagComponent>().connect<&EntityRegistry::on_tag_destroyed>(*this);
 }
 
 Minty::EntityRegistry::~EntityRegistry()
@@ -68,7 +91,7 @@ Minty::EntityRegistry::~EntityRegistry()
 
 Entity Minty::EntityRegistry::create()
 {
-	return create(UUID());
+	return create(UUID::create());
 }
 
 Entity Minty::EntityRegistry::create(UUID const uuid)
@@ -82,13 +105,17 @@ Entity Minty::EntityRegistry::create(UUID const uuid)
 
 Entity Minty::EntityRegistry::create(String const& name)
 {
-	return create(name, UUID());
+	return create(name, UUID::create());
 }
 
 Entity Minty::EntityRegistry::create(String const& name, UUID const uuid)
 {
 	Entity entity = create(uuid);
-	if (!name.empty()) emplace<NameComponent>(entity).name = name;
+	if (!name.empty())
+	{
+		emplace<NameComponent>(entity).name = name;
+		_names.emplace(entity, name);
+	}
 	return entity;
 }
 
@@ -171,37 +198,40 @@ bool Minty::EntityRegistry::get_renderable(Entity const entity) const
 
 void Minty::EntityRegistry::dirty(Entity const entity)
 {
-	if (!all_of<DirtyComponent>(entity))
-	{
-		emplace<DirtyComponent>(entity);
-	}
-
-	if (!all_of<RelationshipComponent>(entity))
-	{
-		// no children
-		return;
-	}
+	dirty(std::span<Entity const>(&entity, 1));
+}
 
-	RelationshipComponent& relationship = get<RelationshipComponent>(entity);
+void Minty::EntityRegistry::dirty(std::span<Entity const> const entities)
+{
+	// dirty the Entities and all of their children, without recursing
+	std::vector<Entity> stack(entities.begin(), entities.end());
 
-	if (!relationship.children)
+	while (!stack.empty())
 	{
-		// no children
-		return;
-	}
+		Entity const current = stack.back();
+		stack.pop_back();
+
+		if (!all_of<DirtyComponent>(current))
+		{
+			emplace<DirtyComponent>(current);
+		}
 
-	// dirty all children
+		RelationshipComponent const* relationship = try_get<RelationshipComponent>(current);
 
-	// TODO: make iterative
-	Entity child = relationship.first;
+		if (!relationship || !relationship->children)
+		{
+			// no children
+			continue;
+		}
 
-	while (child != NULL_ENTITY)
-	{
-		dirty(child);
+		Entity child = relationship->first;
 
-		RelationshipComponent const& childRelationship = get<RelationshipComponent const>(child);
+		while (child != NULL_ENTITY)
+		{
+			stack.push_back(child);
 
-		child = childRelationship.next;
+			child = get<RelationshipComponent const>(child).next;
+		}
 	}
 }
 
@@ -221,6 +251,80 @@ void Minty::EntityRegistry::fix_sibling_indices(Entity const startEntity, int co
 	}
 }
 
+void Minty::EntityRegistry::mark_hierarchy_dirty()
+{
+	_hierarchyDirty = true;
+	_hierarchyVersion++;
+}
+
+void Minty::EntityRegistry::on_relationship_changed(entt::registry& registry, Entity const entity)
+{
+	mark_hierarchy_dirty();
+}
+
+void Minty::EntityRegistry::on_name_destroyed(entt::registry& registry, Entity const entity)
+{
+	_names.erase(entity);
+}
+
+void Minty::EntityRegistry::on_tag_destroyed(entt::registry& registry, Entity const entity)
+{
+	_tags.erase(entity);
+}
+
+void Minty::EntityRegistry::sort_hierarchy()
+{
+	if (!_hierarchyDirty) return;
+
+	_hierarchyDirty = false;
+
+	auto& relationships = storage<RelationshipComponent>();
+
+	// start from the top of each tree, in Entity order
+	std::vector<Entity> roots;
+	for (auto [entity, relationship] : relationships.each())
+	{
+		if (relationship.parent == NULL_ENTITY)
+		{
+			roots.push_back(entity);
+		}
+	}
+	std::sort(roots.begin(), roots.end());
+
+	// walk each tree depth first, moving each Entity into the next position
+	// this is linear, since each Entity is moved once, without comparing Entities
+	// views iterate the packed array from back to front, so fill it from the back
+	size_t const count = relationships.size();
+	size_t position = 0;
+	std::vector<Entity> stack;
+
+	for (Entity const root : roots)
+	{
+		stack.push_back(root);
+
+		while (!stack.empty())
+		{
+			Entity const entity = stack.back();
+			stack.pop_back();
+
+			Entity const other = relationships.data()[count - 1 - position];
+			if (other != entity)
+			{
+				relationships.swap_elements(other, entity);
+			}
+			position++;
+
+			// add the children in reverse, so the first child is visited first
+			Entity child = relationships.get(entity).last;
+			while (child != NULL_ENTITY)
+			{
+				stack.push_back(child);
+				child = relationships.get(child).prev;
+			}
+		}
+	}
+}
+
 void Minty::EntityRegistry::set_parent(Entity const entity, Entity const parentEntity, uint32_t const insertionIndex)
 {
 	// get or emplace: this entity could not have a relationship
@@ -229,6 +333,8 @@ void Minty::EntityRegistry::set_parent(Entity const entity, Entity const parentE
 	// already the parent
 	if (relationship.parent == parentEntity) return;
 
+	mark_hierarchy_dirty();
+
 	// get old parent if any, remove from children
 	if (relationship.parent != NULL_ENTITY)
 	{
@@ -402,6 +508,8 @@ void Minty::EntityRegistry::swap_siblings(Entity const left, Entity const right)
 	// swapping self
 	if (left == right) return;
 
+	mark_hierarchy_dirty();
+
 	RelationshipComponent& leftR = get<RelationshipComponent>(left);
 	RelationshipComponent& rightR = get<RelationshipComponent>(right);
 
@@ -818,7 +926,8 @@ void Minty::EntityRegistry::clear()
 	_idToEntity.clear();
 	_entityToId.clear();
 
-	// clear tags
+	// clear names and tags
+	_names.clear();
 	_tags.clear();
 }
 
@@ -829,43 +938,32 @@ Entity Minty::EntityRegistry::find_by_name(String const& string) const
 		return NULL_ENTITY;
 	}
 
-	for (auto [entity, name] : this->view<NameComponent const>().each())
-	{
-		if (name.name.compare(string) == 0)
-		{
-			// found entity with same name
-			return entity;
-		}
-	}
-
-	// did not find entity
-	return NULL_ENTITY;
+	return _names.find_first(string);
 }
 
-Entity Minty::EntityRegistry::find_by_tag(String const& tag) const
+std::span<Entity const> Minty::EntityRegistry::find_all_by_name(String const& string) const
 {
-	auto found = _tags.find(tag);
-
-	if (found != _tags.end())
+	if (is_name_empty(string))
 	{
-		return *found->second.begin();
+		return std::span<Entity const>();
 	}
 
-	// no entities with the given tag
-	return NULL_ENTITY;
+	return _names.find(string);
 }
 
-std::unordered_set<Entity> Minty::EntityRegistry::find_all_by_tag(String const& tag) const
+size_t Minty::EntityRegistry::get_name_version() const
 {
-	auto found = _tags.find(tag);
+	return _names.get_version();
+}
 
-	if (found != _tags.end())
-	{
-		return found->second;
-	}
+Entity Minty::EntityRegistry::find_by_tag(String const& tag) const
+{
+	return _tags.find_first(tag);
+}
 
-	// no entities with the given tag
-	return std::unordered_set<Entity>();
+std::span<Entity const> Minty::EntityRegistry::find_all_by_tag(String const& tag) const
+{
+	return _tags.find(tag);
 }
 
 Entity Minty::EntityRegistry::find_by_id(UUID const uuid) const
@@ -941,6 +1039,7 @@ void Minty::EntityRegistry::set_name(Entity const entity, String const& name)
 		// name is occupied
 		NameComponent& nameComponent = get_or_emplace<NameComponent>(entity);
 		nameComponent.name = name;
+		_names.emplace(entity, name);
 	}
 }
 
@@ -959,22 +1058,9 @@ void Minty::EntityRegistry::set_tag(Entity const entity, String const& tag)
 	// check if name is a real name, or empty
 	if (tag.empty())
 	{
-		// name is empty, remove the component if it exists
-		if (TagComponent* tagComponent = try_get<TagComponent>(entity))
+		// name is empty, remove the component if it exists, which removes it from the tags lookup
+		if (any_of<TagComponent>(entity))
 		{
-			// this should be in the tags lookup: if not, somebody meddled with the tag outside of this method
-			MINTY_ASSERT(_tags.contains(tagComponent->tag));
-
-			auto& set = _tags.at(tagComponent->tag);
-			set.erase(entity);
-
-			// if the set is now empty, remove tag from lookup
-			if (set.empty())
-			{
-				_tags.erase(tagComponent->tag);
-			}
-
-			// erase component
 			erase<TagComponent>(entity);
 		}
 	}
@@ -984,68 +1070,76 @@ void Minty::EntityRegistry::set_tag(Entity const entity, String const& tag)
 		TagComponent& tagComponent = get_or_emplace<TagComponent>(entity);
 		tagComponent.tag = tag;
 
-		// add to tags lookup
-		auto found = _tags.find(tag);
-
-		if (found != _tags.end())
-		{
-			// existing
-			found->second.emplace(entity);
-		}
-		else
-		{
-			// new
-			_tags.emplace(tag, std::unordered_set<Entity> { entity });
-		}
+		// add to tags lookup, replacing the old tag
+		_tags.emplace(entity, tag);
 	}
 }
 
+Component* Minty::EntityRegistry::emplace_by_type_id(ComponentTypeID const id, Entity const entity)
+{
+	MINTY_ASSERT(id < _componentFuncs.size());
+
+	return _componentFuncs[id].emplace(*this, entity, _componentNames[id]);
+}
+
+Component* Minty::EntityRegistry::get_by_type_id(ComponentTypeID const id, Entity const entity)
+{
+	MINTY_ASSERT(id < _componentFuncs.size());
+
+	return const_cast<Component*>(_componentFuncs[id].get(*this, entity, _componentNames[id]));
+}
+
+Component const* Minty::EntityRegistry::get_by_type_id(ComponentTypeID const id, Entity const entity) const
+{
+	MINTY_ASSERT(id < _componentFuncs.size());
+
+	return _componentFuncs[id].get(*this, entity, _componentNames[id]);
+}
+
+void Minty::EntityRegistry::erase_by_type_id(ComponentTypeID const id, Entity const entity)
+{
+	MINTY_ASSERT(id < _componentFuncs.size());
+
+	_componentFuncs[id].erase(*this, entity, _componentNames[id]);
+}
+
 Component* Minty::EntityRegistry::emplace_by_name(String const& name, Entity const entity)
 {
-	auto found = _components.find(name);
-	if (found == _components.end())
+	ComponentTypeID id = get_component_type_id(name);
+	if (id == ERROR_COMPONENT_TYPE_ID)
 	{
 		// name not found
 		MINTY_ERROR_FORMAT("Cannot emplace Component \"{}\". It has not been registered with the EntityRegistry.", name);
 		return nullptr;
 	}
-	else
-	{
-		// name found
-		return found->second.emplace(*this, entity, name);
-	}
+
+	return emplace_by_type_id(id, entity);
 }
 
 Component* Minty::EntityRegistry::get_by_name(String const& name, Entity const entity)
 {
-	auto found = _components.find(name);
-	if (found == _components.end())
+	ComponentTypeID id = get_component_type_id(name);
+	if (id == ERROR_COMPONENT_TYPE_ID)
 	{
 		// name not found
 		MINTY_ERROR_FORMAT("Cannot get Component \"{}\". It has not been registered with the EntityRegistry.", name);
 		return nullptr;
 	}
-	else
-	{
-		// name found
-		return const_cast<Component*>(static_cast<Component const*>(found->second.get(*this, entity, name)));
-	}
+
+	return get_by_type_id(id, entity);
 }
 
 Component const* Minty::EntityRegistry::get_by_name(String const& name, Entity const entity) const
 {
-	auto found = _components.find(name);
-	if (found == _components.end())
+	ComponentTypeID id = get_component_type_id(name);
+	if (id == ERROR_COMPONENT_TYPE_ID)
 	{
 		// name not found
 		MINTY_ERROR_FORMAT("Cannot get Component \"{}\". It has not been registered with the EntityRegistry.", name);
 		return nullptr;
 	}
-	else
-	{
-		// name found
-		return found->second.get(*this, entity, name);
-	}
+
+	return get_by_type_id(id, entity);
 }
 
 std::vector<Component const*> Minty::EntityRegistry::get_all(Entity const entity) const
@@ -1060,17 +1154,15 @@ std::vector<Component const*> Minty::EntityRegistry::get_all(Entity const entity
 
 		if (storage.contains(entity))
 		{
-			// this entity has this component type, so get the "pretty" name
-			auto found = _componentTypes.find(ctype.index());
-			if (found == _componentTypes.end())
+			// this entity has this component type, so get the registered type
+			ComponentTypeID id = get_component_type_id(ctype);
+			if (id == ERROR_COMPONENT_TYPE_ID)
 			{
-				MINTY_ERROR_FORMAT("Cannot find_animation component type with id: {}, name: {}", ctype.index(), ctype.name().data());
+				MINTY_ERROR_FORMAT("Cannot find component type with id: {}, name: {}", ctype.index(), ctype.name().data());
 				continue;
 			}
 
-			String name = found->second;
-
-			components.push_back(this->get_by_name(found->second, entity));
+			components.push_back(this->get_by_type_id(id, entity));
 		}
 	}
 
@@ -1079,31 +1171,311 @@ std::vector<Component const*> Minty::EntityRegistry::get_all(Entity const entity
 
 void Minty::EntityRegistry::erase_by_name(String const& name, Entity const entity)
 {
-	auto found = _components.find(name);
-	if (found == _components.end())
+	ComponentTypeID id = get_component_type_id(name);
+	if (id == ERROR_COMPONENT_TYPE_ID)
 	{
 		// name not found
 		MINTY_ERROR_FORMAT("Cannot erase Component \"{}\". It has not been registered with the EntityRegistry.", name);
+		return;
 	}
-	else
+
+	erase_by_type_id(id, entity);
+}
+
+Entity Minty::EntityRegistry::clone(Entity const entity)
+{
+	std::vector<std::pair<entt::sparse_set const*, ComponentFuncs const*>> components = get_copyable_components();
+	ScriptEngine& scriptEngine = ScriptEngine::instance();
+
+	// walk the tree depth first, so each parent is cloned before its children, and siblings stay in order
+	// pairs of the original Entity and the clone of its parent
+	std::vector<std::pair<Entity, Entity>> stack;
+	stack.push_back({ entity, get_parent(entity) });
+
+	Entity result = NULL_ENTITY;
+
+	while (!stack.empty())
+	{
+		auto const [original, parent] = stack.back();
+		stack.pop_back();
+
+		UUID id = UUID::create();
+		Entity copy = create(get_name(original), id);
+		scriptEngine.create_object_entity(id);
+
+		if (result == NULL_ENTITY)
+		{
+			result = copy;
+		}
+
+		// copy each component directly
+		for (auto const [storage, funcs] : components)
+		{
+			if (storage->contains(original))
+			{
+				funcs->copy(*this, copy, *funcs->get(*this, original, String()));
+			}
+		}
+
+		// the copied sound is not playing yet
+		if (AudioSourceComponent* source = try_get<AudioSourceComponent>(copy))
+		{
+			source->handle = ERROR_AUDIO_HANDLE;
+		}
+
+		// the copied tag was not set through set_tag
+		if (TagComponent const* tag = try_get<TagComponent>(copy))
+		{
+			_tags.emplace(copy, tag->tag);
+		}
+
+		if (parent != NULL_ENTITY)
+		{
+			set_parent(copy, parent);
+		}
+
+		// scripts are created through the script engine, then their values are copied over
+		if (ScriptComponent const* scriptComponent = try_get<ScriptComponent>(original))
+		{
+			for (auto const& [scriptId, scriptObject] : scriptComponent->scripts)
+			{
+				if (ScriptObject* copyObject = static_cast<ScriptObject*>(emplace_by_type_id(scriptObject.get_class().get_component_type_id(), copy)))
+				{
+					copyObject->copy_fields(scriptObject);
+				}
+			}
+		}
+
+		// add the children in reverse, so the first child is cloned first
+		if (RelationshipComponent const* relationship = try_get<RelationshipComponent>(original))
+		{
+			Entity child = relationship->last;
+
+			while (child != NULL_ENTITY)
+			{
+				stack.push_back({ child, copy });
+				child = get<RelationshipComponent const>(child).prev;
+			}
+		}
+	}
+
+	return result;
+}
+
+std::vector<Entity> Minty::EntityRegistry::instantiate(Prefab& prefab, size_t const count, Entity const parent)
+{
+	if (!prefab._compiled)
+	{
+		compile(prefab);
+	}
+
+	std::vector<Entity> result;
+	result.reserve(count);
+
+	ScriptEngine& scriptEngine = ScriptEngine::instance();
+	std::vector<Entity> entities(prefab._entities.size(), NULL_ENTITY);
+
+	// generate the IDs for every copy at once
+	std::vector<UUID> ids(count * prefab._entities.size());
+	UUID::create_many(ids);
+
+	for (size_t i = 0; i < count; i++)
 	{
-		// name found
-		found->second.erase(*this, entity, name);
+		// create each Entity, parents first
+		for (size_t j = 0; j < prefab._entities.size(); j++)
+		{
+			Prefab::PrefabEntity const& prefabEntity = prefab._entities.at(j);
+
+			UUID id = ids.at(i * prefab._entities.size() + j);
+			Entity entity = create(prefabEntity.name, id);
+			scriptEngine.create_object_entity(id);
+			entities[j] = entity;
+
+			for (Prefab::PrefabComponent const& component : prefabEntity.components)
+			{
+				component.copy(*this, entity, *component.value);
+			}
+
+			if (TagComponent const* tag = try_get<TagComponent>(entity))
+			{
+				_tags.emplace(entity, tag->tag);
+			}
+
+			if (prefabEntity.parent != Prefab::NO_PARENT)
+			{
+				set_parent(entity, entities.at(prefabEntity.parent));
+			}
+			else
+			{
+				if (parent != NULL_ENTITY)
+				{
+					set_parent(entity, parent);
+				}
+
+				result.push_back(entity);
+			}
+		}
+
+		// add the scripts once the Entities and their relationships exist
+		for (size_t j = 0; j < prefab._entities.size(); j++)
+		{
+			Prefab::PrefabEntity const& prefabEntity = prefab._entities.at(j);
+
+			if (!prefabEntity.scripts.has_children()) continue;
+
+			SerializationData data
+			{
+				.scene = &get_scene(),
+				.entity = entities.at(j),
+			};
+			Component* component = emplace_by_name(prefabEntity.scripts.get_name(), entities.at(j));
+			Reader reader(prefabEntity.scripts, &data);
+			component->deserialize(reader);
+		}
 	}
+
+	return result;
 }
 
-Entity Minty::EntityRegistry::clone(Entity const entity)
+void Minty::EntityRegistry::compile(Prefab& prefab)
+{
+	std::vector<Node> const& entityNodes = prefab._node.get_children();
+	size_t const count = entityNodes.size();
+
+	// find the index of each Entity, so the parents can be found by UUID
+	std::unordered_map<UUID, size_t> indices;
+	std::vector<String> names(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		UUID id;
+		read_entity_node(entityNodes.at(i), names[i], id);
+		indices.emplace(id, i);
+	}
+
+	// read each Entity once, into a temporary Entity, then keep copies of its components
+	std::vector<Prefab::PrefabEntity> entities(count);
+	std::vector<size_t> depths(count, 0);
+	for (size_t i = 0; i < count; i++)
+	{
+		Node const& entityNode = entityNodes.at(i);
+		Prefab::PrefabEntity& prefabEntity = entities.at(i);
+		prefabEntity.name = names.at(i);
+		prefabEntity.parent = Prefab::NO_PARENT;
+
+		Entity entity = create();
+
+		SerializationData data
+		{
+			.scene = &get_scene(),
+			.entity = entity
+		};
+
+		for (Node const& compNode : entityNode.get_children())
+		{
+			String const& name = compNode.get_name();
+			Reader compReader(compNode, &data);
+
+			if (name == "Relationship")
+			{
+				// parent within the Prefab, otherwise a root
+				UUID parentId(INVALID_UUID);
+				if (compReader.try_read_uuid("parent", parentId))
+				{
+					auto found = indices.find(parentId);
+					if (found != indices.end())
+					{
+						prefabEntity.parent = found->second;
+					}
+				}
+				continue;
+			}
+			else if (name == "Script")
+			{
+				prefabEntity.scripts = compNode;
+				continue;
+			}
+
+			ComponentTypeID id = get_component_type_id(name);
+			if (id == ERROR_COMPONENT_TYPE_ID || !_componentFuncs[id].duplicate)
+			{
+				MINTY_ERROR_FORMAT("Cannot compile component \"{}\" within Prefab \"{}\".", name, prefab.get_path().generic_string());
+				continue;
+			}
+
+			ComponentFuncs const& funcs = _componentFuncs[id];
+			Component* component = funcs.emplace(*this, entity, name);
+			component->deserialize(compReader);
+
+			prefabEntity.components.push_back(Prefab::PrefabComponent
+				{
+					.copy = funcs.copy,
+					.value = funcs.duplicate(*component),
+				});
+		}
+
+		destroy_immediate(entity, false);
+	}
+
+	// find the depth of each Entity, so the parents can be created first
+	for (size_t i = 0; i < count; i++)
+	{
+		size_t depth = 0;
+		for (size_t j = entities.at(i).parent; j != Prefab::NO_PARENT && depth <= count; j = entities.at(j).parent)
+		{
+			depth++;
+		}
+
+		MINTY_ASSERT_FORMAT(depth <= count, "Prefab \"{}\" has a cycle in its hierarchy.", prefab.get_path().generic_string());
+		depths[i] = depth;
+	}
+
+	// order by depth, keeping the order of siblings
+	std::vector<size_t> order(count);
+	for (size_t i = 0; i < count; i++) order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&depths](size_t const left, size_t const right) { return depths[left] < depths[right]; });
+
+	std::vector<size_t> positions(count);
+	for (size_t i = 0; i < count; i++) positions[order[i]] = i;
+
+	prefab._entities.clear();
+	prefab._entities.reserve(count);
+	for (size_t const index : order)
+	{
+		Prefab::PrefabEntity& prefabEntity = entities.at(index);
+		if (prefabEntity.parent != Prefab::NO_PARENT)
+		{
+			prefabEntity.parent = positions.at(prefabEntity.parent);
+		}
+		prefab._entities.push_back(std::move(prefabEntity));
+	}
+
+	prefab._compiled = true;
+}
+
+std::vector<std::pair<entt::sparse_set const*, EntityRegistry::ComponentFuncs const*>> Minty::EntityRegistry::get_copyable_components() const
 {
-	// serialize entity
-	Node data = serialize_entity(entity);
+	std::vector<std::pair<entt::sparse_set const*, ComponentFuncs const*>> result;
+
+	for (auto&& [id, storage] : this->storage())
+	{
+		auto const& ctype = storage.type();
 
-	// change its id
-	data.set_data(to_string(UUID()));
+		// names are set when the Entity is created, relationships are set as the Entities are created, and scripts are copied through the script engine
+		if (ctype == entt::type_id<NameComponent>() || ctype == entt::type_id<RelationshipComponent>() || ctype == entt::type_id<ScriptComponent>())
+		{
+			continue;
+		}
+
+		ComponentTypeID typeId = get_component_type_id(ctype);
+		if (typeId == ERROR_COMPONENT_TYPE_ID || !_componentFuncs[typeId].copy)
+		{
+			continue;
+		}
 
-	// deserialize
-	Entity clone = deserialize_entity(data);
+		result.push_back({ &storage, &_componentFuncs[typeId] });
+	}
 
-	return clone;
+	return result;
 }
 
 void Minty::EntityRegistry::print(Entity const entity) const
@@ -1185,7 +1557,7 @@ std::vector<Entity> Minty::EntityRegistry::get_dependents(Ref<Asset> const asset
 
 void Minty::EntityRegistry::register_script(String const& name)
 {
-	if (_components.contains(name))
+	if (_componentIds.contains(name))
 	{
 		MINTY_INFO_FORMAT("Script {} already registered.", name);
 		return;
@@ -1222,13 +1594,13 @@ void Minty::EntityRegistry::register_script(String const& name)
 			MINTY_ASSERT_FORMAT(script != nullptr, "No script with name {} found.", name);
 
 			// add a script object to it
-			ID id = component->scripts.emplace(name, engine.create_object_component(UUID(), registry.get_id(entity), *script));
+			ID id = component->scripts.emplace(name, engine.create_object_component(UUID::create(), registry.get_id(entity), *script));
 			ScriptObject& scriptObject = component->scripts.at(id);
 
 			if (Application::instance().get_mode() == ApplicationMode::Normal)
 			{
 				// call OnCreate
-				scriptObject.try_invoke(SCRIPT_METHOD_NAME_ONCREATE);
+				scriptObject.try_invoke(ScriptMethod::OnCreate);
 
 				// call load and enable right now if the scene is already loaded, otherwise do it later
 				if (registry.get_scene().is_loaded())
@@ -1237,19 +1609,20 @@ void Minty::EntityRegistry::register_script(String const& name)
 				}
 
 				// now add the helper components, if they are needed
-				registry.connect_event<ScriptOnLoadComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONLOAD);
-				registry.connect_event<ScriptOnEnableComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONENABLE);
-				registry.connect_event<ScriptOnUpdateComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONUPDATE);
-				registry.connect_event<ScriptOnDisableComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONDISABLE);
-				registry.connect_event<ScriptOnUnloadComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONUNLOAD);
-				registry.connect_event<ScriptOnDestroyComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONDESTROY);
-				registry.connect_event<ScriptOnPointerEnterComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONPOINTERENTER);
-				registry.connect_event<ScriptOnPointerHoverComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONPOINTERHOVER);
-				registry.connect_event<ScriptOnPointerExitComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONPOINTEREXIT);
-				registry.connect_event<ScriptOnPointerMoveComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONPOINTERMOVE);
-				registry.connect_event<ScriptOnPointerDownComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONPOINTERDOWN);
-				registry.connect_event<ScriptOnPointerUpComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONPOINTERUP);
-				registry.connect_event<ScriptOnPointerClickComponent>(entity, id, scriptObject, SCRIPT_METHOD_NAME_ONPOINTERCLICK);
+				registry.connect_event<ScriptOnLoadComponent>(entity, id, scriptObject, ScriptMethod::OnLoad);
+				registry.connect_event<ScriptOnEnableComponent>(entity, id, scriptObject, ScriptMethod::OnEnable);
+				registry.connect_event<ScriptOnUpdateComponent>(entity, id, scriptObject, ScriptMethod::OnUpdate);
+				registry.connect_event<ScriptOnFixedUpdateComponent>(entity, id, scriptObject, ScriptMethod::OnFixedUpdate);
+				registry.connect_event<ScriptOnDisableComponent>(entity, id, scriptObject, ScriptMethod::OnDisable);
+				registry.connect_event<ScriptOnUnloadComponent>(entity, id, scriptObject, ScriptMethod::OnUnload);
+				registry.connect_event<ScriptOnDestroyComponent>(entity, id, scriptObject, ScriptMethod::OnDestroy);
+				registry.connect_event<ScriptOnPointerEnterComponent>(entity, id, scriptObject, ScriptMethod::OnPointerEnter);
+				registry.connect_event<ScriptOnPointerHoverComponent>(entity, id, scriptObject, ScriptMethod::OnPointerHover);
+				registry.connect_event<ScriptOnPointerExitComponent>(entity, id, scriptObject, ScriptMethod::OnPointerExit);
+				registry.connect_event<ScriptOnPointerMoveComponent>(entity, id, scriptObject, ScriptMethod::OnPointerMove);
+				registry.connect_event<ScriptOnPointerDownComponent>(entity, id, scriptObject, ScriptMethod::OnPointerDown);
+				registry.connect_event<ScriptOnPointerUpComponent>(entity, id, scriptObject, ScriptMethod::OnPointerUp);
+				registry.connect_event<ScriptOnPointerClickComponent>(entity, id, scriptObject, ScriptMethod::OnPointerClick);
 			}
 
 			// return the script object
@@ -1293,6 +1666,7 @@ void Minty::EntityRegistry::register_script(String const& name)
 			if (ScriptOnLoadComponent* eventComp = registry.try_get<ScriptOnLoadComponent>(entity)) eventComp->scriptIds.erase(id);
 			if (ScriptOnEnableComponent* eventComp = registry.try_get<ScriptOnEnableComponent>(entity)) eventComp->scriptIds.erase(id);
 			if (ScriptOnUpdateComponent* eventComp = registry.try_get<ScriptOnUpdateComponent>(entity)) eventComp->scriptIds.erase(id);
+			if (ScriptOnFixedUpdateComponent* eventComp = registry.try_get<ScriptOnFixedUpdateComponent>(entity)) eventComp->scriptIds.erase(id);
 			if (ScriptOnDisableComponent* eventComp = registry.try_get<ScriptOnDisableComponent>(entity)) eventComp->scriptIds.erase(id);
 			if (ScriptOnUnloadComponent* eventComp = registry.try_get<ScriptOnUnloadComponent>(entity)) eventComp->scriptIds.erase(id);
 			if (ScriptOnDestroyComponent* eventComp = registry.try_get<ScriptOnDestroyComponent>(entity)) eventComp->scriptIds.erase(id);
@@ -1311,7 +1685,7 @@ void Minty::EntityRegistry::register_script(String const& name)
 			scripts.destroy_object(component->id);
 		},
 	};
-	_components.emplace(name, funcs);
+	add_component_type(name, funcs);
 
 	MINTY_INFO_FORMAT("Registered script {}.", name);
 }
@@ -1319,9 +1693,9 @@ void Minty::EntityRegistry::register_script(String const& name)
 std::vector<String> Minty::EntityRegistry::get_registered_components()
 {
 	std::vector<String> result;
-	result.reserve(_components.size());
+	result.reserve(_componentIds.size());
 
-	for (auto const& pair : _components)
+	for (auto const& pair : _componentIds)
 	{
 		result.push_back(pair.first);
 	}
@@ -1329,6 +1703,45 @@ std::vector<String> Minty::EntityRegistry::get_registered_components()
 	return result;
 }
 
+ComponentTypeID Minty::EntityRegistry::get_component_type_id(String const& name)
+{
+	auto found = _componentIds.find(name);
+	if (found == _componentIds.end())
+	{
+		return ERROR_COMPONENT_TYPE_ID;
+	}
+
+	return found->second;
+}
+
+String const& Minty::EntityRegistry::get_component_type_name(ComponentTypeID const id)
+{
+	MINTY_ASSERT(id < _componentNames.size());
+
+	return _componentNames[id];
+}
+
+ComponentTypeID Minty::EntityRegistry::add_component_type(String const& name, ComponentFuncs const& funcs)
+{
+	ComponentTypeID id = static_cast<ComponentTypeID>(_componentFuncs.size());
+
+	_componentFuncs.push_back(funcs);
+	_componentNames.push_back(name);
+	_componentIds.emplace(name, id);
+
+	return id;
+}
+
+ComponentTypeID Minty::EntityRegistry::get_component_type_id(entt::type_info const& info)
+{
+	if (info.index() >= _componentTypes.size())
+	{
+		return ERROR_COMPONENT_TYPE_ID;
+	}
+
+	return _componentTypes[info.index()];
+}
+
 void Minty::EntityRegistry::serialize(Writer& writer) const
 {
 	// write each entity, and each component under it
@@ -1348,7 +1761,7 @@ void Minty::EntityRegistry::serialize(Writer& writer) const
 		entityId = get_id(entity);
 
 		// if id is empty, generate one
-		if (!entityId) entityId = UUID();
+		if (!entityId) entityId = UUID::create();
 
 		// if no name, just print ID
 		if (entityName.empty())
@@ -1387,7 +1800,7 @@ void Minty::EntityRegistry::serialize(Writer& writer) const
 		entityId = get_id(entity);
 
 		// if id is empty, generate one
-		if (!entityId) entityId = UUID();
+		if (!entityId) entityId = UUID::create();
 
 		// if no name, just print ID
 		if (entityName.empty())
@@ -1432,32 +1845,8 @@ void Minty::EntityRegistry::deserialize(Reader const& reader)
 Entity Minty::EntityRegistry::deserialize_entity(Node const& entityNode)
 {
 	String name;
-	String value;
 	UUID id;
-
-	// get the name and ID from the node
-	if (entityNode.has_data())
-	{
-		name = entityNode.get_name();
-		value = entityNode.get_data();
-	}
-	else
-	{
-		// no data, so the "name" must be the ID, and there is no name
-		name = "";
-		value = entityNode.get_name();
-	}
-
-	// convert value to ID, or generate a new one if needed
-	if (!Parse::try_uuid(value, id))
-	{
-		// the value must be the name instead
-		name = value;
-		value = "";
-
-		// generate a new ID
-		id = UUID();
-	}
+	read_entity_node(entityNode, name, id);
 
 	// create entity in registry
 	Entity entity = create(name, id);
@@ -1489,6 +1878,12 @@ Entity Minty::EntityRegistry::deserialize_entity(Node const& entityNode)
 		comp->deserialize(compReader);
 	}
 
+	// the deserialized tag was not set through set_tag
+	if (TagComponent const* tag = try_get<TagComponent>(entity))
+	{
+		_tags.emplace(entity, tag->tag);
+	}
+
 	return entity;
 }
 
@@ -1497,6 +1892,34 @@ bool Minty::EntityRegistry::is_name_empty(String const& name)
 	return name.size() == 0 || (name.size() == 1 && name.at(0) == '_');
 }
 
+void Minty::EntityRegistry::read_entity_node(Node const& entityNode, String& name, UUID& id)
+{
+	String value;
+
+	// get the name and ID from the node
+	if (entityNode.has_data())
+	{
+		name = entityNode.get_name();
+		value = entityNode.get_data();
+	}
+	else
+	{
+		// no data, so the "name" must be the ID, and there is no name
+		name = "";
+		value = entityNode.get_name();
+	}
+
+	// convert value to ID, or generate a new one if needed
+	if (!Parse::try_uuid(value, id))
+	{
+		// the value must be the name instead
+		name = value;
+
+		// generate a new ID
+		id = UUID::create();
+	}
+}
+
 void Minty::EntityRegistry::add_to_lookup(Entity const entity, UUID const id)
 {
 	_idToEntity.emplace(id, entity);
@@ -1524,8 +1947,8 @@ void Minty::EntityRegistry::serialize_entity(Writer& writer, Entity const entity
 		if (storage.contains(entity))
 		{
 			// this entity has this component type, so get the "pretty" name
-			auto found = _componentTypes.find(ctype.index());
-			if (found == _componentTypes.end())
+			ComponentTypeID id = get_component_type_id(ctype);
+			if (id == ERROR_COMPONENT_TYPE_ID)
 			{
 				continue;
 			}
@@ -1535,10 +1958,8 @@ void Minty::EntityRegistry::serialize_entity(Writer& writer, Entity const entity
 				continue;
 			}
 
-			String name = found->second;
-
 			// write component with its name and serialized values
-			tempWriter.write(name, this->get_by_name(name, entity));
+			tempWriter.write(_componentNames[id], this->get_by_type_id(id, entity));
 		}
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "Minty/Scenes/M_SceneObject.h"
 #include "Minty/Entities/M_Entity.h"
+#include "Minty/Entities/M_EntityIndex.h"
 
 #include "Minty/Types/M_UUID.h"
 #include "Minty/Types/M_Object.h"
@@ -8,6 +9,8 @@
 #include "Minty/Scripting/M_ScriptClass.h"
 #include "Minty/Scripting/M_ScriptObject.h"
 #include <map>
+#include <memory>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -16,6 +19,8 @@ namespace Minty
 	struct Component;
 	struct ScriptComponent;
 	class Asset;
+	class Prefab;
+	class Node;
 
 	class EntityRegistry
 		: public SceneObject, public entt::registry
@@ -24,6 +29,8 @@ namespace Minty
 		typedef std::function<Component* (EntityRegistry&, Entity const, String const&)> ComponentEmplaceFunc;
 		typedef std::function<Component const* (EntityRegistry const&, Entity const, String const&)> ComponentGetFunc;
 		typedef std::function<void(EntityRegistry&, Entity const, String const&)> ComponentEraseFunc;
+		typedef std::function<Component* (EntityRegistry&, Entity const, Component const&)> ComponentCopyFunc;
+		typedef std::function<std::shared_ptr<Component const> (Component const&)> ComponentDuplicateFunc;
 
 	private:
 		struct ComponentFuncs
@@ -31,15 +38,31 @@ namespace Minty
 			ComponentEmplaceFunc emplace;
 			ComponentGetFunc get;
 			ComponentEraseFunc erase;
+			// emplaces a copy of the given Component, without going through serialization
+			ComponentCopyFunc copy;
+			// copies the given Component, so it can be kept outside of a registry
+			ComponentDuplicateFunc duplicate;
 		};
 
-		static std::map<String const, ComponentFuncs const> _components; // name -> creation/get funcs
-		static std::map<uint32_t const, String const> _componentTypes; // type id index -> name
+		static std::vector<ComponentFuncs> _componentFuncs; // component type id -> creation/get funcs
+		static std::vector<String> _componentNames; // component type id -> name
+		static std::map<String const, ComponentTypeID const> _componentIds; // name -> component type id
+		static std::vector<ComponentTypeID> _componentTypes; // entt type id index -> component type id
 
 		std::unordered_map<UUID, Entity> _idToEntity;
 		std::unordered_map<Entity, UUID> _entityToId;
 
-		std::unordered_map<String, std::unordered_set<Entity>> _tags;
+		// the Entities by their name, and by their tag
+		EntityIndex _names;
+		EntityIndex _tags;
+
+		// true when the RelationshipComponents are not in depth first order
+		bool _hierarchyDirty;
+		// incremented whenever the hierarchy changes, so others can tell when to rebuild what they derived from it
+		uint64_t _hierarchyVersion;
+
+		// unique to this EntityRegistry, so cached Entities can be checked that they came from this EntityRegistry
+		uint32_t _generation;
 	public:
 		EntityRegistry(Scene& scene);
 
@@ -87,9 +110,53 @@ namespace Minty
 
 		void dirty(Entity const entity);
 
+		/// <summary>
+		/// Marks the given Entities, and all of their children, as dirty.
+		/// </summary>
+		/// <param name="entities">The Entities to mark as dirty.</param>
+		void dirty(std::span<Entity const> const entities);
+
 	private:
 		void fix_sibling_indices(Entity const startEntity, int const startIndex);
 
+		// marks the hierarchy as changed
+		void mark_hierarchy_dirty();
+
+		// called when a RelationshipComponent is added or removed
+		void on_relationship_changed(entt::registry& registry, Entity const entity);
+
+		// called when a NameComponent is removed
+		void on_name_destroyed(entt::registry& registry, Entity const entity);
+
+		// called when a TagComponent is removed
+		void on_tag_destroyed(entt::registry& registry, Entity const entity);
+
+	public:
+		/// <summary>
+		/// Orders the RelationshipComponents depth first, so parents always come before their children, and siblings are in order.
+		/// Does nothing if the hierarchy has not changed since it was last sorted.
+		/// </summary>
+		void sort_hierarchy();
+
+		/// <summary>
+		/// Checks if the hierarchy has changed since it was last sorted.
+		/// </summary>
+		/// <returns></returns>
+		bool is_hierarchy_dirty() const { return _hierarchyDirty; }
+
+		/// <summary>
+		/// Gets the version of the hierarchy, which changes whenever an Entity is parented, unparented or reordered.
+		/// </summary>
+		/// <returns></returns>
+		uint64_t get_hierarchy_version() const { return _hierarchyVersion; }
+
+		/// <summary>
+		/// Gets the generation of this EntityRegistry, which is unique to each EntityRegistry, and never 0.
+		/// An Entity cached along with the generation can be used again if the generation matches and the Entity is still valid.
+		/// </summary>
+		/// <returns></returns>
+		uint32_t get_generation() const { return _generation; }
+
 	public:
 		void set_parent(Entity const entity, Entity const parentEntity, uint32_t const insertionIndex = -1);
 
@@ -192,6 +259,20 @@ namespace Minty
 		/// <returns>The Entity, or NULL_ENTITY if not found.</returns>
 		Entity find_by_name(String const& string) const;
 
+		/// <summary>
+		/// Finds all of the Entities with the given name.
+		/// </summary>
+		/// <param name="string"></param>
+		/// <returns>A view of the Entities, which is valid until an Entity's name is changed, or an Entity is destroyed.</returns>
+		std::span<Entity const> find_all_by_name(String const& string) const;
+
+		/// <summary>
+		/// Gets a number that changes each time an Entity is named, renamed, or loses its name, which includes being destroyed.
+		/// If it has not changed, then find_by_name will give the same results as before.
+		/// </summary>
+		/// <returns></returns>
+		size_t get_name_version() const;
+
 		/// <summary>
 		/// Finds the first Entity with the given tag.
 		/// </summary>
@@ -203,8 +284,8 @@ namespace Minty
 		/// Finds all of the Entities with the given tag.
 		/// </summary>
 		/// <param name="tag"></param>
-		/// <returns></returns>
-		std::unordered_set<Entity> find_all_by_tag(String const& tag) const;
+		/// <returns>A view of the Entities, which is valid until an Entity's tag is changed, or an Entity is destroyed.</returns>
+		std::span<Entity const> find_all_by_tag(String const& tag) const;
 
 		/// <summary>
 		/// Finds the Entity with the given UUID.
@@ -259,6 +340,37 @@ namespace Minty
 		/// <returns>The ID of the Entity, or 0 if no ID was found.</returns>
 		UUID get_id(Entity const entity) const;
 
+		/// <summary>
+		/// Emplaces the Component onto the entity, by its type ID.
+		/// </summary>
+		/// <param name="id">The ID of the Component type.</param>
+		/// <param name="entity">The Entity to set the Component onto.</param>
+		/// <returns>A pointer to the newly emplaced Component, or null if an error occured.</returns>
+		Component* emplace_by_type_id(ComponentTypeID const id, Entity const entity);
+
+		/// <summary>
+		/// Gets the Component, by its type ID.
+		/// </summary>
+		/// <param name="id">The ID of the Component type.</param>
+		/// <param name="entity">The Entity that has the Component.</param>
+		/// <returns>The Component, or null if it does not exist.</returns>
+		Component* get_by_type_id(ComponentTypeID const id, Entity const entity);
+
+		/// <summary>
+		/// Gets the Component, by its type ID.
+		/// </summary>
+		/// <param name="id">The ID of the Component type.</param>
+		/// <param name="entity">The Entity that has the Component.</param>
+		/// <returns>The Component, or null if it does not exist.</returns>
+		Component const* get_by_type_id(ComponentTypeID const id, Entity const entity) const;
+
+		/// <summary>
+		/// Erases the Component, by its type ID.
+		/// </summary>
+		/// <param name="id">The ID of the Component type.</param>
+		/// <param name="entity">The Entity that has the Component.</param>
+		void erase_by_type_id(ComponentTypeID const id, Entity const entity);
+
 		/// <summary>
 		/// Emplaces the Component onto the entity, by name.
 		/// </summary>
@@ -298,12 +410,32 @@ namespace Minty
 		void erase_by_name(String const& name, Entity const entity);
 
 		/// <summary>
-		/// Clones the given Entity and its components, and returns the new Entity.
+		/// Clones the given Entity, its components and its children, and returns the new Entity.
+		/// The components are copied directly, and the clone is given the same parent as the given Entity.
 		/// </summary>
 		/// <param name="entity">The Entity to clone.</param>
 		/// <returns>The cloned Entity.</returns>
 		Entity clone(Entity const entity);
 
+		/// <summary>
+		/// Creates copies of the Entities within the given Prefab.
+		/// The Prefab is compiled the first time it is instantiated, so each copy after that does not read any serialized data, other than for Scripts.
+		/// </summary>
+		/// <param name="prefab">The Prefab to instantiate.</param>
+		/// <param name="count">The number of copies to create.</param>
+		/// <param name="parent">The parent of the root Entities in each copy, if any.</param>
+		/// <returns>The root Entities of each copy, in order.</returns>
+		std::vector<Entity> instantiate(Prefab& prefab, size_t const count = 1, Entity const parent = NULL_ENTITY);
+
+	private:
+		// reads the Entities within the Prefab into copyable components
+		void compile(Prefab& prefab);
+
+		// gets the registered components that can be copied, by storage
+		std::vector<std::pair<entt::sparse_set const*, ComponentFuncs const*>> get_copyable_components() const;
+
+	public:
+
 		/// <summary>
 		/// Prints an Entity's values to the screen.
 		/// </summary>
@@ -329,7 +461,7 @@ namespace Minty
 		/// <param name="trigger"></param>
 		/// <returns></returns>
 		template<class ScriptEvent>
-		bool connect_event(Entity const entity, ID const id, ScriptObject& scriptObject, String const& name, bool const trigger = false);
+		bool connect_event(Entity const entity, ID const id, ScriptObject& scriptObject, ScriptMethod const method, bool const trigger = false);
 
 		/// <summary>
 		/// Triggers the event tied to the given type. Returns true when the event was successfully triggered.
@@ -360,6 +492,27 @@ namespace Minty
 		/// <returns></returns>
 		static std::vector<String> get_registered_components();
 
+		/// <summary>
+		/// Gets the type ID of the Component/Script with the given name.
+		/// </summary>
+		/// <param name="name">The name of the Component/Script.</param>
+		/// <returns>The type ID, or ERROR_COMPONENT_TYPE_ID if it has not been registered.</returns>
+		static ComponentTypeID get_component_type_id(String const& name);
+
+		/// <summary>
+		/// Gets the name of the Component/Script with the given type ID.
+		/// </summary>
+		/// <param name="id">The type ID of the Component/Script.</param>
+		/// <returns>The name of the Component/Script.</returns>
+		static String const& get_component_type_name(ComponentTypeID const id);
+
+	private:
+		// adds the funcs for a newly registered Component/Script, and returns its type ID
+		static ComponentTypeID add_component_type(String const& name, ComponentFuncs const& funcs);
+
+		// gets the type ID of the registered Component with the given entt type, or ERROR_COMPONENT_TYPE_ID if it has not been registered
+		static ComponentTypeID get_component_type_id(entt::type_info const& info);
+
 	public:
 		void serialize(Writer& writer) const override;
 		void serialize_entity(Writer& writer, Entity const entity) const;
@@ -370,6 +523,9 @@ namespace Minty
 		static bool is_name_empty(String const& name);
 
 	private:
+		// gets the name and UUID of the Entity from its Node
+		static void read_entity_node(Node const& entityNode, String& name, UUID& id);
+
 		void add_to_lookup(Entity const entity, UUID const id);
 		void remove_from_lookup(Entity const entity);
 	};
@@ -389,16 +545,16 @@ namespace Minty
 	}
 
 	template<class ScriptEvent>
-	bool EntityRegistry::connect_event(Entity const entity, ID const id, ScriptObject& scriptObject, String const& name, bool const trigger)
+	bool EntityRegistry::connect_event(Entity const entity, ID const id, ScriptObject& scriptObject, ScriptMethod const method, bool const trigger)
 	{
-		if (scriptObject.get_class().has_method(name))
+		if (scriptObject.get_class().has_method(method))
 		{
 			ScriptEvent& eventComp = get_or_emplace<ScriptEvent>(entity);
 			eventComp.scriptIds.emplace(id);
 
 			if (trigger)
 			{
-				scriptObject.invoke(name);
+				scriptObject.invoke(method);
 			}
 
 			return true;
@@ -423,7 +579,7 @@ namespace Minty
 	template<class T>
 	void EntityRegistry::register_component(String const& name)
 	{
-		if (_components.contains(name))
+		if (_componentIds.contains(name))
 		{
 			MINTY_INFO_FORMAT("Component {} already registered.", name);
 			return;
@@ -434,13 +590,30 @@ namespace Minty
 			.emplace = [](EntityRegistry& registry, Entity const entity, String const& name) -> Component* { return &registry.emplace<T>(entity); },
 			.get = [](EntityRegistry const& registry, Entity const entity, String const& name) -> Component const* { return registry.try_get<T>(entity); },
 			.erase = [](EntityRegistry& registry, Entity const entity, String const& name) -> void { registry.erase<T>(entity); },
+			.copy = [](EntityRegistry& registry, Entity const entity, Component const& value) -> Component*
+			{
+				T& component = registry.emplace_or_replace<T>(entity, static_cast<T const&>(value));
+
+				// the copy needs its own script object
+				if constexpr (std::is_base_of_v<ScriptObjectComponent, T>)
+				{
+					component.id = UUID::create();
+				}
+
+				return &component;
+			},
+			.duplicate = [](Component const& value) -> std::shared_ptr<Component const> { return std::make_shared<T>(static_cast<T const&>(value)); },
 		};
-		_components.emplace(name, funcs);
+		ComponentTypeID id = add_component_type(name, funcs);
 
 		entt::type_info info = entt::type_id<T>();
 
-		// type names
-		_componentTypes.emplace(info.index(), name);
+		// type ids, so the registered type can be found from the storage
+		if (_componentTypes.size() <= info.index())
+		{
+			_componentTypes.resize(static_cast<size_t>(info.index()) + 1, ERROR_COMPONENT_TYPE_ID);
+		}
+		_componentTypes[info.index()] = id;
 
 		MINTY_INFO_FORMAT("Registered component {}.", name);
 	}
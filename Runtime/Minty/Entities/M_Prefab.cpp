@@ -0,0 +1,18 @@
+#include "pch.h"
+#include "Minty/Entities/M_Prefab.h"
+
+using namespace Minty;
+
+Minty::Prefab::Prefab()
+	: Asset()
+	, _node()
+	, _entities()
+	, _compiled()
+{}
+
+Minty::Prefab::Prefab(PrefabBuilder const& builder)
+	: Asset(builder.id, builder.path)
+	, _node(builder.node)
+	, _entities()
+	, _compiled()
+{}
@@ -0,0 +1,90 @@
+#pragma once
+#include "Minty/Assets/M_Asset.h"
+
+#include "Minty/Entities/M_EntityRegistry.h"
+#include "Minty/Types/M_Node.h"
+#include <memory>
+#include <vector>
+
+namespace Minty
+{
+	/// <summary>
+	/// Holds data to create a new Prefab.
+	/// </summary>
+	struct PrefabBuilder
+	{
+		UUID id;
+
+		Path path;
+
+		/// <summary>
+		/// The serialized Entities, in the same format as the Entities within a Scene.
+		/// </summary>
+		Node node;
+	};
+
+	/// <summary>
+	/// A group of Entities that can be instantiated many times within an EntityRegistry.
+	/// 
+	/// The Entities are read once, the first time the Prefab is instantiated, and kept as components that are copied directly into each instance.
+	/// </summary>
+	class Prefab
+		: public Asset
+	{
+		friend class EntityRegistry;
+
+	private:
+		struct PrefabComponent
+		{
+			// emplaces a copy of the value onto an Entity
+			EntityRegistry::ComponentCopyFunc copy;
+
+			// the compiled Component
+			std::shared_ptr<Component const> value;
+		};
+
+		struct PrefabEntity
+		{
+			String name;
+
+			// the index of the parent within the Prefab, or NO_PARENT
+			size_t parent;
+
+			std::vector<PrefabComponent> components;
+
+			// scripts live within the script engine, so they are still deserialized for each instance
+			Node scripts;
+		};
+
+		constexpr static size_t NO_PARENT = static_cast<size_t>(-1);
+
+		Node _node;
+
+		// the compiled Entities, ordered so parents come before their children
+		std::vector<PrefabEntity> _entities;
+		bool _compiled;
+
+	public:
+		Prefab();
+
+		Prefab(PrefabBuilder const& builder);
+
+		/// <summary>
+		/// Gets the serialized Entities within this Prefab.
+		/// </summary>
+		/// <returns></returns>
+		Node const& get_node() const { return _node; }
+
+		/// <summary>
+		/// Checks if this Prefab has been compiled, by being instantiated at least once.
+		/// </summary>
+		/// <returns></returns>
+		bool is_compiled() const { return _compiled; }
+
+		/// <summary>
+		/// Gets the number of Entities within this Prefab.
+		/// </summary>
+		/// <returns></returns>
+		size_t size() const { return _node.get_children().size(); }
+	};
+}
\ No newline at end of file
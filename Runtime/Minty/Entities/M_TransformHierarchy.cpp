@@ -0,0 +1,245 @@
+#include "pch.h"
+#include "Minty/Entities/M_TransformHierarchy.h"
+
+#include "Minty/Entities/M_EntityRegistry.h"
+#include "Minty/Components/M_TransformComponent.h"
+#include "Minty/Components/M_RelationshipComponent.h"
+#include "Minty/Components/M_DirtyComponent.h"
+#include "Minty/Multithreading/M_JobSystem.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define MINTY_TRANSFORM_SSE
+#include <xmmintrin.h>
+#endif
+
+using namespace Minty;
+
+// the number of transforms updated by each Job
+constexpr static size_t TRANSFORM_GRAIN_SIZE = 1024;
+
+// out = left * right, for column major matrices
+static inline void multiply_matrix(Matrix4 const& left, Matrix4 const& right, Matrix4& out)
+{
+#ifdef MINTY_TRANSFORM_SSE
+	float const* l = &left[0][0];
+	float const* r = &right[0][0];
+	float* o = &out[0][0];
+
+	__m128 const l0 = _mm_loadu_ps(l);
+	__m128 const l1 = _mm_loadu_ps(l + 4);
+	__m128 const l2 = _mm_loadu_ps(l + 8);
+	__m128 const l3 = _mm_loadu_ps(l + 12);
+
+	// each column of the result is the left columns, weighted by the right column
+	for (int i = 0; i < 4; i++)
+	{
+		float const* column = r + i * 4;
+		__m128 result = _mm_mul_ps(l0, _mm_set1_ps(column[0]));
+		result = _mm_add_ps(result, _mm_mul_ps(l1, _mm_set1_ps(column[1])));
+		result = _mm_add_ps(result, _mm_mul_ps(l2, _mm_set1_ps(column[2])));
+		result = _mm_add_ps(result, _mm_mul_ps(l3, _mm_set1_ps(column[3])));
+		_mm_storeu_ps(o + i * 4, result);
+	}
+#else
+	out = left * right;
+#endif
+}
+
+Minty::TransformHierarchy::TransformHierarchy(EntityRegistry& registry)
+	: _registry(registry)
+	, _entities()
+	, _transforms()
+	, _parents()
+	, _globals()
+	, _updated()
+	, _depths()
+	, _lookup()
+	, _layoutDirty(true)
+	, _hierarchyVersion(registry.get_hierarchy_version())
+{
+	// the TransformComponents move around within their storage when one is removed
+	_registry.on_construct<TransformComponent>().connect<&TransformHierarchy::on_transform_changed>(*this);
+	_registry.on_destroy<TransformComponent>().connect<&TransformHierarchy::on_transform_changed>(*this);
+}
+
+Minty::TransformHierarchy::~TransformHierarchy()
+{
+	_registry.on_construct<TransformComponent>().disconnect<&TransformHierarchy::on_transform_changed>(*this);
+	_registry.on_destroy<TransformComponent>().disconnect<&TransformHierarchy::on_transform_changed>(*this);
+}
+
+void Minty::TransformHierarchy::update()
+{
+	if (_layoutDirty || _hierarchyVersion != _registry.get_hierarchy_version())
+	{
+		rebuild();
+	}
+
+	if (_entities.empty()) return;
+
+	// start with the dirty transforms, their children are added as each depth is updated
+	std::fill(_updated.begin(), _updated.end(), static_cast<uint8_t>(0));
+
+	bool any = false;
+	for (auto [entity, dirty, transform] : _registry.view<DirtyComponent const, TransformComponent const>().each())
+	{
+		_updated[_lookup[entt::to_entity(entity)]] = 1;
+		any = true;
+	}
+
+	if (!any) return;
+
+	// each depth only depends on the depths above it
+	JobSystem& jobSystem = JobSystem::instance();
+
+	for (size_t depth = 0; depth + 1 < _depths.size(); depth++)
+	{
+		size_t const begin = _depths[depth];
+		size_t const end = _depths[depth + 1];
+		size_t const chunks = (end - begin + TRANSFORM_GRAIN_SIZE - 1) / TRANSFORM_GRAIN_SIZE;
+
+		jobSystem.parallel_for(0, chunks, [this, begin, end](size_t const chunk)
+			{
+				size_t const chunkBegin = begin + chunk * TRANSFORM_GRAIN_SIZE;
+				update_range(chunkBegin, std::min(chunkBegin + TRANSFORM_GRAIN_SIZE, end));
+			}, 1);
+	}
+}
+
+void Minty::TransformHierarchy::update_range(size_t const begin, size_t const end)
+{
+	for (size_t i = begin; i < end; i++)
+	{
+		uint32_t const parent = _parents[i];
+
+		if (parent == INVALID_INDEX)
+		{
+			if (!_updated[i]) continue;
+
+			_globals[i] = _transforms[i]->get_local_matrix();
+		}
+		else
+		{
+			if (!_updated[i] && !_updated[parent]) continue;
+
+			multiply_matrix(_globals[parent], _transforms[i]->get_local_matrix(), _globals[i]);
+			_updated[i] = 1;
+		}
+
+		_transforms[i]->globalMatrix = _globals[i];
+	}
+}
+
+void Minty::TransformHierarchy::rebuild()
+{
+	_layoutDirty = false;
+	_hierarchyVersion = _registry.get_hierarchy_version();
+
+	auto& storage = _registry.storage<TransformComponent>();
+	size_t const count = storage.size();
+
+	_entities.resize(count);
+	_transforms.resize(count);
+	_parents.resize(count);
+	_globals.resize(count);
+	_updated.resize(count);
+	_depths.clear();
+	_lookup.clear();
+
+	if (!count) return;
+
+	// find the parent of each transform: the parent Entity, if it also has a transform
+	uint32_t maxIndex = 0;
+	std::vector<Entity> parents(count, NULL_ENTITY);
+	for (size_t i = 0; i < count; i++)
+	{
+		Entity const entity = storage.data()[i];
+		maxIndex = std::max(maxIndex, static_cast<uint32_t>(entt::to_entity(entity)));
+
+		if (RelationshipComponent const* relationship = _registry.try_get<RelationshipComponent>(entity))
+		{
+			if (relationship->parent != NULL_ENTITY && storage.contains(relationship->parent))
+			{
+				parents[i] = relationship->parent;
+			}
+		}
+	}
+
+	// find the depth of each transform, walking up to the first known depth
+	// indexed by Entity, so the parents can be looked up directly
+	_lookup.assign(static_cast<size_t>(maxIndex) + 1, INVALID_INDEX);
+	std::vector<uint32_t> entityDepths(_lookup.size(), INVALID_INDEX);
+	std::vector<Entity> stack;
+	uint32_t maxDepth = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		_lookup[entt::to_entity(storage.data()[i])] = static_cast<uint32_t>(i);
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Entity entity = storage.data()[i];
+
+		while (entityDepths[entt::to_entity(entity)] == INVALID_INDEX)
+		{
+			stack.push_back(entity);
+
+			Entity const parent = parents[_lookup[entt::to_entity(entity)]];
+			if (parent == NULL_ENTITY) break;
+			entity = parent;
+		}
+
+		// the depth of the first known ancestor, or the root
+		uint32_t depth = entityDepths[entt::to_entity(entity)];
+
+		while (!stack.empty())
+		{
+			depth = depth == INVALID_INDEX ? 0 : depth + 1;
+			entityDepths[entt::to_entity(stack.back())] = depth;
+			maxDepth = std::max(maxDepth, depth);
+			stack.pop_back();
+		}
+	}
+
+	// sort by depth, keeping the storage order within each depth
+	_depths.assign(static_cast<size_t>(maxDepth) + 2, 0);
+	for (size_t i = 0; i < count; i++)
+	{
+		_depths[entityDepths[entt::to_entity(storage.data()[i])] + 1]++;
+	}
+	for (size_t depth = 1; depth < _depths.size(); depth++)
+	{
+		_depths[depth] += _depths[depth - 1];
+	}
+
+	std::vector<size_t> positions(_depths.begin(), _depths.end() - 1);
+	for (size_t i = 0; i < count; i++)
+	{
+		Entity const entity = storage.data()[i];
+		size_t const position = positions[entityDepths[entt::to_entity(entity)]]++;
+
+		_entities[position] = entity;
+		_transforms[position] = &storage.get(entity);
+		_globals[position] = _transforms[position]->globalMatrix;
+		_parents[position] = parents[i] == NULL_ENTITY ? INVALID_INDEX : static_cast<uint32_t>(i);
+	}
+
+	// point the lookup and the parents at the sorted positions
+	for (size_t i = 0; i < count; i++)
+	{
+		_lookup[entt::to_entity(_entities[i])] = static_cast<uint32_t>(i);
+	}
+	for (size_t i = 0; i < count; i++)
+	{
+		if (_parents[i] != INVALID_INDEX)
+		{
+			_parents[i] = _lookup[entt::to_entity(parents[_parents[i]])];
+		}
+	}
+}
+
+void Minty::TransformHierarchy::on_transform_changed(entt::registry& registry, Entity const entity)
+{
+	_layoutDirty = true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "Minty/Types/M_Object.h"
+#include "Minty/Types/M_Matrix.h"
+#include "Minty/Entities/M_Entity.h"
+
+#include <vector>
+
+namespace Minty
+{
+	class EntityRegistry;
+	struct TransformComponent;
+
+	/// <summary>
+	/// Propagates the global matrices of the TransformComponents in an EntityRegistry, parent to child.
+	/// 
+	/// The transforms are kept in flat arrays, ordered by their depth in the hierarchy, so each depth can be updated at once.
+	/// Each depth only reads from the depth above it, so large depths are split between the JobSystem workers.
+	/// </summary>
+	class TransformHierarchy
+		: public Object
+	{
+	private:
+		EntityRegistry& _registry;
+
+		// the entities with transforms, ordered by depth
+		std::vector<Entity> _entities;
+		// the transform of each entity, valid until a transform is added or removed
+		std::vector<TransformComponent*> _transforms;
+		// the index of the parent transform of each entity, or INVALID_INDEX if it has none
+		std::vector<uint32_t> _parents;
+		// the global matrix of each entity, so children read their parent's matrix from the contiguous depth above
+		std::vector<Matrix4> _globals;
+		// if the entity was updated this frame: set for dirty entities, and for the children of updated entities
+		std::vector<uint8_t> _updated;
+		// the start of each depth within the arrays, followed by the total size
+		std::vector<size_t> _depths;
+		// the index of each entity within the arrays, by entity index, or INVALID_INDEX
+		std::vector<uint32_t> _lookup;
+
+		// true when the arrays need to be rebuilt
+		bool _layoutDirty;
+		// the hierarchy version of the registry when the arrays were last built
+		uint64_t _hierarchyVersion;
+
+		static constexpr uint32_t INVALID_INDEX = static_cast<uint32_t>(-1);
+
+	public:
+		/// <summary>
+		/// Creates a new TransformHierarchy for the given EntityRegistry.
+		/// </summary>
+		/// <param name="registry"></param>
+		TransformHierarchy(EntityRegistry& registry);
+
+		~TransformHierarchy();
+
+		TransformHierarchy(TransformHierarchy const& other) = delete;
+
+		TransformHierarchy& operator=(TransformHierarchy const& other) = delete;
+
+		/// <summary>
+		/// Updates the global matrix of each dirty TransformComponent, and each of their children.
+		/// </summary>
+		void update();
+
+		/// <summary>
+		/// Gets the number of depths in the hierarchy.
+		/// </summary>
+		/// <returns></returns>
+		size_t get_depth_count() const { return _depths.empty() ? 0 : _depths.size() - 1; }
+
+		/// <summary>
+		/// Gets the number of transforms in the hierarchy.
+		/// </summary>
+		/// <returns></returns>
+		size_t size() const { return _entities.size(); }
+
+	private:
+		// orders the transforms by depth
+		void rebuild();
+
+		// updates the transforms in [begin, end)
+		void update_range(size_t const begin, size_t const end);
+
+		// called when a TransformComponent is added or removed
+		void on_transform_changed(entt::registry& registry, Entity const entity);
+	};
+}
\ No newline at end of file
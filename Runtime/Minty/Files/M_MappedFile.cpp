@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "Minty/Files/M_MappedFile.h"
+
+#include "Minty/Tools/M_Console.h"
+
+#ifdef MINTY_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Minty;
+
+Minty::MappedFile::MappedFile()
+    : _path()
+    , _data()
+    , _size()
+#ifdef MINTY_WINDOWS
+    , _file()
+    , _mapping()
+#else
+    , _file(-1)
+#endif
+{}
+
+Minty::MappedFile::MappedFile(Path const& path)
+    : MappedFile()
+{
+    open(path);
+}
+
+Minty::MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool Minty::MappedFile::open(Path const& path)
+{
+    // close if open
+    close();
+
+    if (!std::filesystem::is_regular_file(path))
+    {
+        MINTY_ERROR_FORMAT("Cannot map \"{}\": not a regular file.", path.string());
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(std::filesystem::file_size(path));
+
+    if (!size)
+    {
+        // nothing to map, but the file is still "open"
+        _path = path;
+        return true;
+    }
+
+#ifdef MINTY_WINDOWS
+    // share everything, so other copies still holding a mapping do not block writing to the file
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        MINTY_ERROR_FORMAT("Cannot map \"{}\": failed to open file.", path.string());
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        MINTY_ERROR_FORMAT("Cannot map \"{}\": failed to create file mapping.", path.string());
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        MINTY_ERROR_FORMAT("Cannot map \"{}\": failed to map view of file.", path.string());
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    _file = file;
+    _mapping = mapping;
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        MINTY_ERROR_FORMAT("Cannot map \"{}\": failed to open file.", path.string());
+        return false;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (data == MAP_FAILED)
+    {
+        MINTY_ERROR_FORMAT("Cannot map \"{}\": failed to map file.", path.string());
+        ::close(file);
+        return false;
+    }
+
+    _file = file;
+#endif
+
+    _path = path;
+    _data = static_cast<char const*>(data);
+    _size = size;
+
+    return true;
+}
+
+void Minty::MappedFile::close()
+{
+#ifdef MINTY_WINDOWS
+    if (_data) UnmapViewOfFile(_data);
+    if (_mapping) CloseHandle(static_cast<HANDLE>(_mapping));
+    if (_file) CloseHandle(static_cast<HANDLE>(_file));
+
+    _file = nullptr;
+    _mapping = nullptr;
+#else
+    if (_data) munmap(const_cast<char*>(_data), _size);
+    if (_file >= 0) ::close(_file);
+
+    _file = -1;
+#endif
+
+    _path = Path();
+    _data = nullptr;
+    _size = 0;
+}
+
+bool Minty::MappedFile::is_open() const
+{
+    return !_path.empty();
+}
+
+Path const& Minty::MappedFile::get_path() const
+{
+    return _path;
+}
+
+char const* Minty::MappedFile::data() const
+{
+    return _data;
+}
+
+size_t Minty::MappedFile::size() const
+{
+    return _size;
+}
+
+std::span<char const> Minty::MappedFile::view(size_t const offset, size_t const size) const
+{
+    if (offset > _size || size > _size - offset)
+    {
+        // out of bounds
+        return std::span<char const>();
+    }
+
+    return std::span<char const>(_data + offset, size);
+}
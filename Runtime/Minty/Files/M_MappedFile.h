@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Minty/Types/M_Object.h"
+#include <span>
+
+namespace Minty
+{
+	/// <summary>
+	/// Maps a whole file on the disk into memory, as read only.
+	/// </summary>
+	class MappedFile
+		: public Object
+	{
+	private:
+		// path to the mapped file on the disk
+		Path _path;
+
+		// start of the mapped data
+		char const* _data;
+
+		// size of the mapped data, in bytes
+		size_t _size;
+
+#ifdef MINTY_WINDOWS
+		// file and mapping handles
+		void* _file;
+		void* _mapping;
+#else
+		// file descriptor
+		int _file;
+#endif
+
+	public:
+		/// <summary>
+		/// Creates an empty MappedFile.
+		/// </summary>
+		MappedFile();
+
+		/// <summary>
+		/// Creates a MappedFile and maps the file at the given path.
+		/// </summary>
+		/// <param name="path">The path to the file on the disk.</param>
+		MappedFile(Path const& path);
+
+		~MappedFile();
+
+		MappedFile(MappedFile const& other) = delete;
+
+		MappedFile& operator=(MappedFile const& other) = delete;
+
+		/// <summary>
+		/// Maps the file at the given path. If a file is already mapped, it will be unmapped.
+		/// </summary>
+		/// <param name="path">The path to the file on the disk.</param>
+		/// <returns>True if the file was mapped.</returns>
+		bool open(Path const& path);
+
+		/// <summary>
+		/// Unmaps the mapped file, if any.
+		/// </summary>
+		void close();
+
+		/// <summary>
+		/// Checks if a file is currently mapped.
+		/// </summary>
+		/// <returns></returns>
+		bool is_open() const;
+
+		/// <summary>
+		/// Gets the Path to the mapped file.
+		/// </summary>
+		/// <returns></returns>
+		Path const& get_path() const;
+
+		/// <summary>
+		/// Gets the start of the mapped data.
+		/// </summary>
+		/// <returns></returns>
+		char const* data() const;
+
+		/// <summary>
+		/// Gets the size of the mapped data, in bytes.
+		/// </summary>
+		/// <returns></returns>
+		size_t size() const;
+
+		/// <summary>
+		/// Gets a view of the mapped data, starting at the given offset.
+		/// </summary>
+		/// <param name="offset">The offset into the mapped data, in bytes.</param>
+		/// <param name="size">The number of bytes to view.</param>
+		/// <returns>The view, or an empty view if the range is out of bounds.</returns>
+		std::span<char const> view(size_t const offset, size_t const size) const;
+	};
+}
\ No newline at end of file
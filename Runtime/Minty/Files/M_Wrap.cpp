@@ -6,16 +6,119 @@
 #include "Minty/Files/M_File.h"
 #include "Minty/Tools/M_Console.h"
 #include "Minty/Assets/M_Asset.h"
+#include "Minty/Multithreading/M_JobSystem.h"
 
 #include <filesystem>
 
 using namespace Minty;
 
+static_assert(sizeof(Wrap::Entry) == 40, "Wrap::Entry is stored directly within Wrap files, so its size must not change.");
+
+namespace
+{
+    constexpr uint64_t const FNV_OFFSET = 14695981039346656037ull;
+    constexpr uint64_t const FNV_PRIME = 1099511628211ull;
+
+    // visits path characters in their normalized form: separators become '/', repeated separators become one, and trailing separators are dropped
+    class PathNormalizer
+    {
+    private:
+        // true if a separator has been found, but not visited yet
+        bool _pending = false;
+
+    public:
+        template<typename Char, typename Func>
+        bool visit(Char const* const text, size_t const size, Func& func)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                Char const c = text[i];
+
+                if (c == '/' || c == '\\')
+                {
+                    _pending = true;
+                    continue;
+                }
+
+                if (_pending)
+                {
+                    _pending = false;
+                    if (!func('/')) return false;
+                }
+
+                if (!func(static_cast<char>(c))) return false;
+            }
+
+            return true;
+        }
+
+        template<typename Func>
+        bool visit(std::string_view const text, Func& func)
+        {
+            return visit(text.data(), text.size(), func);
+        }
+
+        template<typename Func>
+        bool visit(Path const& path, Func& func)
+        {
+            Path::string_type const& native = path.native();
+
+            // visit the native characters directly if they are all ASCII, to avoid converting the path
+            if (std::all_of(native.begin(), native.end(), [](Path::value_type const c) { return static_cast<uint32_t>(c) < 0x80; }))
+            {
+                return visit(native.data(), native.size(), func);
+            }
+
+            std::u8string const text = path.generic_u8string();
+            return visit(reinterpret_cast<char const*>(text.data()), text.size(), func);
+        }
+    };
+
+    // hashes the normalized characters of a path, one at a time
+    struct PathHasher
+    {
+        uint64_t hash = FNV_OFFSET;
+
+        bool operator()(char const c)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+            return true;
+        }
+    };
+
+    // normalizes the given path into a string
+    String normalize_path(std::string_view const path)
+    {
+        String result;
+        result.reserve(path.size());
+        auto append = [&result](char const c) { result.push_back(c); return true; };
+        PathNormalizer().visit(path, append);
+        return result;
+    }
+
+    // hashes the full path of an entry, using the normalized base path and normalized relative path
+    uint64_t hash_entry_path(std::string_view const base, std::string_view const relative)
+    {
+        PathHasher hasher;
+        PathNormalizer normalizer;
+        if (!base.empty())
+        {
+            normalizer.visit(base, hasher);
+            normalizer.visit(std::string_view("/"), hasher);
+        }
+        normalizer.visit(relative, hasher);
+        return hasher.hash;
+    }
+}
+
 Minty::Wrap::Wrap(Path const& path, String const& name, uint32_t const entryCount, Path const& base, uint32_t const contentVersion)
     : _path(path)
     , _header()
+    , _table()
     , _entries()
-    , _indexed()
+    , _strings()
+    , _base()
+    , _mapped()
 {
     // set header data
     _header.type = Type::File;
@@ -23,31 +126,29 @@ Minty::Wrap::Wrap(Path const& path, String const& name, uint32_t const entryCoun
     _header.contentVersion = contentVersion;
     set_name(name);
     set_base_path(base);
-    _header.entryCount = entryCount;
+    _header.entryCount = 0;
 
-    _entries.resize(entryCount);
-    for (uint32_t i = 0; i < entryCount; i++)
-    {
-        _empties.emplace(i);
-    }
+    // make room for the expected entries
+    _entries.reserve(entryCount);
+
+    // no data yet, so the table of contents starts right after the table
+    _table.offset = static_cast<uint32_t>(sizeof(Header) + sizeof(Table));
 
     // open file, open with truncate to override any existing file
     PhysicalFile file(path, File::Flags::Write | File::Flags::Binary | File::Flags::Truncate);
 
-    // write header
+    // write header and the empty table of contents
     write_header(file);
-
-    // write entries
-    for (uint32_t i = 0; i < entryCount; i++)
-    {
-        write_entry(file, i);
-    }
+    write_table(file);
     
     file.close();
 }
 
 void Minty::Wrap::load(Path const& path)
 {
+    // drop the old mapping first, so a failed load does not keep serving it
+    _mapped.release();
+
     // check if file exists and is valid
     if (!std::filesystem::exists(path))
     {
@@ -85,121 +186,194 @@ void Minty::Wrap::load(Path const& path)
         return;
     }
 
+    _base = normalize_path(_header.basePath);
+
     // read entries
-    Path basePath(_header.basePath);
-    _entries.resize(_header.entryCount);
-    _indexed.reserve(_header.entryCount);
-    for (uint32_t i = 0; i < _header.entryCount; i++)
-    {
-        // read entry
-        Entry& entry = _entries.at(i);
-        file.read(&entry, sizeof(Entry));
-        // add path and index
-        _indexed.emplace(fix_path(entry.path), i);
-        // add to empties if empty
-        if (entry.empty())
-        {
-            _empties.emplace(i);
-        }
+    bool loaded;
+    switch (_header.wrapVersion)
+    {
+    case 0:
+        loaded = load_legacy(file);
+        break;
+    case WRAP_VERSION:
+        loaded = load_table(file);
+        break;
+    default:
+        MINTY_ERROR_FORMAT("Cannot load \"{}\" Wrap file: unsupported Wrap version {}.", _path.string(), _header.wrapVersion);
+        loaded = false;
+        break;
     }
 
     file.close();
+
+    if (!loaded)
+    {
+        _header = Header();
+        _table = Table();
+        _entries.clear();
+        _strings.clear();
+        _base.clear();
+        return;
+    }
+
+    // map the whole file once, so entries can be read without opening the file again
+    map();
 }
 
-void Minty::Wrap::write_header(PhysicalFile& wrapFile) const
+void Minty::Wrap::map()
 {
-    wrapFile.seek_write(0);
-    wrapFile.write(&_header, sizeof(Header));
+    // assigning over an Owner does not delete the old MappedFile, so release it first
+    _mapped.release();
+    _mapped = Owner<MappedFile>(_path);
 }
 
-void Minty::Wrap::write_entry(PhysicalFile& wrapFile, size_t const index) const
+bool Minty::Wrap::is_mapped() const
 {
-    wrapFile.seek_write(sizeof(Header) + sizeof(Entry) * index);
-    wrapFile.write(&_entries.at(index), sizeof(Entry));
+    return _mapped.get() && _mapped->is_open();
 }
 
-uint32_t Minty::Wrap::emplace_entry(Entry& newEntry)
+bool Minty::Wrap::load_legacy(PhysicalFile& wrapFile)
 {
-    int64_t bestIndex = -1;
-
-    // search through empty entries to find best fit
-    for (uint32_t const index : _empties)
+    // read all of the old entries at once
+    std::vector<LegacyEntry> legacyEntries(_header.entryCount);
+    wrapFile.read(legacyEntries.data(), static_cast<File::Size>(sizeof(LegacyEntry) * legacyEntries.size()));
+
+    // convert them to the new entries
+    _entries.clear();
+    _entries.reserve(legacyEntries.size());
+    _strings.clear();
+    for (LegacyEntry const& legacyEntry : legacyEntries)
     {
-        Entry& entry = _entries.at(index);
+        std::string_view const legacyPath(legacyEntry.path, strnlen(legacyEntry.path, WRAP_ENTRY_PATH_SIZE));
 
-        if (entry.reservedSize && entry.reservedSize < newEntry.reservedSize)
+        // ignore empty slots
+        if (legacyPath.empty())
         {
-            // not big enough
             continue;
         }
 
-        // big enough
+        // old paths may or may not include the base path
+        String const relative = normalize_path(relative_path(Path(legacyPath)).generic_string());
+
+        Entry entry;
+        entry.hash = hash_entry_path(_base, relative);
+        entry.pathOffset = static_cast<uint32_t>(_strings.size());
+        entry.pathSize = static_cast<uint32_t>(relative.size());
+        entry.reservedSize = legacyEntry.reservedSize;
+        entry.compressedSize = legacyEntry.compressedSize;
+        entry.uncompressedSize = legacyEntry.uncompressedSize;
+        entry.offset = legacyEntry.offset;
+        entry.compressionLevel = legacyEntry.compressionLevel;
+        entry.codec = static_cast<Byte>(CompressionCodec::Zlib);
+        _entries.push_back(entry);
+
+        _strings.insert(_strings.end(), relative.begin(), relative.end());
+        _strings.push_back('\0');
+    }
+    sort_entries();
 
-        // replace best index if no index yet, or this is a closer reserved size
-        if(bestIndex == -1)
-        {
-            // no best index yet, so place the index unconditionally
-            bestIndex = index;
-            continue;
-        }
+    _header.entryCount = static_cast<uint32_t>(_entries.size());
 
-        Entry const& bestEntry = _entries.at(bestIndex);
-        if ((entry.reservedSize && !bestEntry.reservedSize) || (entry.reservedSize && bestEntry.reservedSize && entry.reservedSize < bestEntry.reservedSize))
-        {
-            // place if best has no reserved size and this does, OR
-            // if both have a size and this one is smaller
-            bestIndex = index;
-        }
-    }
+    // if this Wrap is ever written to, the table of contents will go after all of the existing data
+    _table.offset = static_cast<uint32_t>(wrapFile.size());
+    _table.stringsSize = static_cast<uint32_t>(_strings.size());
 
-    // if index, replace that entry and return that index
-    if (bestIndex >= 0)
-    {
-        // TODO: if not an exact size match, then split the entry
-        uint32_t index = static_cast<uint32_t>(bestIndex);
+    return true;
+}
 
-        // remove index from empties
-        _empties.erase(index);
+bool Minty::Wrap::load_table(PhysicalFile& wrapFile)
+{
+    // read table data
+    wrapFile.read(&_table, sizeof(Table));
 
-        // replace old indexed path
-        _indexed.erase(fix_path(_entries[index].path));
+    size_t const entriesSize = sizeof(Entry) * _header.entryCount;
+    size_t const tableSize = entriesSize + _table.stringsSize;
 
-        // move some data to new entry (pos, size, etc.)
-        Entry const& oldEntry = _entries.at(index);
+    if (static_cast<size_t>(_table.offset) + tableSize > static_cast<size_t>(wrapFile.size()))
+    {
+        MINTY_ERROR_FORMAT("Cannot load \"{}\" Wrap file: table of contents is out of bounds.", _path.string());
+        return false;
+    }
+
+    // read the whole table of contents at once
+    std::vector<char> data(tableSize);
+    wrapFile.seek_read(_table.offset);
+    wrapFile.read(data.data(), static_cast<File::Size>(tableSize));
+
+    _entries.resize(_header.entryCount);
+    memcpy(_entries.data(), data.data(), entriesSize);
+    _strings.assign(data.begin() + entriesSize, data.end());
 
-        // if there already was a size and offset reserved, use those, otherwise accept the incoming size and offset
-        if (oldEntry.reservedSize)
+    // ensure every path is within the string pool
+    for (Entry const& entry : _entries)
+    {
+        if (static_cast<size_t>(entry.pathOffset) + entry.pathSize >= _strings.size() || _strings.at(entry.pathOffset + entry.pathSize) != '\0')
         {
-            newEntry.offset = oldEntry.offset;
-            newEntry.reservedSize = oldEntry.reservedSize;
+            MINTY_ERROR_FORMAT("Cannot load \"{}\" Wrap file: invalid entry path.", _path.string());
+            return false;
         }
+    }
 
-        // officially replace it
-        _entries[index] = newEntry;
-        _indexed[Path(_header.basePath) / newEntry.path] = index;
-
-        // return that index
-        return static_cast<uint32_t>(index);
+    // the entries should already be sorted, but do not trust it
+    if (!std::is_sorted(_entries.begin(), _entries.end(), [](Entry const& left, Entry const& right) { return left.hash < right.hash; }))
+    {
+        sort_entries();
     }
 
-    // cannot fit
-    MINTY_ERROR("Cannot emplace entry to Wrap file. Entry count surpassed.");
+    return true;
+}
+
+void Minty::Wrap::write_header(PhysicalFile& wrapFile) const
+{
+    wrapFile.seek_write(0);
+    wrapFile.write(&_header, sizeof(Header));
+    wrapFile.write(&_table, sizeof(Table));
+}
+
+void Minty::Wrap::write_table(PhysicalFile& wrapFile) const
+{
+    wrapFile.seek_write(_table.offset);
+    wrapFile.write(_entries.data(), static_cast<File::Size>(sizeof(Entry) * _entries.size()));
+    wrapFile.write(_strings.data(), static_cast<File::Size>(_strings.size()));
+}
 
-    return -1;
+void Minty::Wrap::sort_entries()
+{
+    std::sort(_entries.begin(), _entries.end(), [](Entry const& left, Entry const& right) { return left.hash < right.hash; });
 }
 
-Path Minty::Wrap::fix_path(Path const& path) const
+size_t Minty::Wrap::find(uint64_t const hash, Path const& path) const
 {
-    if (path.empty() || _header.basePath[0] == '\0' || *path.begin() == _header.basePath)
+    auto found = std::lower_bound(_entries.begin(), _entries.end(), hash, [](Entry const& entry, uint64_t const value) { return entry.hash < value; });
+
+    // check each entry with the same hash, in case of a collision
+    for (; found != _entries.end() && found->hash == hash; found++)
     {
-        // all good
-        return path;
+        size_t const index = static_cast<size_t>(found - _entries.begin());
+
+        if (matches_entry(index, path))
+        {
+            return index;
+        }
     }
-    else
+
+    return INVALID_INDEX;
+}
+
+size_t Minty::Wrap::find_relative(uint64_t const hash, std::string_view const relative) const
+{
+    auto found = std::lower_bound(_entries.begin(), _entries.end(), hash, [](Entry const& entry, uint64_t const value) { return entry.hash < value; });
+
+    // check each entry with the same hash, in case of a collision
+    for (; found != _entries.end() && found->hash == hash; found++)
     {
-        // missing base path
-        return _header.basePath / path;
+        if (std::string_view(&_strings.at(found->pathOffset), found->pathSize) == relative)
+        {
+            return static_cast<size_t>(found - _entries.begin());
+        }
     }
+
+    return INVALID_INDEX;
 }
 
 Path Minty::Wrap::relative_path(Path const& path) const
@@ -226,15 +400,14 @@ void Minty::Wrap::set_base_path(Path const& path)
     // set the base path
     memcpy(_header.basePath, path.string().c_str(), WRAP_HEADER_PATH_SIZE);
     _header.basePath[WRAP_HEADER_PATH_SIZE - 1] = '\0';
+    _base = normalize_path(_header.basePath);
 
-    // replace indexed
-    _indexed.clear();
-    Path basePath(_header.basePath);
-    for (size_t i = 0; i < _header.entryCount; i++)
+    // every full path changed, so rehash them
+    for (Entry& entry : _entries)
     {
-        Entry const& entry = _entries.at(i);
-        _indexed.emplace(basePath / entry.path, i);
+        entry.hash = hash_entry_path(_base, std::string_view(&_strings.at(entry.pathOffset), entry.pathSize));
     }
+    sort_entries();
 }
 
 Path const& Minty::Wrap::get_path() const
@@ -264,8 +437,10 @@ uint32_t Minty::Wrap::get_content_version() const
     return _header.contentVersion;
 }
 
-void Minty::Wrap::emplace(Path const& physicalPath, Path const& virtualPath, CompressionLevel const compressionLevel, uint32_t const reservedSize)
+void Minty::Wrap::prepare_file(Source const& source, PreparedFile& file) const
 {
+    Path const& physicalPath = source.physicalPath;
+
     // check if file exists and is valid
     if (!std::filesystem::exists(physicalPath))
     {
@@ -280,93 +455,268 @@ void Minty::Wrap::emplace(Path const& physicalPath, Path const& virtualPath, Com
         return;
     }
 
-    // open wrap file
-    PhysicalFile wrapFile(_path, File::Flags::ReadWrite | File::Flags::Binary);
-
-    // open file
-    PhysicalFile file(physicalPath, File::Flags::Read | File::Flags::Binary);
-
     // read the data from the file
-    File::Size fileSize = file.size();
-    Byte* fileData = new Byte[fileSize];
-    file.read(fileData, fileSize);
+    PhysicalFile physicalFile(physicalPath, File::Flags::Read | File::Flags::Binary);
+    File::Size fileSize = physicalFile.size();
+    file.data.resize(static_cast<size_t>(fileSize));
+    physicalFile.read(file.data.data(), fileSize);
+    physicalFile.close();
 
-    // done with that file
-    file.close();
+    // get the path relative to the base path
+    file.relative = normalize_path(relative_path(source.virtualPath).generic_string());
+    MINTY_ASSERT(!file.relative.empty());
 
     // create an entry for the new file
-    String source = relative_path(virtualPath).string();
-    MINTY_ASSERT(source.length() < WRAP_ENTRY_PATH_SIZE);
-    Entry entry;
-    memcpy(entry.path, source.c_str(), std::min(static_cast<size_t>(WRAP_ENTRY_PATH_SIZE - 1), source.size()));
-    entry.path[WRAP_ENTRY_PATH_SIZE - 1] = '\0';
-    entry.compressionLevel = static_cast<Byte>(compressionLevel);
+    Entry& entry = file.entry;
+    entry.hash = hash_entry_path(_base, file.relative);
+    entry.compressionLevel = static_cast<Byte>(source.compression);
+    entry.codec = static_cast<Byte>(source.codec);
     entry.uncompressedSize = static_cast<uint32_t>(fileSize);
+    entry.reservedSize = source.reservedSize;
 
     // compress the data, if needed
-    if (static_cast<bool>(compressionLevel))
+    if (static_cast<bool>(source.compression))
     {
         // calculate sizes
         unsigned long sourceSize = static_cast<unsigned long>(fileSize);
-        unsigned long destSize = compress_bound(sourceSize);
-
-        // create dest buffer
-        Byte* compressedData = new Byte[destSize];
+        unsigned long destSize = compress_bound(source.codec, sourceSize);
 
         // compress it
-        if (compress(compressedData, destSize, fileData, sourceSize, compressionLevel))
+        std::vector<Byte> compressedData(destSize);
+        if (!destSize || compress(source.codec, compressedData.data(), destSize, file.data.data(), sourceSize, source.compression))
         {
-            MINTY_ERROR_FORMAT("Cannot emplace \"{}\" into Wrap file: failed to compress file with compression level {}.", physicalPath.string(), static_cast<int>(compressionLevel));
+            MINTY_ERROR_FORMAT("Cannot emplace \"{}\" into Wrap file: failed to compress file with {} compression level {}.", physicalPath.string(), get_compression_codec_name(source.codec), static_cast<int>(source.compression));
             return;
         }
 
         // replace source
-        delete[] fileData;
-        fileData = compressedData;
-        fileSize = static_cast<File::Size>(destSize);
+        compressedData.resize(destSize);
+        file.data = std::move(compressedData);
+    }
+    entry.compressedSize = static_cast<uint32_t>(file.data.size());
+
+    file.valid = true;
+}
 
-        //MINTY_LOG_FORMAT("Compressed{} from{} bytes to{} bytes.", physicalPath.string(), std::to_string(sourceSize), std::to_string(destSize));
+void Minty::Wrap::write_file(PhysicalFile& wrapFile, PreparedFile const& file)
+{
+    Entry entry = file.entry;
+
+    // find the old entry with the same path, if any
+    size_t const index = find_relative(entry.hash, file.relative);
+
+    if (index != INVALID_INDEX && _entries.at(index).reservedSize >= entry.compressedSize)
+    {
+        // fits within the old chunk, so overwrite it
+        Entry const& oldEntry = _entries.at(index);
+        entry.offset = oldEntry.offset;
+        entry.reservedSize = oldEntry.reservedSize;
+    }
+    else
+    {
+        // place the data where the table of contents is, and move the table of contents after it
+        entry.offset = _table.offset;
+        entry.reservedSize = std::max(entry.reservedSize, entry.compressedSize);
+        _table.offset = entry.offset + entry.reservedSize;
     }
 
-    // set size and offset
-    entry.offset = static_cast<uint32_t>(wrapFile.size());
-    entry.compressedSize = static_cast<uint32_t>(fileSize);
-    if (reservedSize)
+    if (index != INVALID_INDEX)
     {
-        entry.reservedSize = reservedSize;
+        // replace the old entry, keeping its path
+        Entry const& oldEntry = _entries.at(index);
+        entry.pathOffset = oldEntry.pathOffset;
+        entry.pathSize = oldEntry.pathSize;
+        _entries[index] = entry;
     }
     else
     {
-        entry.reservedSize = entry.compressedSize;
+        // add the path to the string pool
+        entry.pathOffset = static_cast<uint32_t>(_strings.size());
+        entry.pathSize = static_cast<uint32_t>(file.relative.size());
+        _strings.insert(_strings.end(), file.relative.begin(), file.relative.end());
+        _strings.push_back('\0');
+        _table.stringsSize = static_cast<uint32_t>(_strings.size());
+
+        // add the entry, keeping the entries sorted
+        auto found = std::upper_bound(_entries.begin(), _entries.end(), entry.hash, [](uint64_t const value, Entry const& other) { return value < other.hash; });
+        _entries.insert(found, entry);
+        _header.entryCount = static_cast<uint32_t>(_entries.size());
     }
-    
-    // add entry
-    size_t index = emplace_entry(entry);
 
-    // write to file
-    write_entry(wrapFile, index);
+    // write the data
     wrapFile.seek_write(entry.offset, File::Direction::Begin);
-    wrapFile.write(fileData, fileSize);
+    wrapFile.write(file.data.data(), static_cast<File::Size>(file.data.size()));
+}
+
+void Minty::Wrap::emplace(Path const& physicalPath, Path const& virtualPath, CompressionLevel const compressionLevel, uint32_t const reservedSize, CompressionCodec const codec)
+{
+    // read and compress the file
+    PreparedFile file;
+    prepare_file(Source{ .physicalPath = physicalPath, .virtualPath = virtualPath, .compression = compressionLevel, .codec = codec, .reservedSize = reservedSize }, file);
+
+    if (!file.valid)
+    {
+        return;
+    }
+
+    // unmap the file before writing to it, the mapping would block the write on some platforms
+    _mapped.release();
+
+    // open wrap file
+    PhysicalFile wrapFile(_path, File::Flags::ReadWrite | File::Flags::Binary);
+
+    // always write the newest version, which upgrades older Wrap files
+    _header.wrapVersion = WRAP_VERSION;
+
+    // write the data, then the table of contents after all of the data
+    write_file(wrapFile, file);
+    write_table(wrapFile);
+    write_header(wrapFile);
+
+    wrapFile.close();
+
+    // map the file again, now that it has the new data
+    map();
+}
+
+void Minty::Wrap::emplace(std::vector<Source> const& sources)
+{
+    if (sources.empty())
+    {
+        return;
+    }
+
+    size_t const count = sources.size();
+    JobSystem& jobSystem = JobSystem::instance();
+
+    // the most files that can be prepared but not written yet, so the whole batch is never held in memory
+    size_t const window = (jobSystem.get_thread_count() + 1) * 4;
+
+    std::vector<PreparedFile> files(count);
+    std::vector<JobHandle> jobs(count);
+    size_t next = 0;
+
+    // unmap the file before writing to it, the mapping would block the write on some platforms
+    _mapped.release();
+
+    // open wrap file
+    PhysicalFile wrapFile(_path, File::Flags::ReadWrite | File::Flags::Binary);
+
+    // always write the newest version, which upgrades older Wrap files
+    _header.wrapVersion = WRAP_VERSION;
+
+    // write the files in order, as they are ready
+    for (size_t i = 0; i < count; i++)
+    {
+        // read and compress the files in Jobs, up to a window ahead of the writer
+        for (; next < count && next < i + window; next++)
+        {
+            PreparedFile* file = &files.at(next);
+            Source const* source = &sources.at(next);
+            jobs.at(next) = jobSystem.schedule([this, source, file]() { prepare_file(*source, *file); });
+        }
+
+        // help prepare the files while waiting
+        jobSystem.wait(jobs.at(i));
+
+        PreparedFile& file = files.at(i);
+        if (file.valid)
+        {
+            write_file(wrapFile, file);
+        }
+
+        // done with the data
+        std::vector<Byte>().swap(file.data);
+    }
+
+    // write the table of contents once, after all of the data
+    write_table(wrapFile);
+    write_header(wrapFile);
 
-    // cleanup
-    delete[] fileData;
     wrapFile.close();
+
+    // map the file again, now that it has the new data
+    map();
 }
 
 bool Minty::Wrap::contains(Path const& path) const
 {
-    return _indexed.contains(path);
+    return find(path) != INVALID_INDEX;
 }
 
 bool Minty::Wrap::open(Path const& path, VirtualFile& file) const
 {
-    if (!contains(path))
+    size_t const index = find(path);
+
+    if (index == INVALID_INDEX)
     {
         return false;
     }
 
+    return open_entry(index, file);
+}
+
+std::vector<char> Minty::Wrap::read(Path const& path) const
+{
+    std::vector<char> buffer;
+    std::span<char const> data = read_view(path, buffer);
+
+    // if the data was uncompressed into the buffer, it is already done
+    if (data.data() == buffer.data())
+    {
+        return buffer;
+    }
+
+    // otherwise, copy it out of the mapped file
+    return std::vector<char>(data.begin(), data.end());
+}
+
+std::span<char const> Minty::Wrap::read_view(Path const& path, std::vector<char>& buffer) const
+{
+    size_t const index = find(path);
+
+    if (index == INVALID_INDEX)
+    {
+        // no file with the given path
+        return std::span<char const>();
+    }
+
+    return read_entry_view(index, buffer);
+}
+
+size_t Minty::Wrap::find(Path const& path) const
+{
+    return find(hash_path(path), path);
+}
+
+bool Minty::Wrap::matches_entry(size_t const index, Path const& path) const
+{
+    Entry const& entry = _entries.at(index);
+    std::string_view const relative(&_strings.at(entry.pathOffset), entry.pathSize);
+
+    // compare against the full path, one normalized character at a time: base, separator, then relative path
+    size_t const baseSize = _base.empty() ? 0 : _base.size() + 1;
+    size_t const size = baseSize + relative.size();
+    size_t position = 0;
+    auto compare = [&](char const c)
+        {
+            char expected;
+            if (position < _base.size()) expected = _base[position];
+            else if (position < baseSize) expected = '/';
+            else if (position < size) expected = relative[position - baseSize];
+            else return false;
+
+            position++;
+            return c == expected;
+        };
+
+    return PathNormalizer().visit(path, compare) && position == size;
+}
+
+bool Minty::Wrap::open_entry(size_t const index, VirtualFile& file) const
+{
     // get entry
-    Entry const& entry = get_entry(path);
+    Entry const& entry = _entries.at(index);
 
     // open file in the given virtual file
     file.open(_path, File::Flags::Read | File::Flags::Binary, entry.offset, entry.uncompressedSize);
@@ -374,43 +724,61 @@ bool Minty::Wrap::open(Path const& path, VirtualFile& file) const
     return true;
 }
 
-std::vector<char> Minty::Wrap::read(Path const& path) const
+std::span<char const> Minty::Wrap::read_entry_view(size_t const index, std::vector<char>& buffer) const
 {
-    VirtualFile file;
+    Entry const& entry = _entries.at(index);
+    bool const compressed = static_cast<bool>(entry.compressionLevel);
 
-    if (!open(path, file))
+    // get the stored data
+    std::span<char const> source;
+    std::vector<char> sourceData;
+    if (is_mapped())
     {
-        // could not open
-        return std::vector<char>();
+        // view the data straight from the mapped file
+        source = _mapped->view(entry.offset, entry.compressedSize);
+
+        if (source.size() != entry.compressedSize)
+        {
+            MINTY_ERROR_FORMAT("Failed to read file \"{}\" in Wrap file: entry is out of bounds.", get_entry_path(index));
+            return std::span<char const>();
+        }
     }
+    else
+    {
+        // not mapped, so read the data from the disk
+        VirtualFile file;
+        if (!open_entry(index, file))
+        {
+            // could not open
+            return std::span<char const>();
+        }
 
-    // read all data from file
-    Entry const& entry = get_entry(path);
-    File::Size fileSize = static_cast<File::Size>(entry.compressedSize);
-    Byte* fileData = new Byte[fileSize];
-    file.read(fileData, fileSize);
+        // read straight into the buffer if there is nothing to uncompress
+        std::vector<char>& target = compressed ? sourceData : buffer;
+        target.resize(entry.compressedSize);
+        file.read(target.data(), static_cast<File::Size>(entry.compressedSize));
+        file.close();
+        source = std::span<char const>(target.data(), target.size());
+    }
 
-    // uncompress it
+    // stored as is, so use the data directly
+    if (!compressed)
+    {
+        return source;
+    }
+
+    // uncompress it into the buffer
     unsigned long sourceSize = static_cast<unsigned long>(entry.compressedSize);
     unsigned long size = static_cast<unsigned long>(entry.uncompressedSize);
-    Byte* data = new Byte[size];
-    if (uncompress(data, size, fileData, sourceSize))
+    buffer.resize(size);
+    if (uncompress(static_cast<CompressionCodec>(entry.codec), buffer.data(), size, source.data(), sourceSize))
     {
-        MINTY_ERROR_FORMAT("Failed to uncompress file \"{}\" in Wrap file.", path.string());
-        return std::vector<char>();
+        MINTY_ERROR_FORMAT("Failed to uncompress file \"{}\" in Wrap file.", get_entry_path(index));
+        buffer.clear();
+        return std::span<char const>();
     }
 
-    // done with file data
-    delete[] fileData;
-
-    // add to vector
-    std::vector<char> result(size);
-    memcpy(result.data(), data, size);
-
-    // done with data
-    delete[] data;
-
-    return result;
+    return std::span<char const>(buffer.data(), size);
 }
 
 Wrap::Entry const& Minty::Wrap::get_entry(size_t const index) const
@@ -423,9 +791,14 @@ size_t Minty::Wrap::get_entry_count() const
     return _entries.size();
 }
 
+char const* Minty::Wrap::get_entry_path(size_t const index) const
+{
+    return &_strings.at(_entries.at(index).pathOffset);
+}
+
 Wrap::Entry const& Minty::Wrap::get_entry(Path const& path) const
 {
-    return _entries.at(_indexed.at(path));
+    return _entries.at(find(path));
 }
 
 Wrap::Type Minty::Wrap::get_type() const
@@ -455,6 +828,20 @@ Wrap Minty::Wrap::load_or_create(Path const& path, String const& name, uint32_t
     }
 }
 
+uint64_t Minty::Wrap::hash_path(Path const& path)
+{
+    PathHasher hasher;
+    PathNormalizer().visit(path, hasher);
+    return hasher.hash;
+}
+
+uint64_t Minty::Wrap::hash_path(std::string_view const path)
+{
+    PathHasher hasher;
+    PathNormalizer().visit(path, hasher);
+    return hasher.hash;
+}
+
 Minty::Wrap::Header::Header()
 {}
 
@@ -492,37 +879,6 @@ Wrap::Header& Minty::Wrap::Header::operator=(Header const& other)
     return *this;
 }
 
-Minty::Wrap::Entry::Entry()
-{}
-
-Minty::Wrap::Entry::Entry(Entry const& other)
-    : path("")
-    , compressionLevel(other.compressionLevel)
-    , reservedSize(other.reservedSize)
-    , compressedSize(other.compressedSize)
-    , uncompressedSize(other.uncompressedSize)
-    , offset(other.offset)
-{
-    memcpy(path, other.path, WRAP_ENTRY_PATH_SIZE);
-    path[WRAP_ENTRY_PATH_SIZE - 1] = '\0';
-}
-
-Wrap::Entry& Minty::Wrap::Entry::operator=(Entry const& other)
-{
-    if (&other != this)
-    {
-        memcpy(path, other.path, WRAP_ENTRY_PATH_SIZE);
-        path[WRAP_ENTRY_PATH_SIZE - 1] = '\0';
-        compressionLevel = other.compressionLevel;
-        reservedSize = other.reservedSize;
-        compressedSize = other.compressedSize;
-        uncompressedSize = other.uncompressedSize;
-        offset = other.offset;
-    }
-
-    return *this;
-}
-
 bool Minty::Wrap::Entry::empty() const
 {
     return uncompressedSize == 0;
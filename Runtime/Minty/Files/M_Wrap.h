@@ -3,6 +3,8 @@
 #include "Minty/Types/M_Object.h"
 #include "Minty/Types/M_Register.h"
 #include "Minty/Tools/M_Compression.h"
+#include "Minty/Files/M_MappedFile.h"
+#include <span>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -18,7 +20,7 @@ namespace Minty
 	constexpr int const WRAP_HEADER_PATH_SIZE = 100;
 	constexpr int const WRAP_HEADER_NAME_SIZE = 50;
 	constexpr int const WRAP_ENTRY_PATH_SIZE = 255;
-	constexpr uint16_t const WRAP_VERSION = 0;
+	constexpr uint16_t const WRAP_VERSION = 1;
 
 	/// <summary>
 	/// Handles dealing with one .wrap file.
@@ -93,20 +95,44 @@ namespace Minty
 			Header& operator=(Header const& other);
 		};
 
+		/// <summary>
+		/// The table of contents information for a .wrap file. Written directly after the Header.
+		/// 
+		/// The table of contents itself (the Entries, sorted by their path hash, followed by the string pool of their paths)
+		/// is stored after all of the file data, so it can be read in one read.
+		/// </summary>
+		struct Table
+		{
+			/// <summary>
+			/// The offset to the table of contents within the Wrap file.
+			/// </summary>
+			uint32_t offset = 0;
+
+			/// <summary>
+			/// The size of the string pool, in bytes.
+			/// </summary>
+			uint32_t stringsSize = 0;
+		};
+
 		/// <summary>
 		/// The entry information for a virtual file that is stored within the .wrap file.
 		/// </summary>
 		struct Entry
 		{
 			/// <summary>
-			/// The path to this Entry within the Wrap file.
+			/// The hash of the full path (base path included) to this Entry within the Wrap file.
 			/// </summary>
-			char path[WRAP_ENTRY_PATH_SIZE] = "";
+			uint64_t hash = 0;
 
 			/// <summary>
-			/// The compression level of this data in the Wrap file.
+			/// The offset to the path of this Entry within the string pool. The path is relative to the base path.
 			/// </summary>
-			Byte compressionLevel = 0;
+			uint32_t pathOffset = 0;
+
+			/// <summary>
+			/// The length of the path of this Entry, not including the null terminator.
+			/// </summary>
+			uint32_t pathSize = 0;
 
 			/// <summary>
 			/// The reserved size of the data within the Wrap file.
@@ -128,15 +154,73 @@ namespace Minty
 			/// </summary>
 			uint32_t offset = 0;
 
-			Entry();
+			/// <summary>
+			/// The compression level of this data in the Wrap file.
+			/// </summary>
+			Byte compressionLevel = 0;
 
-			Entry(Entry const& other);
+			/// <summary>
+			/// The CompressionCodec used to compress this data, if it is compressed.
+			/// </summary>
+			Byte codec = static_cast<Byte>(CompressionCodec::Zlib);
 
-			Entry& operator=(Entry const& other);
+			/// <summary>
+			/// Unused. Reserved for future use.
+			/// </summary>
+			Byte unused[6] = {};
 
 			bool empty() const;
 		};
 
+		/// <summary>
+		/// A file on the disk to add to a Wrap file.
+		/// </summary>
+		struct Source
+		{
+			/// <summary>
+			/// The path to the file to read and add to the Wrap file.
+			/// </summary>
+			Path physicalPath;
+
+			/// <summary>
+			/// The path of the file within the Wrap file.
+			/// </summary>
+			Path virtualPath;
+
+			/// <summary>
+			/// The level of compression for the file.
+			/// </summary>
+			CompressionLevel compression = CompressionLevel::Default;
+
+			/// <summary>
+			/// The codec to compress the file with, if it is compressed.
+			/// </summary>
+			CompressionCodec codec = CompressionCodec::Zlib;
+
+			/// <summary>
+			/// The reserved size of the chunk to store the file within. If 0, it will default to the size of the stored file.
+			/// </summary>
+			uint32_t reservedSize = 0;
+		};
+
+	private:
+		// the entry information for a virtual file within a version 0 .wrap file
+		struct LegacyEntry
+		{
+			char path[WRAP_ENTRY_PATH_SIZE] = "";
+			Byte compressionLevel = 0;
+			uint32_t reservedSize = 0;
+			uint32_t compressedSize = 0;
+			uint32_t uncompressedSize = 0;
+			uint32_t offset = 0;
+		};
+
+	public:
+		/// <summary>
+		/// The index returned when an Entry could not be found.
+		/// </summary>
+		static constexpr size_t const INVALID_INDEX = static_cast<size_t>(-1);
+
 	private:
 		// path to the wrap file on the disk
 		Path _path;
@@ -144,12 +228,17 @@ namespace Minty
 		// header in the wrap file
 		Header _header;
 
-		// list of entries in the wrap file
+		// table of contents information in the wrap file
+		Table _table;
+
+		// list of entries in the wrap file, sorted by their hash
 		std::vector<Entry> _entries;
-		// list of empty gaps in the wrap file, where files used to be
-		std::unordered_set<uint32_t> _empties;
-		// virtual paths indexed to entry indices
-		std::unordered_map<Path, size_t> _indexed;
+		// pool of null terminated entry paths, relative to the base path
+		std::vector<char> _strings;
+		// the base path, normalized for hashing and comparing paths
+		String _base;
+		// the whole wrap file mapped into memory, shared between copies of this Wrap
+		Owner<MappedFile> _mapped;
 
 	public:
 		/// <summary>
@@ -162,13 +251,14 @@ namespace Minty
 		/// </summary>
 		/// <param name="path">The path to the Wrap file on the disk.</param>
 		Wrap(Path const& path)
-			: _path(), _header(), _entries(), _indexed() { load(path); }
+			: _path(), _header(), _table(), _entries(), _strings(), _base(), _mapped() { load(path); }
 
 		/// <summary>
 		/// Creates a new Wrap file with the given name, base path, and content version.
 		/// </summary>
 		/// <param name="path">The path to the Wrap file on the disk.</param>
 		/// <param name="name">The name of the Wrap file.</param>
+		/// <param name="entryCount">The expected number of entries, used to reserve memory.</param>
 		/// <param name="base">The base path all files within the Wrap file.</param>
 		/// <param name="contentVersion">The version of the content within the Wrap file.</param>
 		Wrap(Path const& path, String const& name, uint32_t const entryCount, Path const& base = "", uint32_t const contentVersion = 0);
@@ -177,22 +267,55 @@ namespace Minty
 		// loads the Wrap file using the _path
 		void load(Path const& path);
 
+		/// <summary>
+		/// Checks if this Wrap file is mapped into memory.
+		/// </summary>
+		/// <returns></returns>
+		bool is_mapped() const;
+
 	private:
-		// writes the header to the file
+		// maps the whole wrap file into memory, replacing the old mapping, if any
+		void map();
+
+		// loads the entries from a version 0 wrap file
+		bool load_legacy(PhysicalFile& wrapFile);
+
+		// loads the table of contents from a version 1 wrap file
+		bool load_table(PhysicalFile& wrapFile);
+
+		// writes the header and table to the file
 		void write_header(PhysicalFile& wrapFile) const;
 
-		// writes the entry at the given index to the file
-		void write_entry(PhysicalFile& wrapFile, size_t const index) const;
+		// writes the entries and string pool to the file, at the table offset
+		void write_table(PhysicalFile& wrapFile) const;
+
+		// sorts the entries by their hash
+		void sort_entries();
+
+		// gets the index of the entry with the given hash and path, or INVALID_INDEX
+		size_t find(uint64_t const hash, Path const& path) const;
 
-		// adds the given entry to _wraps, then returns the index of it
-		uint32_t emplace_entry(Entry& entry);
+		// gets the index of the entry with the given hash and normalized relative path, or INVALID_INDEX
+		size_t find_relative(uint64_t const hash, std::string_view const relative) const;
+
+		// a file that has been read and compressed, and is ready to be written to the wrap file
+		struct PreparedFile
+		{
+			Entry entry;
+			String relative;
+			std::vector<Byte> data;
+			bool valid = false;
+		};
+
+		// reads and compresses the given source, does not modify this Wrap so it can be called from any thread
+		void prepare_file(Source const& source, PreparedFile& file) const;
+
+		// places the prepared file within the wrap file and writes its data, but does not write the table of contents
+		void write_file(PhysicalFile& wrapFile, PreparedFile const& file);
 
 #pragma region Files
 
 	private:
-		// forces the given path to include the base path if it doesn't already
-		Path fix_path(Path const& path) const;
-
 		// forces the given path to be relative to the base path
 		Path relative_path(Path const& path) const;
 
@@ -204,7 +327,17 @@ namespace Minty
 		/// <param name="virtualPath">The path of the file within the Wrap file.</param>
 		/// <param name="compression">The level of compression for the given file.</param>
 		/// <param name="reservedSize">The reserved size of the chunk to store the file within. If the reservedSize is 0, it will default to the size of the file at the physicalPath.</param>
-		void emplace(Path const& physicalPath, Path const& virtualPath, CompressionLevel const compression = CompressionLevel::Default, uint32_t const reservedSize = 0);
+		/// <param name="codec">The codec to compress the given file with.</param>
+		void emplace(Path const& physicalPath, Path const& virtualPath, CompressionLevel const compression = CompressionLevel::Default, uint32_t const reservedSize = 0, CompressionCodec const codec = CompressionCodec::Zlib);
+
+		/// <summary>
+		/// Adds all of the given files to the Wrap.
+		/// 
+		/// The files are read and compressed in parallel, then written in order while the Wrap file is kept open.
+		/// The table of contents is written once, after all of the files.
+		/// </summary>
+		/// <param name="sources">The files to add to the Wrap file.</param>
+		void emplace(std::vector<Source> const& sources);
 
 		/// <summary>
 		/// Checks if the Wrap contains a file with the given path.
@@ -228,6 +361,49 @@ namespace Minty
 		/// <returns>The uncompressed data from the file, or an empty vector if no file found.</returns>
 		std::vector<char> read(Path const& path) const;
 
+		/// <summary>
+		/// Gets a view of the uncompressed data from the file at the given path.
+		/// 
+		/// Uncompressed entries are viewed directly within the mapped Wrap file, without any copying.
+		/// Compressed entries are uncompressed into the given buffer, which is then viewed.
+		/// The view is valid for as long as this Wrap and the buffer are alive and unchanged.
+		/// </summary>
+		/// <param name="path">The path at which to open a file.</param>
+		/// <param name="buffer">The buffer to uncompress into, if needed.</param>
+		/// <returns>A view of the uncompressed data from the file, or an empty view if no file found.</returns>
+		std::span<char const> read_view(Path const& path, std::vector<char>& buffer) const;
+
+		/// <summary>
+		/// Finds the index of the Entry with the given path.
+		/// </summary>
+		/// <param name="path">The path of the file within the Wrap file.</param>
+		/// <returns>The index of the Entry, or INVALID_INDEX if no file found.</returns>
+		size_t find(Path const& path) const;
+
+		/// <summary>
+		/// Checks if the Entry at the given index has the given path.
+		/// </summary>
+		/// <param name="index">The index of the Entry.</param>
+		/// <param name="path">The path to compare against.</param>
+		/// <returns>True if the paths match.</returns>
+		bool matches_entry(size_t const index, Path const& path) const;
+
+		/// <summary>
+		/// Opens the file of the Entry at the given index using the given VirtualFile.
+		/// </summary>
+		/// <param name="index">The index of the Entry.</param>
+		/// <param name="file">The file object to use to open with.</param>
+		/// <returns></returns>
+		bool open_entry(size_t const index, VirtualFile& file) const;
+
+		/// <summary>
+		/// Gets a view of the uncompressed data from the file of the Entry at the given index.
+		/// </summary>
+		/// <param name="index">The index of the Entry.</param>
+		/// <param name="buffer">The buffer to uncompress into, if needed.</param>
+		/// <returns>A view of the uncompressed data from the file, or an empty view if the file could not be read.</returns>
+		std::span<char const> read_entry_view(size_t const index, std::vector<char>& buffer) const;
+
 		/// <summary>
 		/// Gets the Entry at the given index.
 		/// </summary>
@@ -241,6 +417,13 @@ namespace Minty
 		/// <returns></returns>
 		size_t get_entry_count() const;
 
+		/// <summary>
+		/// Gets the path of the Entry at the given index, relative to the base path.
+		/// </summary>
+		/// <param name="index"></param>
+		/// <returns></returns>
+		char const* get_entry_path(size_t const index) const;
+
 		/// <summary>
 		/// Gets the Entry at the given path.
 		/// </summary>
@@ -324,5 +507,21 @@ namespace Minty
 		/// <param name="contentVersion"></param>
 		/// <returns></returns>
 		static Wrap load_or_create(Path const& path, String const& name, uint32_t const entryCount, Path const& base = "", uint32_t const contentVersion = 0);
+
+		/// <summary>
+		/// Hashes the given path, as it would be stored within a Wrap file.
+		/// 
+		/// Both '/' and '\\' are treated as separators, repeated separators are treated as one, and trailing separators are ignored.
+		/// </summary>
+		/// <param name="path">The full path, including the base path.</param>
+		/// <returns></returns>
+		static uint64_t hash_path(Path const& path);
+
+		/// <summary>
+		/// Hashes the given path, as it would be stored within a Wrap file.
+		/// </summary>
+		/// <param name="path">The full path, including the base path.</param>
+		/// <returns></returns>
+		static uint64_t hash_path(std::string_view const path);
 	};
 }
\ No newline at end of file
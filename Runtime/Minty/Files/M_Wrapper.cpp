@@ -7,11 +7,13 @@ using namespace Minty;
 
 Wrapper::Wrapper()
 	: _wraps()
+	, _index()
 {}
 
 void Minty::Wrapper::emplace(Wrap const& wrap)
 {
 	_wraps.push_back(wrap);
+	index_wrap(_wraps.size() - 1);
 }
 
 void Minty::Wrapper::emplace(Path const& path)
@@ -34,32 +36,77 @@ Wrap const& Minty::Wrapper::get_wrap(size_t const index) const
 	return _wraps.at(index);
 }
 
-Wrap* Minty::Wrapper::find_by_path(Path const& path)
+void Minty::Wrapper::reindex()
 {
-	for (Wrap& wrap : _wraps)
+	_index.clear();
+
+	for (size_t i = 0; i < _wraps.size(); i++)
 	{
-		if (wrap.contains(path))
-		{
-			return &wrap;
-		}
+		index_wrap(i);
 	}
+}
 
-	// not found
-	return nullptr;
+void Minty::Wrapper::index_wrap(size_t const wrapIndex)
+{
+	Wrap const& wrap = _wraps.at(wrapIndex);
+
+	_index.reserve(_index.size() + wrap.get_entry_count());
+
+	for (size_t i = 0; i < wrap.get_entry_count(); i++)
+	{
+		// earlier wraps take priority, so do not replace existing paths
+		_index.try_emplace(wrap.get_entry(i).hash, Location{ wrapIndex, i });
+	}
 }
 
-Wrap const* Minty::Wrapper::find_by_path(Path const& path) const
+bool Minty::Wrapper::find_location(Path const& path, Location& location) const
 {
-	for (Wrap const& wrap : _wraps)
+	uint64_t const hash = Wrap::hash_path(path);
+
+	auto found = _index.find(hash);
+
+	if (found == _index.end())
+	{
+		// not found
+		return false;
+	}
+
+	if (_wraps.at(found->second.wrap).matches_entry(found->second.entry, path))
 	{
-		if (wrap.contains(path))
+		location = found->second;
+		return true;
+	}
+
+	// another path has the same hash, so search each wrap instead
+	for (size_t i = 0; i < _wraps.size(); i++)
+	{
+		size_t const index = _wraps.at(i).find(path);
+
+		if (index != Wrap::INVALID_INDEX)
 		{
-			return &wrap;
+			location = Location{ i, index };
+			return true;
 		}
 	}
 
 	// not found
-	return nullptr;
+	return false;
+}
+
+Wrap* Minty::Wrapper::find_by_path(Path const& path)
+{
+	Location location;
+	if (!find_location(path, location)) return nullptr;
+
+	return &_wraps.at(location.wrap);
+}
+
+Wrap const* Minty::Wrapper::find_by_path(Path const& path) const
+{
+	Location location;
+	if (!find_location(path, location)) return nullptr;
+
+	return &_wraps.at(location.wrap);
 }
 
 Wrap* Minty::Wrapper::find_by_name(String const& name)
@@ -92,35 +139,41 @@ Wrap const* Minty::Wrapper::find_by_name(String const& name) const
 
 bool Minty::Wrapper::contains(Path const& path) const
 {
-	for (Wrap const& wrap : _wraps)
-	{
-		if (wrap.contains(path))
-		{
-			return true;
-		}
-	}
-
-	return false;
+	Location location;
+	return find_location(path, location);
 }
 
 bool Minty::Wrapper::open(Path const& path, VirtualFile& file) const
 {
-	// find wrapper
-	Wrap const* wrap = find_by_path(path);
-
-	if (!wrap) return false;
+	// find file
+	Location location;
+	if (!find_location(path, location)) return false;
 
 	// open file
-	return wrap->open(path, file);
+	return _wraps.at(location.wrap).open_entry(location.entry, file);
 }
 
 std::vector<char> Minty::Wrapper::read(Path const& path) const
 {
-	// find wrapper
-	Wrap const* wrap = find_by_path(path);
+	std::vector<char> buffer;
+	std::span<char const> data = read_view(path, buffer);
 
-	if (!wrap) return std::vector<char>();
+	// if the data was read into the buffer, it is already done
+	if (data.data() == buffer.data())
+	{
+		return buffer;
+	}
+
+	// otherwise, copy it out of the mapped file
+	return std::vector<char>(data.begin(), data.end());
+}
+
+std::span<char const> Minty::Wrapper::read_view(Path const& path, std::vector<char>& buffer) const
+{
+	// find file
+	Location location;
+	if (!find_location(path, location)) return std::span<char const>();
 
 	// read file
-	return wrap->read(path);
+	return _wraps.at(location.wrap).read_entry_view(location.entry, buffer);
 }
@@ -11,9 +11,22 @@ namespace Minty
 		: public Object
 	{
 	private:
+		// the location of an Entry within a Wrap
+		struct Location
+		{
+			// index of the Wrap
+			size_t wrap = 0;
+
+			// index of the Entry within the Wrap
+			size_t entry = 0;
+		};
+
 		// all wraps
 		std::vector<Wrap> _wraps;
 
+		// path hashes to the location of their file, across all wraps
+		std::unordered_map<uint64_t, Location> _index;
+
 	public:
 		/// <summary>
 		/// Creates an empty Wrapper.
@@ -49,6 +62,20 @@ namespace Minty
 		/// <returns></returns>
 		Wrap const& get_wrap(size_t const index) const;
 
+		/// <summary>
+		/// Rebuilds the index of every file within every Wrap. Call this after a Wrap within this Wrapper has been modified.
+		/// </summary>
+		void reindex();
+
+	private:
+		// adds the entries of the Wrap at the given index to the index, if they are not already indexed
+		void index_wrap(size_t const wrapIndex);
+
+		// finds the location of the file with the given path, returns true if found
+		bool find_location(Path const& path, Location& location) const;
+
+	public:
+
 		/// <summary>
 		/// Finds the Wrap file that contains the given Path.
 		/// </summary>
@@ -93,5 +120,13 @@ namespace Minty
 		bool open(Path const& path, VirtualFile& file) const;
 
 		std::vector<char> read(Path const& path) const;
+
+		/// <summary>
+		/// Gets a view of the uncompressed data from the file at the given path.
+		/// </summary>
+		/// <param name="path">The path to the file within the Wrapper.</param>
+		/// <param name="buffer">The buffer to uncompress into, if needed.</param>
+		/// <returns>A view of the data, or an empty view if no file found.</returns>
+		std::span<char const> read_view(Path const& path, std::vector<char>& buffer) const;
 	};
 }
\ No newline at end of file
@@ -52,6 +52,11 @@ void Minty::DefaultLayer::on_update(Time const& time)
 	RenderEngine::instance().render_frame();
 }
 
+void Minty::DefaultLayer::on_fixed_update(Time const& time)
+{
+	_sceneManager.fixed_update(time);
+}
+
 void Minty::DefaultLayer::on_event(Event& event)
 {
 	// these events are always called
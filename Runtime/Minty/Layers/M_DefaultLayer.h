@@ -24,6 +24,7 @@ namespace Minty
 		void on_attach() override;
 		void on_detach() override;
 		void on_update(Time const& time) override;
+		void on_fixed_update(Time const& time) override;
 		void on_event(Event& event) override;
 	};
 }
\ No newline at end of file
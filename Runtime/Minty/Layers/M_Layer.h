@@ -15,6 +15,7 @@ namespace Minty
 		virtual void on_attach() {}
 		virtual void on_detach() {}
 		virtual void on_update(Time const& time) {}
+		virtual void on_fixed_update(Time const& time) {}
 		virtual void on_event(Event& event) {}
 	};
 
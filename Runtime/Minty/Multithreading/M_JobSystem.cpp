@@ -0,0 +1,475 @@
+#include "pch.h"
+#include "Minty/Multithreading/M_JobSystem.h"
+
+#include <chrono>
+
+using namespace Minty;
+
+// the index of the worker running on this thread, or INVALID_WORKER if this thread is not a worker
+static size_t constexpr INVALID_WORKER = static_cast<size_t>(-1);
+static thread_local JobSystem const* _workerSystem = nullptr;
+static thread_local size_t _workerIndex = INVALID_WORKER;
+
+Minty::JobSystem::JobSystem(size_t const threadCount)
+	: _queues()
+	, _shared()
+	, _threads()
+	, _dedicated()
+	, _dedicatedMutex()
+	, _queued(0)
+	, _sleepMutex()
+	, _sleepCondition()
+	, _running(true)
+{
+	size_t count = threadCount;
+	if (!count)
+	{
+		// leave one hardware thread for the main thread
+		size_t const hardwareCount = static_cast<size_t>(std::thread::hardware_concurrency());
+		count = hardwareCount > 1 ? hardwareCount - 1 : 1;
+	}
+
+	// create all queues before any worker can try to steal from them
+	_queues.reserve(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		_queues.push_back(std::make_unique<Queue>());
+	}
+
+	_threads.reserve(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		_threads.emplace_back(&JobSystem::run, this, i);
+	}
+}
+
+Minty::JobSystem::~JobSystem()
+{
+	// finish the dedicated jobs first, since they may still queue continuations for the workers
+	while (true)
+	{
+		std::vector<Dedicated> dedicated;
+		{
+			std::lock_guard<std::mutex> lock(_dedicatedMutex);
+			dedicated.swap(_dedicated);
+		}
+
+		if (dedicated.empty()) break;
+
+		for (Dedicated& entry : dedicated)
+		{
+			entry.thread.join();
+		}
+	}
+
+	// stop all workers, after they finish the remaining jobs
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_running = false;
+	}
+	_sleepCondition.notify_all();
+
+	for (std::thread& thread : _threads)
+	{
+		thread.join();
+	}
+}
+
+JobHandle Minty::JobSystem::schedule(JobFunc const& func)
+{
+	return schedule(func, {}, false);
+}
+
+JobHandle Minty::JobSystem::schedule(JobFunc const& func, std::vector<JobHandle> const& dependencies)
+{
+	return schedule(func, dependencies, false);
+}
+
+JobHandle Minty::JobSystem::then(JobHandle const& handle, JobFunc const& func)
+{
+	return schedule(func, { handle });
+}
+
+JobHandle Minty::JobSystem::schedule_dedicated(JobFunc const& func)
+{
+	return schedule(func, {}, true);
+}
+
+JobHandle Minty::JobSystem::schedule_dedicated(JobFunc const& func, std::vector<JobHandle> const& dependencies)
+{
+	return schedule(func, dependencies, true);
+}
+
+JobHandle Minty::JobSystem::schedule(JobFunc const& func, std::vector<JobHandle> const& dependencies, bool const dedicated)
+{
+	std::shared_ptr<Job> job = std::make_shared<Job>();
+	job->func = func;
+	job->dedicated = dedicated;
+
+	// dedicated jobs start out claimed, so no waiter or worker ever runs them
+	job->taken = dedicated;
+
+	// hold one extra dependency while registering, so the job cannot be queued early
+	job->dependencies = dependencies.size() + 1;
+
+	size_t finished = 1;
+	for (JobHandle const& dependency : dependencies)
+	{
+		if (!dependency._job)
+		{
+			finished++;
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(dependency._job->mutex);
+
+		if (dependency._job->done)
+		{
+			finished++;
+		}
+		else
+		{
+			dependency._job->continuations.push_back(job);
+			job->prerequisites.push_back(dependency._job);
+		}
+	}
+
+	// queue now if all of the dependencies have already finished
+	if (job->dependencies.fetch_sub(finished, std::memory_order_acq_rel) == finished)
+	{
+		push(job);
+	}
+
+	return JobHandle(job);
+}
+
+void Minty::JobSystem::wait(JobHandle const& handle)
+{
+	while (!handle.done())
+	{
+		// help with this job, or the jobs it depends on, instead of blocking
+		// unrelated jobs are left alone, since they could take much longer than this one
+		if (!help(*handle._job))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void Minty::JobSystem::wait(std::vector<JobHandle> const& handles)
+{
+	size_t first = 0;
+	while (first < handles.size())
+	{
+		if (handles.at(first).done())
+		{
+			first++;
+			continue;
+		}
+
+		// help with any of the remaining jobs, so one running elsewhere does not hold up the rest
+		bool helped = false;
+		for (size_t i = first; i < handles.size() && !helped; i++)
+		{
+			JobHandle const& handle = handles.at(i);
+			helped = !handle.done() && help(*handle._job);
+		}
+
+		if (!helped)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool Minty::JobSystem::wait_for(JobHandle const& handle, float const seconds)
+{
+	auto const end = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(seconds));
+
+	while (!handle.done() && std::chrono::steady_clock::now() < end)
+	{
+		if (!help(*handle._job))
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	return handle.done();
+}
+
+void Minty::JobSystem::parallel_for(size_t const begin, size_t const end, std::function<void(size_t const)> const& func, size_t const grainSize)
+{
+	if (begin >= end) return;
+
+	size_t const count = end - begin;
+
+	// split evenly between a few jobs per worker, so the workers can balance the load by stealing
+	size_t grain = grainSize;
+	if (!grain)
+	{
+		size_t const jobCount = (_threads.size() + 1) * 4;
+		grain = (count + jobCount - 1) / jobCount;
+	}
+
+	if (grain >= count)
+	{
+		// not worth splitting
+		for (size_t i = begin; i < end; i++)
+		{
+			func(i);
+		}
+		return;
+	}
+
+	std::vector<JobHandle> handles;
+	handles.reserve((count + grain - 1) / grain);
+
+	// queue all but the first chunk, which is ran on this thread
+	for (size_t first = begin + grain; first < end; first += grain)
+	{
+		size_t const last = std::min(first + grain, end);
+
+		handles.push_back(schedule([&func, first, last]()
+			{
+				for (size_t i = first; i < last; i++)
+				{
+					func(i);
+				}
+			}));
+	}
+
+	for (size_t i = begin; i < begin + grain; i++)
+	{
+		func(i);
+	}
+
+	wait(handles);
+}
+
+size_t Minty::JobSystem::get_thread_count() const
+{
+	return _threads.size();
+}
+
+void Minty::JobSystem::push(std::shared_ptr<Job> const& job)
+{
+	if (job->dedicated)
+	{
+		// join the threads that have finished, outside of the lock, since a finishing thread may be pushing a dedicated continuation
+		std::vector<Dedicated> finished;
+		{
+			std::lock_guard<std::mutex> lock(_dedicatedMutex);
+
+			for (size_t i = 0; i < _dedicated.size();)
+			{
+				if (_dedicated.at(i).job->done.load(std::memory_order_acquire))
+				{
+					finished.push_back(std::move(_dedicated.at(i)));
+					_dedicated.erase(_dedicated.begin() + i);
+				}
+				else
+				{
+					i++;
+				}
+			}
+
+			_dedicated.push_back(Dedicated
+				{
+					.thread = std::thread([this, job]() { execute(*job); }),
+					.job = job,
+				});
+		}
+
+		for (Dedicated& entry : finished)
+		{
+			entry.thread.join();
+		}
+
+		return;
+	}
+
+	// workers push to their own queue, everything else goes to the shared queue
+	Queue& queue = (_workerSystem == this && _workerIndex != INVALID_WORKER) ? *_queues.at(_workerIndex) : _shared;
+
+	// count the job before it can be seen, so a worker that takes it right away can never drop the count below zero
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_queued++;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(job);
+	}
+
+	_sleepCondition.notify_one();
+}
+
+std::shared_ptr<Job> Minty::JobSystem::pop()
+{
+	while (_queued.load(std::memory_order_acquire))
+	{
+		std::shared_ptr<Job> job = take();
+
+		if (!job) return nullptr;
+
+		// skip jobs that a waiter already claimed and ran
+		if (!job->taken.exchange(true, std::memory_order_acq_rel))
+		{
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+std::shared_ptr<Job> Minty::JobSystem::take()
+{
+	if (!_queued.load(std::memory_order_acquire)) return nullptr;
+
+	std::shared_ptr<Job> job;
+
+	size_t const index = _workerSystem == this ? _workerIndex : INVALID_WORKER;
+
+	// newest from own queue, while its data is still hot
+	if (index != INVALID_WORKER)
+	{
+		Queue& queue = *_queues.at(index);
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+		}
+	}
+
+	// oldest from the shared queue
+	if (!job)
+	{
+		std::lock_guard<std::mutex> lock(_shared.mutex);
+
+		if (!_shared.jobs.empty())
+		{
+			job = std::move(_shared.jobs.front());
+			_shared.jobs.pop_front();
+		}
+	}
+
+	// steal oldest from the other workers, starting with the next one over
+	if (!job)
+	{
+		size_t const count = _queues.size();
+		size_t const start = index == INVALID_WORKER ? 0 : index + 1;
+
+		for (size_t i = 0; i < count && !job; i++)
+		{
+			size_t const other = (start + i) % count;
+			if (other == index) continue;
+
+			Queue& queue = *_queues.at(other);
+			std::lock_guard<std::mutex> lock(queue.mutex);
+
+			if (!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+			}
+		}
+	}
+
+	if (job)
+	{
+		_queued--;
+	}
+
+	return job;
+}
+
+bool Minty::JobSystem::run_one()
+{
+	std::shared_ptr<Job> job = pop();
+
+	if (!job) return false;
+
+	execute(*job);
+
+	return true;
+}
+
+bool Minty::JobSystem::help(Job& job)
+{
+	if (job.done.load(std::memory_order_acquire)) return false;
+
+	// still waiting on other jobs, so help with those first
+	if (job.dependencies.load(std::memory_order_acquire))
+	{
+		for (std::shared_ptr<Job> const& prerequisite : job.prerequisites)
+		{
+			if (help(*prerequisite)) return true;
+		}
+
+		return false;
+	}
+
+	// claim it, unless a worker or another waiter already did
+	if (job.taken.exchange(true, std::memory_order_acq_rel)) return false;
+
+	execute(job);
+
+	return true;
+}
+
+void Minty::JobSystem::execute(Job& job)
+{
+	if (job.func)
+	{
+		job.func();
+	}
+
+	// release the work, since handles may keep the job alive for a while
+	job.func = nullptr;
+
+	// mark as done, and take the continuations, so no more can be added
+	std::vector<std::shared_ptr<Job>> continuations;
+	{
+		std::lock_guard<std::mutex> lock(job.mutex);
+		job.done.store(true, std::memory_order_release);
+		continuations.swap(job.continuations);
+	}
+
+	// queue the continuations that are no longer waiting on anything
+	for (std::shared_ptr<Job> const& continuation : continuations)
+	{
+		if (continuation->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			push(continuation);
+		}
+	}
+}
+
+void Minty::JobSystem::run(size_t const index)
+{
+	_workerSystem = this;
+	_workerIndex = index;
+
+	while (true)
+	{
+		if (run_one()) continue;
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+		_sleepCondition.wait(lock, [this]() { return !_running || _queued.load() > 0; });
+
+		if (!_running && !_queued.load())
+		{
+			// stopped, and nothing left to do
+			return;
+		}
+	}
+}
+
+JobSystem& Minty::JobSystem::instance()
+{
+	static JobSystem jobSystem;
+	return jobSystem;
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "Minty/Types/M_Object.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Minty
+{
+	/// <summary>
+	/// The work done by a Job.
+	/// </summary>
+	typedef std::function<void()> JobFunc;
+
+	/// <summary>
+	/// One unit of work scheduled on the JobSystem.
+	/// </summary>
+	struct Job
+	{
+		/// <summary>
+		/// The work to do.
+		/// </summary>
+		JobFunc func;
+
+		/// <summary>
+		/// The number of dependencies that have not finished yet. The Job is queued once this reaches zero.
+		/// </summary>
+		std::atomic<size_t> dependencies = 0;
+
+		/// <summary>
+		/// True once the work has been done.
+		/// </summary>
+		std::atomic<bool> done = false;
+
+		// true once a thread has claimed the work, so it is only ran once
+		// the Job may still sit in a queue after a waiter claims it, and is skipped when popped
+		std::atomic<bool> taken = false;
+
+		// true if the Job runs on its own thread, instead of on a worker
+		bool dedicated = false;
+
+		// guards continuations, and finishing
+		std::mutex mutex;
+
+		// jobs that depend on this Job
+		std::vector<std::shared_ptr<Job>> continuations;
+
+		// jobs that this Job depends on, that had not finished when it was scheduled, so waiters can help with them
+		std::vector<std::shared_ptr<Job>> prerequisites;
+	};
+
+	/// <summary>
+	/// A lightweight handle to a Job scheduled on the JobSystem.
+	/// </summary>
+	class JobHandle
+	{
+		friend class JobSystem;
+
+	private:
+		std::shared_ptr<Job> _job;
+
+	public:
+		JobHandle() = default;
+
+		JobHandle(std::shared_ptr<Job> const& job)
+			: _job(job) {}
+
+		/// <summary>
+		/// Checks if this handle refers to a Job.
+		/// </summary>
+		/// <returns></returns>
+		bool valid() const { return _job != nullptr; }
+
+		/// <summary>
+		/// Checks if the Job has finished. Invalid handles are always done.
+		/// </summary>
+		/// <returns></returns>
+		bool done() const { return !_job || _job->done.load(std::memory_order_acquire); }
+	};
+
+	/// <summary>
+	/// Runs Jobs on a fixed pool of worker threads, one per core.
+	/// 
+	/// Each worker has its own queue. Workers run their newest Jobs first, and steal the oldest Jobs from other workers when they run out.
+	/// Threads that wait on a Job help run that Job and the Jobs it depends on instead of blocking, but never unrelated Jobs.
+	/// Long running work should be scheduled with schedule_dedicated, so it never ties up a worker or a waiting thread.
+	/// </summary>
+	class JobSystem
+		: public Object
+	{
+	private:
+		// a queue of jobs, owned by one worker
+		struct Queue
+		{
+			std::deque<std::shared_ptr<Job>> jobs;
+			std::mutex mutex;
+		};
+
+		// one queue per worker
+		std::vector<std::unique_ptr<Queue>> _queues;
+		// queue for jobs scheduled from threads that are not workers
+		Queue _shared;
+
+		// worker threads
+		std::vector<std::thread> _threads;
+
+		// a thread running one dedicated job
+		struct Dedicated
+		{
+			std::thread thread;
+			std::shared_ptr<Job> job;
+		};
+
+		// threads running dedicated jobs, joined once their job is done
+		std::vector<Dedicated> _dedicated;
+		std::mutex _dedicatedMutex;
+
+		// the number of jobs that are queued, or about to be, but not taken yet
+		std::atomic<size_t> _queued;
+
+		// sleeping workers wait on this when there is nothing to do
+		std::mutex _sleepMutex;
+		std::condition_variable _sleepCondition;
+
+		// false when the workers should stop
+		std::atomic<bool> _running;
+
+	public:
+		/// <summary>
+		/// Creates a new JobSystem.
+		/// </summary>
+		/// <param name="threadCount">The number of worker threads. If 0, one less than the number of hardware threads is used, with a minimum of 1.</param>
+		JobSystem(size_t const threadCount = 0);
+
+		~JobSystem();
+
+		JobSystem(JobSystem const& other) = delete;
+
+		JobSystem& operator=(JobSystem const& other) = delete;
+
+		/// <summary>
+		/// Schedules the given work to be ran on a worker thread.
+		/// </summary>
+		/// <param name="func">The work to do.</param>
+		/// <returns>A handle to the Job.</returns>
+		JobHandle schedule(JobFunc const& func);
+
+		/// <summary>
+		/// Schedules the given work to be ran on a worker thread, once all of the given dependencies have finished.
+		/// </summary>
+		/// <param name="func">The work to do.</param>
+		/// <param name="dependencies">The Jobs that must finish first.</param>
+		/// <returns>A handle to the Job.</returns>
+		JobHandle schedule(JobFunc const& func, std::vector<JobHandle> const& dependencies);
+
+		/// <summary>
+		/// Schedules the given work to be ran as a continuation, once the given Job has finished.
+		/// </summary>
+		/// <param name="handle">The Job that must finish first.</param>
+		/// <param name="func">The work to do.</param>
+		/// <returns>A handle to the continuation Job.</returns>
+		JobHandle then(JobHandle const& handle, JobFunc const& func);
+
+		/// <summary>
+		/// Schedules the given long running work to be ran on its own thread, instead of on a worker thread.
+		/// Waiting threads never run dedicated work themselves, so waiting on other Jobs is never held up by it.
+		/// </summary>
+		/// <param name="func">The work to do.</param>
+		/// <returns>A handle to the Job.</returns>
+		JobHandle schedule_dedicated(JobFunc const& func);
+
+		/// <summary>
+		/// Schedules the given long running work to be ran on its own thread, once all of the given dependencies have finished.
+		/// </summary>
+		/// <param name="func">The work to do.</param>
+		/// <param name="dependencies">The Jobs that must finish first.</param>
+		/// <returns>A handle to the Job.</returns>
+		JobHandle schedule_dedicated(JobFunc const& func, std::vector<JobHandle> const& dependencies);
+
+		/// <summary>
+		/// Waits for the given Job to finish. Runs the Job, and any Jobs it depends on, while waiting.
+		/// </summary>
+		/// <param name="handle"></param>
+		void wait(JobHandle const& handle);
+
+		/// <summary>
+		/// Waits for all of the given Jobs to finish. Runs the Jobs, and any Jobs they depend on, while waiting.
+		/// </summary>
+		/// <param name="handles"></param>
+		void wait(std::vector<JobHandle> const& handles);
+
+		/// <summary>
+		/// Waits for the given Job to finish, for up to the given number of seconds. Runs the Job, and any Jobs it depends on, while waiting.
+		/// </summary>
+		/// <param name="handle"></param>
+		/// <param name="seconds"></param>
+		/// <returns>True if the Job finished in time.</returns>
+		bool wait_for(JobHandle const& handle, float const seconds);
+
+		/// <summary>
+		/// Calls the given function for each index in [begin, end), split into Jobs, then waits for them all to finish.
+		/// The calling thread runs any chunks that no worker has taken yet.
+		/// </summary>
+		/// <param name="begin">The first index.</param>
+		/// <param name="end">One past the last index.</param>
+		/// <param name="func">The function to call with each index.</param>
+		/// <param name="grainSize">The number of indices per Job. If 0, the range is split evenly between a few Jobs per worker.</param>
+		void parallel_for(size_t const begin, size_t const end, std::function<void(size_t const)> const& func, size_t const grainSize = 0);
+
+		/// <summary>
+		/// Gets the number of worker threads.
+		/// </summary>
+		/// <returns></returns>
+		size_t get_thread_count() const;
+
+	private:
+		// creates a job, and queues it once all of the given dependencies have finished
+		JobHandle schedule(JobFunc const& func, std::vector<JobHandle> const& dependencies, bool const dedicated);
+
+		// adds the job to a queue, so it can be ran, or starts its own thread if it is dedicated
+		void push(std::shared_ptr<Job> const& job);
+
+		// takes the next job to run that no waiter has claimed yet
+		std::shared_ptr<Job> pop();
+
+		// removes the next job from a queue: from this worker's queue, the shared queue, or another worker's queue
+		std::shared_ptr<Job> take();
+
+		// runs one job, if any, returns true if a job was ran
+		bool run_one();
+
+		// runs the given job, or one of the jobs it depends on, if one is ready and not taken yet, returns true if a job was ran
+		bool help(Job& job);
+
+		// runs the given job, then queues any continuations that are ready
+		void execute(Job& job);
+
+		// the loop for a worker thread
+		void run(size_t const index);
+
+	public:
+		/// <summary>
+		/// Gets the JobSystem used by the engine.
+		/// </summary>
+		/// <returns></returns>
+		static JobSystem& instance();
+	};
+}
\ No newline at end of file
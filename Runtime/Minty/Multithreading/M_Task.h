@@ -1,22 +1,26 @@
 #pragma once
 
 #include "Minty/Core/M_Base.h"
+#include "Minty/Multithreading/M_JobSystem.h"
 #include <vector>
 #include <unordered_map>
 #include <future>
 #include <functional>
 #include <chrono>
+#include <memory>
 
 namespace Minty
 {
 	/// <summary>
-	/// Represents one Task, which is an operation of data on another thread.
+	/// Represents one Task, which is a long running operation on its own thread, such as building a project.
+	/// Short work that should share the worker threads belongs in a Job instead.
 	/// </summary>
 	/// <typeparam name="T"></typeparam>
 	template<typename T>
 	class Task
 	{
 	private:
+		JobHandle job;
 		std::future<T> task;
 
 	public:
@@ -26,7 +30,21 @@ namespace Minty
 		/// <param name="func"></param>
 		Task(std::function<T()> const& func)
 		{
-			task = std::async(std::launch::async, func);
+			std::shared_ptr<std::packaged_task<T()>> packaged = std::make_shared<std::packaged_task<T()>>(func);
+			task = packaged->get_future();
+			job = JobSystem::instance().schedule_dedicated([packaged]() { (*packaged)(); });
+		}
+
+		/// <summary>
+		/// Creates a new Task with the given functionality, which starts once all of the given Jobs have finished.
+		/// </summary>
+		/// <param name="func"></param>
+		/// <param name="dependencies"></param>
+		Task(std::function<T()> const& func, std::vector<JobHandle> const& dependencies)
+		{
+			std::shared_ptr<std::packaged_task<T()>> packaged = std::make_shared<std::packaged_task<T()>>(func);
+			task = packaged->get_future();
+			job = JobSystem::instance().schedule_dedicated([packaged]() { (*packaged)(); }, dependencies);
 		}
 
 		/// <summary>
@@ -39,20 +57,21 @@ namespace Minty
 		}
 
 		/// <summary>
-		/// Gets the value of this Task.
+		/// Gets the value of this Task. Runs the Jobs it depends on while waiting.
 		/// </summary>
 		/// <returns></returns>
 		T get()
 		{
+			wait();
 			return task.get();
 		}
 
 		/// <summary>
-		/// Waits for this Task to be complete.
+		/// Waits for this Task to be complete. Runs the Jobs it depends on while waiting.
 		/// </summary>
 		void wait()
 		{
-			task.wait();
+			JobSystem::instance().wait(job);
 		}
 
 		/// <summary>
@@ -61,17 +80,26 @@ namespace Minty
 		/// <returns></returns>
 		bool done()
 		{
-			return wait_for(0.0f);
+			return job.done();
 		}
 
 		/// <summary>
-		/// Waits X seconds for the task to be completed.
+		/// Waits X seconds for the task to be completed. Runs the Jobs it depends on while waiting.
 		/// </summary>
 		/// <param name="seconds"></param>
 		/// <returns>True if the task was completed in time, otherwise false.</returns>
 		bool wait_for(float const seconds)
 		{
-			return task.wait_for(std::chrono::duration<float>(seconds)) == std::future_status::ready;
+			return JobSystem::instance().wait_for(job, seconds);
+		}
+
+		/// <summary>
+		/// Gets the handle to the Job running this Task, so other Jobs can depend on it.
+		/// </summary>
+		/// <returns></returns>
+		JobHandle const& get_job() const
+		{
+			return job;
 		}
 	};
 
@@ -143,14 +171,28 @@ namespace Minty
 		}
 
 		/// <summary>
-		/// Waits for all Tasks within this TaskGroup to finish.
+		/// Waits for all Tasks within this TaskGroup to finish. Runs the Jobs they depend on while waiting.
 		/// </summary>
 		void wait()
 		{
-			for (auto& task : tasks)
+			JobSystem::instance().wait(get_jobs());
+		}
+
+		/// <summary>
+		/// Gets the handles to the Jobs running each Task within this TaskGroup, so other Jobs can depend on them.
+		/// </summary>
+		/// <returns></returns>
+		std::vector<JobHandle> get_jobs() const
+		{
+			std::vector<JobHandle> jobs;
+			jobs.reserve(tasks.size());
+
+			for (auto const& task : tasks)
 			{
-				task.wait();
+				jobs.push_back(task.get_job());
 			}
+
+			return jobs;
 		}
 
 		/// <summary>
@@ -15,9 +15,8 @@ void Minty::Buffer::destroy()
 	RenderEngine& renderEngine = RenderEngine::instance();
 
 	vkDestroyBuffer(renderEngine.get_device(), _buffer, nullptr);
-	vkFreeMemory(renderEngine.get_device(), _memory, nullptr);
+	renderEngine.get_memory_allocator().free(_allocation);
 
 	_buffer = VK_NULL_HANDLE;
-	_memory = VK_NULL_HANDLE;
 	_size = 0;
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "Minty/Assets/M_Asset.h"
 
+#include "Minty/Rendering/M_MemoryAllocator.h"
 #include "Minty/Libraries/M_Vulkan.h"
 
 namespace Minty
@@ -9,7 +10,7 @@ namespace Minty
 	{
 		UUID id = UUID::create();
 		VkBuffer buffer;
-		VkDeviceMemory memory;
+		MemoryAllocation allocation;
 		VkDeviceSize size;
 	};
 
@@ -22,14 +23,14 @@ namespace Minty
 		// TODO: make private, move buffer functions to this class
 	private:
 		VkBuffer _buffer;
-		VkDeviceMemory _memory;
+		MemoryAllocation _allocation;
 		VkDeviceSize _size;
 
 	public:
 		Buffer() = default;
 
 		Buffer(BufferBuilder const& builder)
-			: Asset(builder.id, ""), _buffer(builder.buffer), _memory(builder.memory), _size(builder.size) {}
+			: Asset(builder.id, ""), _buffer(builder.buffer), _allocation(builder.allocation), _size(builder.size) {}
 
 		~Buffer();
 
@@ -38,7 +39,13 @@ namespace Minty
 
 		VkBuffer get_buffer() const { return _buffer; }
 
-		VkDeviceMemory get_memory() const { return _memory; }
+		VkDeviceMemory get_memory() const { return _allocation.memory; }
+
+		/// <summary>
+		/// Gets the range of device memory that this Buffer is bound to.
+		/// </summary>
+		/// <returns></returns>
+		MemoryAllocation const& get_allocation() const { return _allocation; }
 
 		VkDeviceSize get_size() const { return _size; }
 	};
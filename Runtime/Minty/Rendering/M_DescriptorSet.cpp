@@ -17,12 +17,15 @@ Minty::DescriptorSet::DescriptorSet(DescriptorSetBuilder const& builder)
 	, _descriptorSets(builder.descriptorSets)
 	, _descriptors(builder.datas)
 	, _dirties()
+	, _dynamics()
 {
 	// dirty all frames on the start so that they can all be set
 	for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
 	{
 		_dirties.emplace(i);
 	}
+
+	find_dynamics();
 }
 
 DescriptorSet& Minty::DescriptorSet::operator=(DescriptorSet const& other)
@@ -31,6 +34,7 @@ DescriptorSet& Minty::DescriptorSet::operator=(DescriptorSet const& other)
 	{
 		_descriptorSets = other._descriptorSets;
 		_descriptors = other._descriptors;
+		_dynamics = other._dynamics;
 	}
 
 	return *this;
@@ -74,6 +78,7 @@ void Minty::DescriptorSet::destroy()
 	_set = 0;
 	_descriptors.clear();
 	_dirties.clear();
+	_dynamics.clear();
 }
 
 void Minty::DescriptorSet::set(String const& name, void const* const value)
@@ -153,6 +158,9 @@ void Minty::DescriptorSet::apply(int const frame)
 	std::vector<VkDescriptorBufferInfo> bufferInfos;
 	std::vector<std::vector<VkDescriptorImageInfo>> imageInfos;
 
+	// the writes point into bufferInfos, so it must never reallocate while they are being filled
+	bufferInfos.reserve(_descriptors.size());
+
 	RenderEngine& renderer = RenderEngine::instance();
 	AssetEngine& assets = AssetEngine::instance();
 	RenderSystem* renderSystem = get_render_system();
@@ -206,6 +214,39 @@ void Minty::DescriptorSet::apply(int const frame)
 
 			break;
 		}
+		case VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+		{
+			// add buffer info(s)
+			bufferInfos.push_back(VkDescriptorBufferInfo());
+
+			// point at the upload ring, the offset is given when bound
+			VkDescriptorBufferInfo& bufferInfo = bufferInfos.back();
+			bufferInfo.buffer = renderer.get_upload_ring().get_buffer();
+			bufferInfo.offset = 0;
+			bufferInfo.range = static_cast<VkDeviceSize>(data.values.size());
+
+			// add buffer info to write
+			write.pBufferInfo = &bufferInfo;
+
+			break;
+		}
+		case VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+		{
+			// add buffer info(s)
+			bufferInfos.push_back(VkDescriptorBufferInfo());
+
+			// set buffer info, using the whole buffer
+			Ref<Buffer> buffer = assets.at<Buffer>(data.ids.at(0));
+			VkDescriptorBufferInfo& bufferInfo = bufferInfos.back();
+			bufferInfo.buffer = buffer->get_buffer();
+			bufferInfo.offset = 0;
+			bufferInfo.range = buffer->get_size();
+
+			// add buffer info to write
+			write.pBufferInfo = &bufferInfo;
+
+			break;
+		}
 		case VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
 		{
 			// create image info descriptor(s)
@@ -286,7 +327,43 @@ void Minty::DescriptorSet::set_descriptor(DescriptorData& data, int const frame,
 
 		// set buffer
 		RenderEngine& renderer = RenderEngine::instance();
-		renderer.set_buffer(buffer, value, size, offset);
+		renderer.set_buffer(buffer, value, size ? size : buffer->get_size() - offset, offset);
+
+		break;
+	}
+	case VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+	{
+		// set values, they are copied to the upload ring when next bound
+		VkDeviceSize valuesSize = static_cast<VkDeviceSize>(data.values.size());
+		VkDeviceSize setSize = size ? size : valuesSize - offset;
+
+		if (offset + setSize > valuesSize)
+		{
+			MINTY_ERROR_FORMAT("Cannot set {} bytes at offset {} of a dynamic uniform buffer with a size of {}.", setSize, offset, valuesSize);
+			return;
+		}
+
+		memcpy(data.values.data() + offset, value, static_cast<size_t>(setSize));
+		data.uploadSerial = 0;
+
+		break;
+	}
+	case VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+	{
+		// assume the input for this was the ID of the buffer to use
+		UUID bufferId = *static_cast<UUID const*>(value);
+
+		// same buffer, nothing to write
+		if (!data.empty && data.ids.size() == 1 && data.ids.front() == bufferId)
+		{
+			return;
+		}
+
+		data.ids.resize(1);
+		data.ids[0] = bufferId;
+
+		// mark set as dirty
+		_dirties.emplace(frame);
 
 		break;
 	}
@@ -339,6 +416,14 @@ bool Minty::DescriptorSet::get(String const& name, int const frame, void* const
 
 		return true;
 	}
+	case VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+	{
+		// copy out the latest values
+		std::vector<Byte> const& values = found->second.at(frame).values;
+		memcpy(out, values.data(), values.size());
+
+		return true;
+	}
 	case VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
 	{
 		// do nothing
@@ -360,6 +445,60 @@ std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> const& Minty::DescriptorSet::d
 	return _descriptorSets;
 }
 
+void Minty::DescriptorSet::get_dynamic_offsets(int const frame, std::vector<uint32_t>& offsets) const
+{
+	if (_dynamics.empty()) return;
+
+	RenderEngine& renderer = RenderEngine::instance();
+	uint64_t serial = renderer.get_upload_ring().get_serial();
+
+	for (String const& name : _dynamics)
+	{
+		DescriptorData const& data = _descriptors.at(name).at(frame);
+
+		// copy to the ring if changed, or if the copy from a previous frame may have been reused
+		if (data.uploadSerial != serial)
+		{
+			RingAllocation allocation = renderer.upload_uniform(data.values.data(), static_cast<VkDeviceSize>(data.values.size()));
+
+			// if it did not fit, keep the last offset, which is still within the ring
+			if (allocation.buffer)
+			{
+				data.dynamicOffset = static_cast<uint32_t>(allocation.offset);
+			}
+			data.uploadSerial = serial;
+		}
+
+		offsets.push_back(data.dynamicOffset);
+	}
+}
+
+void Minty::DescriptorSet::find_dynamics()
+{
+	_dynamics.clear();
+
+	std::vector<std::pair<uint32_t, String>> dynamics;
+
+	for (auto const& [name, datas] : _descriptors)
+	{
+		DescriptorData const& data = datas.front();
+
+		if (data.type == VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+		{
+			dynamics.push_back({ data.binding, name });
+		}
+	}
+
+	// dynamic offsets are given in binding order
+	std::sort(dynamics.begin(), dynamics.end());
+
+	_dynamics.reserve(dynamics.size());
+	for (auto const& [binding, name] : dynamics)
+	{
+		_dynamics.push_back(name);
+	}
+}
+
 auto Minty::DescriptorSet::begin()
 {
 	return _descriptorSets.begin();
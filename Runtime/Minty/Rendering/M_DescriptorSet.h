@@ -38,6 +38,21 @@ namespace Minty
 		// IDs for buffers, textures, whatever is needed for this Descriptor.
 		/// </summary>
 		std::vector<UUID> ids;
+
+		/// <summary>
+		/// Dynamic uniform buffers: the latest values. They are copied into the upload ring each frame they are bound.
+		/// </summary>
+		std::vector<Byte> values;
+
+		/// <summary>
+		/// Dynamic uniform buffers: the offset of the values within the upload ring.
+		/// </summary>
+		mutable uint32_t dynamicOffset;
+
+		/// <summary>
+		/// Dynamic uniform buffers: the serial of the frame the values were copied into the upload ring for, or 0 if they need to be copied again.
+		/// </summary>
+		mutable uint64_t uploadSerial;
 	};
 
 	struct DescriptorSetBuilder
@@ -72,6 +87,9 @@ namespace Minty
 		// if dirty, when applied, a descriptor write must occur
 		std::unordered_set<int> _dirties;
 
+		// the names of the dynamic uniform buffers, in binding order
+		std::vector<String> _dynamics;
+
 	public:
 		/// <summary>
 		/// Creates an empty DescriptorSet.
@@ -166,6 +184,9 @@ namespace Minty
 		// sets (updates) the given descriptor with the given value data and size for the given frame
 		void set_descriptor(DescriptorData& data, int const frame, void const* const value, VkDeviceSize const size, VkDeviceSize const offset);
 
+		// finds the names of the dynamic uniform buffers, and sorts them by binding
+		void find_dynamics();
+
 #pragma endregion
 
 #pragma region Get
@@ -193,6 +214,14 @@ namespace Minty
 		/// <returns></returns>
 		std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> const& data() const;
 
+		/// <summary>
+		/// Copies the values of the dynamic uniform buffers into the upload ring, if they are not there for the frame being recorded,
+		/// and adds their offsets to the given list, in binding order.
+		/// </summary>
+		/// <param name="frame">The index of the frame within the flight.</param>
+		/// <param name="offsets">The list of dynamic offsets to add to.</param>
+		void get_dynamic_offsets(int const frame, std::vector<uint32_t>& offsets) const;
+
 #pragma endregion
 
 		auto begin();
@@ -0,0 +1,415 @@
+#include "pch.h"
+#include "Minty/Rendering/M_MemoryAllocator.h"
+
+#include "Minty/Tools/M_Console.h"
+
+using namespace Minty;
+
+// rounds the value up to the next multiple of the alignment, which must be a power of two
+static VkDeviceSize align_up(VkDeviceSize const value, VkDeviceSize const alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+float Minty::MemoryStatistics::get_fragmentation() const
+{
+	if (!freeSize) return 0.0f;
+
+	return 1.0f - static_cast<float>(largestFreeSize) / static_cast<float>(freeSize);
+}
+
+String Minty::to_string(MemoryStatistics const& value)
+{
+	return std::format("MemoryStatistics(blocks = {}, allocations = {}, reserved = {}, used = {}, free = {}, largest free = {}, free ranges = {}, fragmentation = {})",
+		value.blockCount, value.allocationCount, value.reservedSize, value.usedSize, value.freeSize, value.largestFreeSize, value.freeRangeCount, value.get_fragmentation());
+}
+
+#pragma region VulkanMemorySource
+
+Minty::VulkanMemorySource::VulkanMemorySource()
+	: _device(VK_NULL_HANDLE)
+{}
+
+Minty::VulkanMemorySource::VulkanMemorySource(VkDevice const device)
+	: _device(device)
+{}
+
+VkDeviceMemory Minty::VulkanMemorySource::allocate_memory(VkDeviceSize const size, uint32_t const memoryTypeIndex)
+{
+	VkMemoryAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	if (vkAllocateMemory(_device, &allocInfo, nullptr, &memory) != VK_SUCCESS)
+	{
+		return VK_NULL_HANDLE;
+	}
+
+	return memory;
+}
+
+void Minty::VulkanMemorySource::free_memory(VkDeviceMemory const memory)
+{
+	vkFreeMemory(_device, memory, nullptr);
+}
+
+void* Minty::VulkanMemorySource::map_memory(VkDeviceMemory const memory, VkDeviceSize const size)
+{
+	void* data = nullptr;
+
+	VK_ASSERT(vkMapMemory(_device, memory, 0, size, 0, &data), "Failed to map device memory block.");
+
+	return data;
+}
+
+void Minty::VulkanMemorySource::unmap_memory(VkDeviceMemory const memory)
+{
+	vkUnmapMemory(_device, memory);
+}
+
+#pragma endregion
+
+#pragma region MemoryBlock
+
+Minty::MemoryBlock::MemoryBlock(VkDeviceMemory const memory, VkDeviceSize const size, MemoryStrategy const strategy, void* const mapped, size_t const pool)
+	: _memory(memory)
+	, _size(size)
+	, _strategy(strategy)
+	, _mapped(mapped)
+	, _pool(pool)
+	, _allocationCount()
+	, _usedSize()
+	, _free()
+	, _top()
+{
+	if (_strategy == MemoryStrategy::FreeList)
+	{
+		// whole block is free
+		_free.emplace(0, _size);
+	}
+}
+
+bool Minty::MemoryBlock::allocate(VkDeviceSize const size, VkDeviceSize const alignment, VkDeviceSize& offset)
+{
+	switch (_strategy)
+	{
+	case MemoryStrategy::FreeList:
+	{
+		// first fit
+		for (auto it = _free.begin(); it != _free.end(); it++)
+		{
+			VkDeviceSize rangeOffset = it->first;
+			VkDeviceSize rangeSize = it->second;
+			VkDeviceSize aligned = align_up(rangeOffset, alignment);
+			VkDeviceSize padding = aligned - rangeOffset;
+
+			if (padding > rangeSize || size > rangeSize - padding) continue;
+
+			// split the range: [padding][allocation][remainder]
+			_free.erase(it);
+
+			if (padding)
+			{
+				_free.emplace(rangeOffset, padding);
+			}
+
+			VkDeviceSize remainder = rangeSize - padding - size;
+			if (remainder)
+			{
+				_free.emplace(aligned + size, remainder);
+			}
+
+			offset = aligned;
+			_allocationCount++;
+			_usedSize += size;
+			return true;
+		}
+
+		return false;
+	}
+	case MemoryStrategy::Linear:
+	{
+		VkDeviceSize aligned = align_up(_top, alignment);
+
+		if (aligned > _size || size > _size - aligned) return false;
+
+		_top = aligned + size;
+
+		offset = aligned;
+		_allocationCount++;
+		_usedSize += size;
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+void Minty::MemoryBlock::free(VkDeviceSize const offset, VkDeviceSize const size)
+{
+	MINTY_ASSERT(_allocationCount > 0);
+
+	_allocationCount--;
+	_usedSize -= size;
+
+	switch (_strategy)
+	{
+	case MemoryStrategy::FreeList:
+	{
+		VkDeviceSize rangeOffset = offset;
+		VkDeviceSize rangeSize = size;
+
+		// merge with the next range, if touching
+		auto next = _free.lower_bound(offset);
+		if (next != _free.end() && next->first == offset + size)
+		{
+			rangeSize += next->second;
+			next = _free.erase(next);
+		}
+
+		// merge with the previous range, if touching
+		if (next != _free.begin())
+		{
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset)
+			{
+				rangeOffset = previous->first;
+				rangeSize += previous->second;
+				_free.erase(previous);
+			}
+		}
+
+		_free.emplace(rangeOffset, rangeSize);
+		break;
+	}
+	case MemoryStrategy::Linear:
+		// space is only reused once everything has been freed
+		if (!_allocationCount)
+		{
+			_top = 0;
+		}
+		break;
+	}
+}
+
+void Minty::MemoryBlock::add_statistics(MemoryStatistics& statistics) const
+{
+	statistics.blockCount++;
+	statistics.allocationCount += _allocationCount;
+	statistics.reservedSize += _size;
+	statistics.usedSize += _usedSize;
+
+	switch (_strategy)
+	{
+	case MemoryStrategy::FreeList:
+		for (auto const& [offset, size] : _free)
+		{
+			statistics.freeSize += size;
+			statistics.largestFreeSize = std::max(statistics.largestFreeSize, size);
+		}
+		statistics.freeRangeCount += _free.size();
+		break;
+	case MemoryStrategy::Linear:
+	{
+		// only the space past the top can be allocated from
+		VkDeviceSize size = _size - _top;
+		if (size)
+		{
+			statistics.freeSize += size;
+			statistics.largestFreeSize = std::max(statistics.largestFreeSize, size);
+			statistics.freeRangeCount++;
+		}
+		break;
+	}
+	}
+}
+
+#pragma endregion
+
+#pragma region MemoryAllocator
+
+Minty::MemoryAllocator::MemoryAllocator()
+	: _source()
+	, _properties()
+	, _pools()
+	, _blockSize(MEMORY_BLOCK_SIZE)
+{}
+
+Minty::MemoryAllocator::~MemoryAllocator()
+{
+	destroy();
+}
+
+void Minty::MemoryAllocator::init(IMemorySource& source, VkPhysicalDeviceMemoryProperties const& properties, VkDeviceSize const blockSize)
+{
+	destroy();
+
+	_source = &source;
+	_properties = properties;
+	_blockSize = blockSize;
+	_pools.resize(get_pool_index(_properties.memoryTypeCount, MemoryResource::Buffer, MemoryStrategy::FreeList));
+}
+
+void Minty::MemoryAllocator::destroy()
+{
+	if (!_source) return;
+
+	for (auto& pool : _pools)
+	{
+		for (auto& block : pool)
+		{
+			if (!block->empty())
+			{
+				MINTY_WARN("Destroying a device memory block with allocations still in use.");
+			}
+
+			destroy_block(*block);
+		}
+	}
+
+	_pools.clear();
+	_source = nullptr;
+}
+
+MemoryAllocation Minty::MemoryAllocator::allocate(VkMemoryRequirements const& requirements, uint32_t const memoryTypeIndex, MemoryResource const resource, MemoryStrategy const strategy)
+{
+	MINTY_ASSERT(_source != nullptr);
+	MINTY_ASSERT(memoryTypeIndex < _properties.memoryTypeCount);
+
+	VkDeviceSize size = requirements.size;
+	VkDeviceSize alignment = std::max<VkDeviceSize>(requirements.alignment, 1);
+	size_t poolIndex = get_pool_index(memoryTypeIndex, resource, strategy);
+	auto& pool = _pools.at(poolIndex);
+
+	MemoryBlock* block = nullptr;
+	VkDeviceSize offset = 0;
+
+	if (size > _blockSize / 2)
+	{
+		// too big to share a block, so give it its own
+		block = create_block(poolIndex, memoryTypeIndex, size, strategy);
+		if (block && !block->allocate(size, alignment, offset))
+		{
+			block = nullptr;
+		}
+	}
+	else
+	{
+		// find a block with room
+		for (auto const& existing : pool)
+		{
+			if (existing->allocate(size, alignment, offset))
+			{
+				block = existing.get();
+				break;
+			}
+		}
+
+		// no room, so make a new block
+		if (!block)
+		{
+			block = create_block(poolIndex, memoryTypeIndex, _blockSize, strategy);
+			if (block && !block->allocate(size, alignment, offset))
+			{
+				block = nullptr;
+			}
+		}
+	}
+
+	if (!block)
+	{
+		MINTY_ERROR_FORMAT("Failed to allocate {} bytes of device memory from memory type {}.", size, memoryTypeIndex);
+		return MemoryAllocation();
+	}
+
+	void* mapped = block->get_mapped();
+
+	return MemoryAllocation
+	{
+		.memory = block->get_memory(),
+		.offset = offset,
+		.size = size,
+		.mapped = mapped ? static_cast<Byte*>(mapped) + offset : nullptr,
+		.block = block,
+	};
+}
+
+void Minty::MemoryAllocator::free(MemoryAllocation& allocation)
+{
+	MemoryBlock* block = allocation.block;
+	VkDeviceSize offset = allocation.offset;
+	VkDeviceSize size = allocation.size;
+
+	allocation = MemoryAllocation();
+
+	// already freed, or the blocks were destroyed
+	if (!block || !_source) return;
+
+	block->free(offset, size);
+
+	if (!block->empty()) return;
+
+	// give empty blocks back to the device, but keep one standard block per pool, so it is not reallocated over and over
+	auto& pool = _pools.at(block->get_pool());
+	if (block->get_size() == _blockSize && pool.size() == 1) return;
+
+	auto found = std::find_if(pool.begin(), pool.end(), [block](std::unique_ptr<MemoryBlock> const& existing) { return existing.get() == block; });
+	MINTY_ASSERT(found != pool.end());
+
+	destroy_block(*block);
+	pool.erase(found);
+}
+
+MemoryStatistics Minty::MemoryAllocator::get_statistics() const
+{
+	MemoryStatistics statistics{};
+
+	for (auto const& pool : _pools)
+	{
+		for (auto const& block : pool)
+		{
+			block->add_statistics(statistics);
+		}
+	}
+
+	return statistics;
+}
+
+size_t Minty::MemoryAllocator::get_pool_index(uint32_t const memoryTypeIndex, MemoryResource const resource, MemoryStrategy const strategy)
+{
+	return (static_cast<size_t>(memoryTypeIndex) * 2 + static_cast<size_t>(resource)) * 2 + static_cast<size_t>(strategy);
+}
+
+MemoryBlock* Minty::MemoryAllocator::create_block(size_t const pool, uint32_t const memoryTypeIndex, VkDeviceSize const size, MemoryStrategy const strategy)
+{
+	VkDeviceMemory memory = _source->allocate_memory(size, memoryTypeIndex);
+
+	if (memory == VK_NULL_HANDLE)
+	{
+		return nullptr;
+	}
+
+	// keep host visible blocks mapped for as long as they live
+	void* mapped = nullptr;
+	if (_properties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+	{
+		mapped = _source->map_memory(memory, size);
+	}
+
+	std::unique_ptr<MemoryBlock>& block = _pools.at(pool).emplace_back(std::make_unique<MemoryBlock>(memory, size, strategy, mapped, pool));
+	return block.get();
+}
+
+void Minty::MemoryAllocator::destroy_block(MemoryBlock& block)
+{
+	if (block.get_mapped())
+	{
+		_source->unmap_memory(block.get_memory());
+	}
+
+	_source->free_memory(block.get_memory());
+}
+
+#pragma endregion
@@ -0,0 +1,329 @@
+#pragma once
+#include "Minty/Types/M_Object.h"
+#include "Minty/Core/M_Constants.h"
+
+#include "Minty/Libraries/M_Vulkan.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Minty
+{
+	class MemoryBlock;
+
+	/// <summary>
+	/// How the space within a block of device memory is handed out.
+	/// </summary>
+	enum class MemoryStrategy
+	{
+		/// <summary>
+		/// Allocations are placed in the first free range that fits them, and can be freed in any order.
+		/// Used for resources that live for a long time, such as meshes and textures.
+		/// </summary>
+		FreeList,
+
+		/// <summary>
+		/// Allocations are placed one after another, and the space is only reused once every allocation in the block has been freed.
+		/// Used for short lived resources, such as staging buffers.
+		/// </summary>
+		Linear,
+	};
+
+	/// <summary>
+	/// The type of resource that device memory is allocated for.
+	/// Buffers and images are kept in separate blocks, so they never need to be spaced apart by the buffer image granularity.
+	/// </summary>
+	enum class MemoryResource
+	{
+		Buffer,
+		Image,
+	};
+
+	/// <summary>
+	/// A range of device memory within a block, owned by a single buffer or image.
+	/// </summary>
+	struct MemoryAllocation
+	{
+		/// <summary>
+		/// The device memory that the range is within.
+		/// </summary>
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+
+		/// <summary>
+		/// The offset of the range within the device memory, in bytes.
+		/// </summary>
+		VkDeviceSize offset = 0;
+
+		/// <summary>
+		/// The size of the range, in bytes.
+		/// </summary>
+		VkDeviceSize size = 0;
+
+		/// <summary>
+		/// The start of the range in host memory, or null if the memory is not host visible.
+		/// </summary>
+		void* mapped = nullptr;
+
+		/// <summary>
+		/// The block the range was allocated from.
+		/// </summary>
+		MemoryBlock* block = nullptr;
+	};
+
+	/// <summary>
+	/// The usage of the device memory within a MemoryAllocator.
+	/// </summary>
+	struct MemoryStatistics
+	{
+		/// <summary>
+		/// The number of blocks allocated from the device.
+		/// </summary>
+		size_t blockCount = 0;
+
+		/// <summary>
+		/// The number of allocations within the blocks.
+		/// </summary>
+		size_t allocationCount = 0;
+
+		/// <summary>
+		/// The total size of the blocks, in bytes.
+		/// </summary>
+		VkDeviceSize reservedSize = 0;
+
+		/// <summary>
+		/// The total size of the allocations, in bytes.
+		/// </summary>
+		VkDeviceSize usedSize = 0;
+
+		/// <summary>
+		/// The total size of the free ranges that can still be allocated from, in bytes.
+		/// </summary>
+		VkDeviceSize freeSize = 0;
+
+		/// <summary>
+		/// The size of the largest free range, in bytes.
+		/// </summary>
+		VkDeviceSize largestFreeSize = 0;
+
+		/// <summary>
+		/// The number of free ranges.
+		/// </summary>
+		size_t freeRangeCount = 0;
+
+		/// <summary>
+		/// Gets how fragmented the free space is, from 0 when it is all in one range, to nearly 1 when it is split into many small ranges.
+		/// </summary>
+		/// <returns></returns>
+		float get_fragmentation() const;
+	};
+
+	String to_string(MemoryStatistics const& value);
+
+	/// <summary>
+	/// Provides the device memory that a MemoryAllocator sub-allocates from.
+	/// The RenderEngine uses Vulkan, but the allocator bookkeeping can be checked against any source, such as a fake device.
+	/// </summary>
+	class IMemorySource
+	{
+	public:
+		virtual ~IMemorySource() {}
+
+		/// <summary>
+		/// Allocates a block of device memory.
+		/// </summary>
+		/// <param name="size">The size of the block, in bytes.</param>
+		/// <param name="memoryTypeIndex">The type of memory to allocate.</param>
+		/// <returns>The device memory, or VK_NULL_HANDLE if it could not be allocated.</returns>
+		virtual VkDeviceMemory allocate_memory(VkDeviceSize const size, uint32_t const memoryTypeIndex) = 0;
+
+		/// <summary>
+		/// Frees a block of device memory.
+		/// </summary>
+		/// <param name="memory"></param>
+		virtual void free_memory(VkDeviceMemory const memory) = 0;
+
+		/// <summary>
+		/// Maps a whole block of host visible device memory.
+		/// </summary>
+		/// <param name="memory"></param>
+		/// <param name="size">The size of the block, in bytes.</param>
+		/// <returns>The start of the block in host memory.</returns>
+		virtual void* map_memory(VkDeviceMemory const memory, VkDeviceSize const size) = 0;
+
+		/// <summary>
+		/// Unmaps a block of device memory.
+		/// </summary>
+		/// <param name="memory"></param>
+		virtual void unmap_memory(VkDeviceMemory const memory) = 0;
+	};
+
+	/// <summary>
+	/// Provides device memory from a Vulkan device.
+	/// </summary>
+	class VulkanMemorySource
+		: public IMemorySource
+	{
+	private:
+		VkDevice _device;
+
+	public:
+		VulkanMemorySource();
+
+		VulkanMemorySource(VkDevice const device);
+
+		VkDeviceMemory allocate_memory(VkDeviceSize const size, uint32_t const memoryTypeIndex) override;
+
+		void free_memory(VkDeviceMemory const memory) override;
+
+		void* map_memory(VkDeviceMemory const memory, VkDeviceSize const size) override;
+
+		void unmap_memory(VkDeviceMemory const memory) override;
+	};
+
+	/// <summary>
+	/// A block of device memory that allocations are placed within.
+	/// Only keeps track of which ranges are used, so it does not call into the device itself.
+	/// </summary>
+	class MemoryBlock
+		: public Object
+	{
+	private:
+		VkDeviceMemory _memory;
+		VkDeviceSize _size;
+		MemoryStrategy _strategy;
+
+		// the start of the block in host memory, or null if it is not host visible
+		void* _mapped;
+
+		// the index of the pool that owns this block
+		size_t _pool;
+
+		// the number of allocations within this block
+		size_t _allocationCount;
+		// the total size of the allocations within this block
+		VkDeviceSize _usedSize;
+
+		// FreeList: the free ranges, by offset -> size, so neighbors can be merged when freed
+		std::map<VkDeviceSize, VkDeviceSize> _free;
+		// Linear: the end of the last allocation
+		VkDeviceSize _top;
+
+	public:
+		MemoryBlock(VkDeviceMemory const memory, VkDeviceSize const size, MemoryStrategy const strategy, void* const mapped, size_t const pool);
+
+		MemoryBlock(MemoryBlock const& other) = delete;
+
+		MemoryBlock& operator=(MemoryBlock const& other) = delete;
+
+		/// <summary>
+		/// Finds space for an allocation within this block.
+		/// </summary>
+		/// <param name="size">The size of the allocation, in bytes.</param>
+		/// <param name="alignment">The alignment of the allocation, in bytes. Must be a power of two.</param>
+		/// <param name="offset">The offset of the allocation within the block, if it fits.</param>
+		/// <returns>True if the allocation fits within this block.</returns>
+		bool allocate(VkDeviceSize const size, VkDeviceSize const alignment, VkDeviceSize& offset);
+
+		/// <summary>
+		/// Frees an allocation that was made within this block.
+		/// </summary>
+		/// <param name="offset">The offset of the allocation.</param>
+		/// <param name="size">The size of the allocation.</param>
+		void free(VkDeviceSize const offset, VkDeviceSize const size);
+
+		/// <summary>
+		/// Checks if this block has no allocations.
+		/// </summary>
+		/// <returns></returns>
+		bool empty() const { return !_allocationCount; }
+
+		VkDeviceMemory get_memory() const { return _memory; }
+
+		VkDeviceSize get_size() const { return _size; }
+
+		void* get_mapped() const { return _mapped; }
+
+		size_t get_pool() const { return _pool; }
+
+		/// <summary>
+		/// Adds the usage of this block to the given statistics.
+		/// </summary>
+		/// <param name="statistics"></param>
+		void add_statistics(MemoryStatistics& statistics) const;
+	};
+
+	/// <summary>
+	/// Sub-allocates buffers and images from large blocks of device memory, so each resource does not need its own device allocation.
+	///
+	/// Each memory type has its own pools of blocks, split by resource and strategy. Host visible blocks are mapped once, for as long as they live.
+	/// Resources larger than half of a block get a block of their own.
+	/// </summary>
+	class MemoryAllocator
+		: public Object
+	{
+	private:
+		IMemorySource* _source;
+		VkPhysicalDeviceMemoryProperties _properties;
+
+		// the blocks of each pool, by pool index
+		std::vector<std::vector<std::unique_ptr<MemoryBlock>>> _pools;
+
+		// the size of each new block, in bytes
+		VkDeviceSize _blockSize;
+
+	public:
+		MemoryAllocator();
+
+		~MemoryAllocator();
+
+		MemoryAllocator(MemoryAllocator const& other) = delete;
+
+		MemoryAllocator& operator=(MemoryAllocator const& other) = delete;
+
+		/// <summary>
+		/// Initializes this MemoryAllocator.
+		/// </summary>
+		/// <param name="source">The source to allocate the blocks from. Must outlive this MemoryAllocator, or until destroy is called.</param>
+		/// <param name="properties">The memory types of the device.</param>
+		/// <param name="blockSize">The size of each block, in bytes.</param>
+		void init(IMemorySource& source, VkPhysicalDeviceMemoryProperties const& properties, VkDeviceSize const blockSize = MEMORY_BLOCK_SIZE);
+
+		/// <summary>
+		/// Frees all of the blocks. Any allocations still in use are no longer valid.
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// Allocates a range of device memory.
+		/// </summary>
+		/// <param name="requirements">The memory requirements of the buffer or image.</param>
+		/// <param name="memoryTypeIndex">The type of memory to allocate from.</param>
+		/// <param name="resource">The type of resource the memory is for.</param>
+		/// <param name="strategy">How the memory will be used.</param>
+		/// <returns>The allocation.</returns>
+		MemoryAllocation allocate(VkMemoryRequirements const& requirements, uint32_t const memoryTypeIndex, MemoryResource const resource, MemoryStrategy const strategy = MemoryStrategy::FreeList);
+
+		/// <summary>
+		/// Frees the given allocation, and resets it. Empty blocks are given back to the device, other than the last block in each pool.
+		/// </summary>
+		/// <param name="allocation"></param>
+		void free(MemoryAllocation& allocation);
+
+		/// <summary>
+		/// Gets the usage of all of the device memory within this MemoryAllocator.
+		/// </summary>
+		/// <returns></returns>
+		MemoryStatistics get_statistics() const;
+
+	private:
+		// gets the pool index for the given memory type, resource and strategy
+		static size_t get_pool_index(uint32_t const memoryTypeIndex, MemoryResource const resource, MemoryStrategy const strategy);
+
+		// creates a new block within the given pool
+		MemoryBlock* create_block(size_t const pool, uint32_t const memoryTypeIndex, VkDeviceSize const size, MemoryStrategy const strategy);
+
+		// gives the block back to the device
+		void destroy_block(MemoryBlock& block);
+	};
+}
\ No newline at end of file
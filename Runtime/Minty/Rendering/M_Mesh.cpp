@@ -20,6 +20,7 @@ Minty::Mesh::Mesh()
 	, _indexSize()
 	, _indexBuffer()
 	, _indexType()
+	, _uploadTicket()
 {}
 
 Minty::Mesh::Mesh(MeshBuilder const& builder)
@@ -31,6 +32,7 @@ Minty::Mesh::Mesh(MeshBuilder const& builder)
 	, _indexSize()
 	, _indexBuffer()
 	, _indexType()
+	, _uploadTicket()
 {}
 
 Minty::Mesh::~Mesh()
@@ -39,6 +41,11 @@ Minty::Mesh::~Mesh()
 	dispose_indices();
 }
 
+bool Minty::Mesh::is_ready() const
+{
+	return RenderEngine::instance().get_upload_queue().is_complete(_uploadTicket);
+}
+
 void Minty::Mesh::clear()
 {
 	set_vertices(nullptr, 0, 0);
@@ -435,26 +442,9 @@ void Minty::Mesh::set_vertices(void const* const vertices, size_t const count, s
 	// get buffer size
 	VkDeviceSize bufferSize = static_cast<VkDeviceSize>(count * vertexSize);
 
-	// use buffer to copy data into device memory
-	Ref<Buffer> stagingBuffer = renderer.create_buffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-	auto device = renderer.get_device();
-
-	// map data so it can be set
-	void* mappedData = renderer.map_buffer(stagingBuffer);
-
-	// copy into staging buffer
-	memcpy(mappedData, vertices, static_cast<size_t>(bufferSize));
-
-	// unmap
-	renderer.unmap_buffer(stagingBuffer);
-
-	// copy into device memory
+	// copy into device memory, staged through the upload ring
 	_vertexBuffer = renderer.create_buffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	renderer.copy_buffer(stagingBuffer, _vertexBuffer, bufferSize);
-
-	// clean up
-	renderer.destroy_buffer(stagingBuffer);
+	_uploadTicket = renderer.upload_buffer(_vertexBuffer, vertices, bufferSize);
 }
 
 void Minty::Mesh::set_indices(void const* const indices, size_t const count, size_t const indexSize, VkIndexType const type)
@@ -477,22 +467,9 @@ void Minty::Mesh::set_indices(void const* const indices, size_t const count, siz
 	// get buffer size
 	VkDeviceSize bufferSize = static_cast<VkDeviceSize>(count * indexSize);
 
-	// use buffer to copy data into device memory
-	Ref<Buffer> stagingBuffer = renderer.create_buffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-	auto device = renderer.get_device();
-
-	// copy into staging buffer
-	void* mappedData = renderer.map_buffer(stagingBuffer);
-	memcpy(mappedData, indices, static_cast<size_t>(bufferSize));
-	renderer.unmap_buffer(stagingBuffer);
-
-	// copy into device memory
+	// copy into device memory, staged through the upload ring
 	_indexBuffer = renderer.create_buffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	renderer.copy_buffer(stagingBuffer, _indexBuffer, bufferSize);
-
-	// clean up
-	renderer.destroy_buffer(stagingBuffer);
+	_uploadTicket = renderer.upload_buffer(_indexBuffer, indices, bufferSize);
 }
 
 void Minty::Mesh::dispose_vertices()
@@ -507,6 +484,9 @@ void Minty::Mesh::dispose_vertices()
 
 	RenderEngine& renderer = RenderEngine::instance();
 
+	// cannot destroy it while it is still being copied to
+	renderer.get_upload_queue().wait(_uploadTicket);
+
 	renderer.destroy_buffer(_vertexBuffer);
 	_vertexBuffer = nullptr;
 	_vertexCount = 0;
@@ -525,6 +505,9 @@ void Minty::Mesh::dispose_indices()
 
 	RenderEngine& renderer = RenderEngine::instance();
 
+	// cannot destroy it while it is still being copied to
+	renderer.get_upload_queue().wait(_uploadTicket);
+
 	renderer.destroy_buffer(_indexBuffer);
 	_indexBuffer = nullptr;
 	_indexCount = 0;
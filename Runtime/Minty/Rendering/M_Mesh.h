@@ -1,6 +1,7 @@
 #pragma once
 #include "Minty/Assets/M_Asset.h"
 
+#include "Minty/Rendering/M_UploadQueue.h"
 #include "Minty/Libraries/M_Vulkan.h"
 #include <vector>
 
@@ -74,6 +75,9 @@ namespace Minty
 		uint32_t _indexSize;
 		Ref<Buffer> _indexBuffer;
 		VkIndexType _indexType;
+
+		// the newest upload of the vertex or index data
+		UploadTicket _uploadTicket;
 	public:
 		/// <summary>
 		/// Creates an empty Mesh.
@@ -169,6 +173,12 @@ namespace Minty
 		/// <returns></returns>
 		bool empty() const { return _vertexCount == 0; }
 
+		/// <summary>
+		/// Checks if the vertex and index data have finished uploading to the GPU.
+		/// </summary>
+		/// <returns></returns>
+		bool is_ready() const;
+
 #pragma endregion
 
 #pragma region Primitives
@@ -91,6 +91,22 @@ void DestroyDebugUtilsMessengerEXT(VkInstance instance, VkDebugUtilsMessengerEXT
 	}
 }
 
+// lets the given queue families share the resource, if there is more than one
+template<typename CreateInfo>
+static void set_sharing_mode(CreateInfo& createInfo, std::vector<uint32_t> const& queueFamilies)
+{
+	if (queueFamilies.size() > 1)
+	{
+		createInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		createInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+		createInfo.pQueueFamilyIndices = queueFamilies.data();
+	}
+	else
+	{
+		createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	}
+}
+
 RenderEngine::RenderEngine()
 	: Engine()
 	, _window()
@@ -99,6 +115,26 @@ RenderEngine::RenderEngine()
 	, _backgroundColor({ 250, 220, 192, 255 }) // light tan color
 	, _initialized()
 	, _frame(0)
+	, _uploadBuffer(VK_NULL_HANDLE)
+	, _uploadMemory()
+	, _uploadRing()
+	, _uniformAlignment()
+	, _stagingAlignment()
+	, _uniformStart()
+	, _uniformSerial()
+	, _uploadQueue()
+	, _sharedQueueFamilies()
+	, _meshQueue()
+	, _meshDraws()
+	, _spriteQueue()
+	, _spriteInstances()
+	, _uiQueue()
+	, _uiDraws()
+	, _cameraPosition()
+	, _cameraForward(0.0f, 0.0f, 1.0f)
+	, _cameraFar(1.0f)
+	, _spriteBatch()
+	, _spriteInstanceBuffers()
 {
 	MINTY_ASSERT_MESSAGE(!_instance, "There should only be one RenderEngine.");
 
@@ -128,6 +164,9 @@ void Minty::RenderEngine::init()
 	create_surface();
 	pick_physical_device();
 	create_logical_device();
+	create_memory_allocator();
+	create_upload_ring();
+	create_upload_queue();
 	create_swap_chain();
 	create_image_views();
 	create_render_pass();
@@ -146,6 +185,13 @@ void RenderEngine::render_frame()
 	// wait until previous draw has completed
 	vkWaitForFences(_device, 1, &_inFlightFences[_frame], VK_TRUE, UINT64_MAX);
 
+	// anything uploaded for that draw is no longer needed
+	_uploadRing.retire(_frame);
+	_uploadQueue.retire(_frame);
+
+	// clean up any uploads that have finished
+	_uploadQueue.update();
+
 	// recreate swap chain check
 	uint32_t imageIndex;
 	VkResult r = vkAcquireNextImageKHR(_device, _swapChain, UINT64_MAX, _imageAvailableSemaphores[_frame], VK_NULL_HANDLE, &imageIndex);
@@ -173,12 +219,18 @@ void RenderEngine::render_frame()
 		.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO
 	};
 
+	// submit any uploads recorded since the last frame, so they can be used by this one
+	_uploadQueue.flush();
+
 	// specify how to wait, in this case, with the semaphores
-	VkSemaphore waitSemaphores[] = { _imageAvailableSemaphores[_frame] };
-	VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-	submitInfo.waitSemaphoreCount = 1;
-	submitInfo.pWaitSemaphores = waitSemaphores;
-	submitInfo.pWaitDstStageMask = waitStages;
+	// also wait for the uploads, before anything that could read from them
+	std::vector<VkSemaphore> waitSemaphores = { _imageAvailableSemaphores[_frame] };
+	_uploadQueue.take_semaphores(_frame, waitSemaphores);
+	std::vector<VkPipelineStageFlags> waitStages(waitSemaphores.size(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+	waitStages.front() = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+	submitInfo.pWaitSemaphores = waitSemaphores.data();
+	submitInfo.pWaitDstStageMask = waitStages.data();
 
 	// set number of command buffers
 	submitInfo.commandBufferCount = 1;
@@ -192,6 +244,9 @@ void RenderEngine::render_frame()
 	// submit the buffer
 	VK_ASSERT(vkQueueSubmit(_graphicsQueue, 1, &submitInfo, _inFlightFences[_frame]), "Failed to submit draw command buffer.");
 
+	// everything uploaded so far is used by this frame
+	_uploadRing.end_frame(_frame);
+
 	// submit to swap chain so it will show up on the screen
 	VkPresentInfoKHR presentInfo
 	{
@@ -227,6 +282,11 @@ void Minty::RenderEngine::set_camera(Vector3 const position, Quaternion const ro
 {
 	_backgroundColor = camera.get_color();
 
+	// used to sort meshes by depth
+	_cameraPosition = position;
+	_cameraForward = forward(rotation);
+	_cameraFar = std::max(camera.get_far(), 0.001f);
+
 	Matrix4 view = glm::lookAt(position, position + forward(rotation), Vector3(0.0f, 1.0f, 0.0f));
 
 	// TODO: don't use lookat
@@ -379,7 +439,7 @@ void RenderEngine::create_depth_resources()
 	_depthImageView = create_image_view(_depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
 }
 
-void RenderEngine::create_image(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory) {
+void RenderEngine::create_image(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, MemoryAllocation& imageMemory) {
 	VkImageCreateInfo imageInfo{};
 	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 	imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -395,6 +455,12 @@ void RenderEngine::create_image(uint32_t width, uint32_t height, VkFormat format
 	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
 	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
+	// written to by the transfer queue
+	if (usage & VK_IMAGE_USAGE_TRANSFER_DST_BIT)
+	{
+		set_sharing_mode(imageInfo, _sharedQueueFamilies);
+	}
+
 	if (vkCreateImage(_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
 		MINTY_ABORT("Failed to create image.");
 	}
@@ -402,16 +468,13 @@ void RenderEngine::create_image(uint32_t width, uint32_t height, VkFormat format
 	VkMemoryRequirements memRequirements;
 	vkGetImageMemoryRequirements(_device, image, &memRequirements);
 
-	VkMemoryAllocateInfo allocInfo{};
-	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	allocInfo.allocationSize = memRequirements.size;
-	allocInfo.memoryTypeIndex = find_memory_type(memRequirements.memoryTypeBits, properties);
+	imageMemory = _memoryAllocator.allocate(memRequirements, find_memory_type(memRequirements.memoryTypeBits, properties), MemoryResource::Image);
 
-	if (vkAllocateMemory(_device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
+	if (imageMemory.memory == VK_NULL_HANDLE) {
 		MINTY_ABORT("Failed to allocate image memory.");
 	}
 
-	vkBindImageMemory(_device, image, imageMemory, 0);
+	vkBindImageMemory(_device, image, imageMemory.memory, imageMemory.offset);
 }
 
 VkDevice Minty::RenderEngine::get_device() const
@@ -429,6 +492,21 @@ VkRenderPass Minty::RenderEngine::get_render_pass() const
 	return _renderPass;
 }
 
+MemoryAllocator& Minty::RenderEngine::get_memory_allocator()
+{
+	return _memoryAllocator;
+}
+
+MemoryStatistics Minty::RenderEngine::get_memory_statistics() const
+{
+	return _memoryAllocator.get_statistics();
+}
+
+SpriteBatch const& Minty::RenderEngine::get_sprite_batch() const
+{
+	return _spriteBatch;
+}
+
 uint32_t Minty::RenderEngine::get_frame() const
 {
 	return _frame;
@@ -531,16 +609,27 @@ VkImageView RenderEngine::create_image_view(VkImage image, VkFormat format, VkIm
 VkShaderModule Minty::RenderEngine::load_shader_module(String const& path) const
 {
 	AssetEngine& assets = AssetEngine::instance();
-	return create_shader_module(assets.read_file(path));
+	std::vector<char> buffer;
+	return create_shader_module(assets.read_file_view(path, buffer));
 }
 
-VkShaderModule Minty::RenderEngine::create_shader_module(std::vector<char> const& code) const
+VkShaderModule Minty::RenderEngine::create_shader_module(std::span<char const> const code) const
 {
+	// the code must be 4 byte aligned, which a view into a Wrap file might not be
+	uint32_t const* pCode = reinterpret_cast<uint32_t const*>(code.data());
+	std::vector<uint32_t> alignedCode;
+	if (reinterpret_cast<uintptr_t>(code.data()) % alignof(uint32_t))
+	{
+		alignedCode.resize((code.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+		memcpy(alignedCode.data(), code.data(), code.size());
+		pCode = alignedCode.data();
+	}
+
 	VkShaderModuleCreateInfo createInfo
 	{
 		.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
 		.codeSize = code.size(),
-		.pCode = reinterpret_cast<const uint32_t*>(code.data())
+		.pCode = pCode
 	};
 
 	VkShaderModule shaderModule;
@@ -638,11 +727,11 @@ void RenderEngine::change_image_layout(VkImage image, VkFormat format, VkImageLa
 	end_single_time_commands(commandBuffer, _commandPool);
 }
 
-void RenderEngine::copy_buffer_to_image(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) {
+void RenderEngine::copy_buffer_to_image(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, VkDeviceSize offset) {
 	VkCommandBuffer commandBuffer = begin_single_time_commands(_commandPool);
 
 	VkBufferImageCopy region{};
-	region.bufferOffset = 0;
+	region.bufferOffset = offset;
 	region.bufferRowLength = 0;
 	region.bufferImageHeight = 0;
 
@@ -822,7 +911,7 @@ void RenderEngine::cleanup_swap_chain()
 {
 	vkDestroyImageView(_device, _depthImageView, nullptr);
 	vkDestroyImage(_device, _depthImage, nullptr);
-	vkFreeMemory(_device, _depthImageMemory, nullptr);
+	_memoryAllocator.free(_depthImageMemory);
 
 	for (size_t i = 0; i < _swapChainFramebuffers.size(); i++) {
 		vkDestroyFramebuffer(_device, _swapChainFramebuffers[i], nullptr);
@@ -972,6 +1061,27 @@ QueueFamilyIndices RenderEngine::find_queue_families(VkPhysicalDevice device)
 		i++;
 	}
 
+	// find a family that only does transfers, or at least does not do graphics, so uploads can run alongside rendering
+	i = 0;
+	for (const auto& queueFamily : queueFamilies) {
+		if ((queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) && !(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT))
+		{
+			bool compute = queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT;
+
+			if (!indices.transferFamily.has_value() || !compute)
+			{
+				indices.transferFamily = i;
+			}
+
+			if (!compute)
+			{
+				break;
+			}
+		}
+
+		i++;
+	}
+
 	return indices;
 }
 
@@ -982,6 +1092,10 @@ void RenderEngine::create_logical_device()
 
 	std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
 	std::set<uint32_t> uniqueQueueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+	if (indices.transferFamily.has_value())
+	{
+		uniqueQueueFamilies.insert(indices.transferFamily.value());
+	}
 
 	float queuePriority = 1.0f;
 	for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -1042,6 +1156,80 @@ void RenderEngine::create_logical_device()
 
 	vkGetDeviceQueue(_device, indices.graphicsFamily.value(), 0, &_graphicsQueue);
 	vkGetDeviceQueue(_device, indices.presentFamily.value(), 0, &_presentQueue);
+
+	if (indices.transferFamily.has_value())
+	{
+		vkGetDeviceQueue(_device, indices.transferFamily.value(), 0, &_transferQueue);
+
+		// resources written by the transfer queue are used by the graphics queue as well
+		_sharedQueueFamilies = { indices.graphicsFamily.value(), indices.transferFamily.value() };
+	}
+	else
+	{
+		_transferQueue = _graphicsQueue;
+		_sharedQueueFamilies.clear();
+	}
+}
+
+void RenderEngine::create_memory_allocator()
+{
+	VkPhysicalDeviceMemoryProperties memProperties;
+	vkGetPhysicalDeviceMemoryProperties(_physicalDevice, &memProperties);
+
+	_memorySource = VulkanMemorySource(_device);
+	_memoryAllocator.init(_memorySource, memProperties);
+}
+
+void RenderEngine::create_upload_ring()
+{
+	VkPhysicalDeviceProperties deviceProperties;
+	vkGetPhysicalDeviceProperties(_physicalDevice, &deviceProperties);
+
+	// texel copies need at least 4 byte alignment, so use 16 to be safe for any format
+	_uniformAlignment = std::max<VkDeviceSize>(deviceProperties.limits.minUniformBufferOffsetAlignment, 16);
+	_stagingAlignment = std::max<VkDeviceSize>(deviceProperties.limits.optimalBufferCopyOffsetAlignment, 16);
+
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = RING_BUFFER_SIZE;
+	bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	// staged uploads are read by the transfer queue
+	set_sharing_mode(bufferInfo, _sharedQueueFamilies);
+
+	VK_ASSERT(vkCreateBuffer(_device, &bufferInfo, nullptr, &_uploadBuffer), "Failed to create upload buffer.");
+
+	VkMemoryRequirements memRequirements;
+	vkGetBufferMemoryRequirements(_device, _uploadBuffer, &memRequirements);
+
+	_uploadMemory = _memoryAllocator.allocate(memRequirements, find_memory_type(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT), MemoryResource::Buffer);
+
+	if (!_uploadMemory.mapped)
+	{
+		MINTY_ABORT("Failed to allocate upload buffer memory.");
+	}
+
+	VK_ASSERT(vkBindBufferMemory(_device, _uploadBuffer, _uploadMemory.memory, _uploadMemory.offset), "Failed to bind upload buffer memory.");
+
+	_uploadRing.init(_uploadBuffer, _uploadMemory.mapped, RING_BUFFER_SIZE);
+	_uniformStart = 0;
+	_uniformSerial = 0;
+}
+
+void RenderEngine::create_upload_queue()
+{
+	QueueFamilyIndices indices = find_queue_families(_physicalDevice);
+
+	// use the graphics queue if there is no dedicated transfer queue
+	if (indices.transferFamily.has_value())
+	{
+		_uploadQueue.init(_device, _transferQueue, indices.transferFamily.value());
+	}
+	else
+	{
+		_uploadQueue.init(_device, _graphicsQueue, indices.graphicsFamily.value());
+	}
 }
 
 void Minty::RenderEngine::draw(VkCommandBuffer commandBuffer)
@@ -1053,82 +1241,65 @@ void Minty::RenderEngine::draw_scene(VkCommandBuffer commandBuffer)
 {
 	if (!_registry) return;
 
-	TransformComponent const* transformComponent;
+	// collect everything to draw, each queue is sorted on a worker thread while the next one is collected
+	// sprite instance data must be written before any descriptor sets are bound
+	prepare_meshes();
+	prepare_sprites();
+	prepare_ui_sprites();
 
 	// draw all meshes in the scene
-	for (auto&& [entity, mesh, renderable, enabled] : _registry->view<MeshComponent, RenderableComponent const, EnabledComponent const>().each())
-	{
-		// skip empty meshes
-		if (mesh.type == MeshType::Empty) continue;
+	draw_meshes(commandBuffer);
 
-		// get transform for entity
-		transformComponent = _registry->try_get<TransformComponent>(entity);
+	// draw all world sprites in the scene
+	draw_sprites(commandBuffer);
 
-		if (transformComponent)
-		{
-			// render the entity's mesh at the position
-			draw_mesh(commandBuffer, transformComponent->globalMatrix, mesh);
-		}
-		else
-		{
-			// if no transform, use empty matrix
-			draw_mesh(commandBuffer, Matrix4(1.0f), mesh);
-		}
-	}
+	// draw all UI in scene
+	draw_ui_sprites(commandBuffer);
 
-	// sort sprites so they render in the correct order, since Z does not matter
-	_registry->sort<SpriteComponent>([](SpriteComponent const& left, SpriteComponent const& right)
-		{
-			return
-				left.layer > right.layer ||
-				(left.layer == right.layer && left.order > right.order);
-		});
+	// unbind any shaders used
+	bind(commandBuffer, nullptr);
+}
 
-	// draw all world sprites in the scene
-	auto spriteView = _registry->view<RenderableComponent const, TransformComponent const, SpriteComponent const, EnabledComponent const>();
-	spriteView.use<SpriteComponent const>();
-	for (auto&& [entity, renderable, transform, sprite, enabled] : spriteView.each())
+void Minty::RenderEngine::prepare_meshes()
+{
+	_meshQueue.clear();
+	_meshDraws.clear();
+
+	for (auto&& [entity, mesh, renderable, enabled] : _registry->view<MeshComponent const, RenderableComponent const, EnabledComponent const>().each())
 	{
-		draw_sprite(commandBuffer, transform, sprite);
-	}
+		// skip empty meshes, and meshes that cannot be drawn
+		if (mesh.type == MeshType::Empty || !mesh.mesh || !mesh.material) continue;
 
-	// sort UITransforms so that it matches order of sprites for rendering
-	//_registry->sort<UITransformComponent, SpriteComponent>();
+		// get transform for entity, if no transform, use empty matrix
+		TransformComponent const* transformComponent = _registry->try_get<TransformComponent>(entity);
+		Matrix4 transform = transformComponent ? transformComponent->globalMatrix : Matrix4(1.0f);
 
-	// draw all UI in scene
-	// keep track of the canvas being used
-	Entity canvasEntity = NULL_ENTITY;
-	auto uiSpriteView = _registry->view<RenderableComponent const, UITransformComponent const, SpriteComponent const, EnabledComponent const>();
-	uiSpriteView.use<SpriteComponent const>();
-	for (auto&& [entity, renderable, ui, sprite, enabled] : uiSpriteView.each())
-	{
-		// if new canvas, update shader values
-		if (ui.canvas != canvasEntity)
-		{
-			canvasEntity = ui.canvas;
+		// group by pipeline, then by material, then draw nearer meshes first
+		// TODO: do all passes?
+		Ref<ShaderPass> shaderPass = mesh.material->get_template()->get_shader_passes().front();
+		uint64_t key = RenderQueue::make_key(0, 0, _meshQueue.get_id(shaderPass.get()), _meshQueue.get_id(mesh.material.get()), get_depth(Vector3(transform[3])));
 
-			// TODO: make safer
-			if (sprite.sprite)
+		_meshQueue.push(key, static_cast<uint32_t>(_meshDraws.size()));
+		_meshDraws.push_back(MeshDraw
 			{
-				Ref<Shader> shader = sprite.sprite->get_material()->get_template()->get_shader_passes().front()->get_shader();
+				.transform = transform,
+				.mesh = &mesh,
+			});
+	}
 
-				MINTY_ASSERT(shader != nullptr);
+	_meshQueue.sort_async();
+}
 
-				CanvasComponent* canvas = _registry->try_get<CanvasComponent>(canvasEntity);
-				CanvasBufferObject canvasBufferObject
-				{
-					.width = canvas ? canvas->referenceResolutionWidth : 0,
-					.height = canvas ? canvas->referenceResolutionHeight : 0,
-				};
-				shader->update_global_uniform_constant("canvas", &canvasBufferObject, sizeof(CanvasBufferObject), 0);
-			}
-		}
+void Minty::RenderEngine::draw_meshes(VkCommandBuffer commandBuffer)
+{
+	_meshQueue.wait();
 
-		draw_ui(commandBuffer, ui, sprite);
-	}
+	for (RenderQueueItem const& item : _meshQueue.get_items())
+	{
+		MeshDraw const& draw = _meshDraws.at(item.index);
 
-	// unbind any shaders used
-	bind(commandBuffer, nullptr);
+		draw_mesh(commandBuffer, draw.transform, *draw.mesh);
+	}
 }
 
 void Minty::RenderEngine::draw_mesh(VkCommandBuffer commandBuffer, Matrix4 const& transformationMatrix, MeshComponent const& meshComponent)
@@ -1171,38 +1342,193 @@ void Minty::RenderEngine::draw_mesh(VkCommandBuffer commandBuffer, Matrix4 const
 	vkCmdDrawIndexed(commandBuffer, mesh.get_index_count(), 1, 0, 0, 0);
 }
 
-void Minty::RenderEngine::draw_sprite(VkCommandBuffer commandBuffer, TransformComponent const& transformComponent, SpriteComponent const& spriteComponent)
+void Minty::RenderEngine::prepare_sprites()
 {
-	// if no sprite, skip and draw nothing
-	if(!spriteComponent.sprite)
+	_spriteQueue.clear();
+	_spriteInstances.clear();
+
+	// collect all world sprites in the scene
+	auto spriteView = _registry->view<RenderableComponent const, TransformComponent const, SpriteComponent const, EnabledComponent const>();
+	for (auto&& [entity, renderable, transform, spriteComponent, enabled] : spriteView.each())
 	{
-		return;
+		// if no sprite, skip and draw nothing
+		if (!spriteComponent.sprite || !spriteComponent.sprite->get_material())
+		{
+			continue;
+		}
+
+		Sprite const& sprite = *spriteComponent.sprite;
+		Ref<Material> material = sprite.get_material();
+
+		// TODO: make safer
+		Ref<ShaderPass> shaderPass = material->get_template()->get_shader_passes().front();
+
+		// sort so they render in the correct order, since Z does not matter
+		// higher layers and orders are drawn first, underneath the rest
+		uint64_t key = RenderQueue::make_key(-spriteComponent.layer, -spriteComponent.order, _spriteQueue.get_id(shaderPass.get()), _spriteQueue.get_id(material.get()), 0);
+
+		_spriteQueue.push(key, static_cast<uint32_t>(_spriteInstances.size()));
+		_spriteInstances.push_back(SpriteInstance
+			{
+				.material = material,
+				.data = SpritePushData
+				{
+					.transform = transform.globalMatrix,
+					.color = spriteComponent.color.toVector(),
+					.minCoords = sprite.get_min_coords(),
+					.maxCoords = sprite.get_max_coords(),
+					.pivot = sprite.get_pivot(),
+					.size = spriteComponent.size,
+				},
+			});
 	}
 
-	// get the sprite
-	Sprite const& sprite = *spriteComponent.sprite;
+	if (_spriteInstances.empty()) return;
 
-	// bind the material the sprite is using
-	bind(commandBuffer, sprite.get_material());
+	_spriteQueue.sort_async();
 
-	// get the data
-	SpritePushData pushData
+	// grow the instance buffer for this frame, if needed
+	// the fence for this frame has been waited on, so the old buffer is no longer in use
+	VkDeviceSize size = static_cast<VkDeviceSize>(_spriteInstances.size()) * sizeof(SpritePushData);
+	Ref<Buffer>& instanceBuffer = _spriteInstanceBuffers.at(_frame);
+	if (!instanceBuffer || instanceBuffer->get_size() < size)
 	{
-		.transform = transformComponent.globalMatrix,
-		.color = spriteComponent.color.toVector(),
-		.minCoords = sprite.get_min_coords(),
-		.maxCoords = sprite.get_max_coords(),
-		.pivot = sprite.get_pivot(),
-		.size = spriteComponent.size,
-	};
+		VkDeviceSize capacity = static_cast<VkDeviceSize>(SPRITE_INSTANCE_CAPACITY) * sizeof(SpritePushData);
+		if (instanceBuffer)
+		{
+			capacity = instanceBuffer->get_size();
+			destroy_buffer(instanceBuffer);
+		}
+		while (capacity < size)
+		{
+			capacity *= 2;
+		}
 
-	// push data to shader
-	// TODO: fix, make this safe
-	Ref<Shader> shader = sprite.get_material()->get_template()->get_shader_passes().front()->get_shader();
-	shader->update_push_constant(commandBuffer, &pushData, sizeof(SpritePushData));
+		instanceBuffer = create_buffer(capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	}
 
-	// draw
-	vkCmdDraw(commandBuffer, 6, 1, 0, 0);
+	// point every shader that draws instanced at the buffer, not just the ones drawn this frame
+	// otherwise the others would keep the ID of a destroyed buffer, which is looked up whenever their descriptors are applied
+	AssetEngine& assets = AssetEngine::instance();
+	UUID bufferId = instanceBuffer->get_id();
+	for (auto const shader : assets.get_by_type<Shader>())
+	{
+		if (shader->has_uniform_constant(SPRITE_INSTANCES_NAME))
+		{
+			// does nothing if already set to this buffer
+			shader->update_global_uniform_constant(SPRITE_INSTANCES_NAME, _frame, &bufferId, sizeof(UUID), 0);
+		}
+	}
+}
+
+void Minty::RenderEngine::draw_sprites(VkCommandBuffer commandBuffer)
+{
+	_spriteBatch.clear();
+	_spriteQueue.wait();
+
+	// group neighbors that use the same material into instanced draws, in sorted order
+	for (RenderQueueItem const& item : _spriteQueue.get_items())
+	{
+		SpriteInstance const& instance = _spriteInstances.at(item.index);
+
+		_spriteBatch.add(instance.material, instance.data);
+	}
+
+	if (_spriteBatch.empty()) return;
+
+	std::vector<SpritePushData> const& instances = _spriteBatch.get_instances();
+	set_buffer(_spriteInstanceBuffers.at(_frame), instances.data(), static_cast<VkDeviceSize>(instances.size()) * sizeof(SpritePushData), 0);
+
+	for (SpriteDraw const& draw : _spriteBatch.get_draws())
+	{
+		// bind the material the sprites are using
+		bind(commandBuffer, draw.material);
+
+		// TODO: make safer
+		Ref<Shader> shader = draw.material->get_template()->get_shader_passes().front()->get_shader();
+
+		if (shader->has_uniform_constant(SPRITE_INSTANCES_NAME))
+		{
+			// the shader reads each sprite from the instance buffer, so draw them all at once
+			vkCmdDraw(commandBuffer, 6, draw.instanceCount, 0, draw.firstInstance);
+		}
+		else
+		{
+			// the shader reads the sprite from push constants, so draw them one at a time
+			for (uint32_t i = draw.firstInstance; i < draw.firstInstance + draw.instanceCount; i++)
+			{
+				shader->update_push_constant(commandBuffer, &instances.at(i), sizeof(SpritePushData));
+				vkCmdDraw(commandBuffer, 6, 1, 0, 0);
+			}
+		}
+	}
+}
+
+void Minty::RenderEngine::prepare_ui_sprites()
+{
+	_uiQueue.clear();
+	_uiDraws.clear();
+
+	for (auto&& [entity, renderable, ui, sprite, enabled] : _registry->view<RenderableComponent const, UITransformComponent const, SpriteComponent const, EnabledComponent const>().each())
+	{
+		uint32_t shaderPassId = 0;
+		uint32_t materialId = 0;
+		if (sprite.sprite && sprite.sprite->get_material())
+		{
+			Ref<Material> material = sprite.sprite->get_material();
+			shaderPassId = _uiQueue.get_id(material->get_template()->get_shader_passes().front().get());
+			materialId = _uiQueue.get_id(material.get());
+		}
+
+		// same order as the world sprites
+		uint64_t key = RenderQueue::make_key(-sprite.layer, -sprite.order, shaderPassId, materialId, 0);
+
+		_uiQueue.push(key, static_cast<uint32_t>(_uiDraws.size()));
+		_uiDraws.push_back(UIDraw
+			{
+				.ui = &ui,
+				.sprite = &sprite,
+			});
+	}
+
+	_uiQueue.sort_async();
+}
+
+void Minty::RenderEngine::draw_ui_sprites(VkCommandBuffer commandBuffer)
+{
+	_uiQueue.wait();
+
+	// keep track of the canvas being used
+	Entity canvasEntity = NULL_ENTITY;
+	for (RenderQueueItem const& item : _uiQueue.get_items())
+	{
+		UITransformComponent const& ui = *_uiDraws.at(item.index).ui;
+		SpriteComponent const& sprite = *_uiDraws.at(item.index).sprite;
+
+		// if new canvas, update shader values
+		if (ui.canvas != canvasEntity)
+		{
+			canvasEntity = ui.canvas;
+
+			// TODO: make safer
+			if (sprite.sprite)
+			{
+				Ref<Shader> shader = sprite.sprite->get_material()->get_template()->get_shader_passes().front()->get_shader();
+
+				MINTY_ASSERT(shader != nullptr);
+
+				CanvasComponent* canvas = _registry->try_get<CanvasComponent>(canvasEntity);
+				CanvasBufferObject canvasBufferObject
+				{
+					.width = canvas ? canvas->referenceResolutionWidth : 0,
+					.height = canvas ? canvas->referenceResolutionHeight : 0,
+				};
+				shader->update_global_uniform_constant("canvas", &canvasBufferObject, sizeof(CanvasBufferObject), 0);
+			}
+		}
+
+		draw_ui(commandBuffer, ui, sprite);
+	}
 }
 
 void Minty::RenderEngine::draw_ui(VkCommandBuffer commandBuffer, UITransformComponent const& uiComponent, SpriteComponent const& spriteComponent)
@@ -1237,6 +1563,14 @@ void Minty::RenderEngine::draw_ui(VkCommandBuffer commandBuffer, UITransformComp
 	vkCmdDraw(commandBuffer, 6, 1, 0, 0);
 }
 
+uint32_t Minty::RenderEngine::get_depth(Vector3 const& position) const
+{
+	// 0 at the camera, 255 at the far plane
+	float depth = glm::dot(position - _cameraPosition, _cameraForward) / _cameraFar;
+
+	return static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * 255.0f);
+}
+
 bool RenderEngine::check_validation_layer_support()
 {
 	uint32_t layerCount;
@@ -1415,10 +1749,9 @@ void RenderEngine::create_framebuffers()
 	}
 }
 
-Ref<Buffer> Minty::RenderEngine::create_buffer(VkDeviceSize const size, VkBufferUsageFlags const usage, VkMemoryPropertyFlags const properties)
+Ref<Buffer> Minty::RenderEngine::create_buffer(VkDeviceSize const size, VkBufferUsageFlags const usage, VkMemoryPropertyFlags const properties, MemoryStrategy const strategy)
 {
 	VkBuffer buffer;
-	VkDeviceMemory bufferMemory;
 
 	VkBufferCreateInfo bufferInfo{};
 	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -1426,25 +1759,31 @@ Ref<Buffer> Minty::RenderEngine::create_buffer(VkDeviceSize const size, VkBuffer
 	bufferInfo.usage = usage;
 	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
+	// read from or written to by the transfer queue
+	if (usage & (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT))
+	{
+		set_sharing_mode(bufferInfo, _sharedQueueFamilies);
+	}
+
 	VK_ASSERT(vkCreateBuffer(_device, &bufferInfo, nullptr, &buffer), "Failed to create buffer.");
 
 	VkMemoryRequirements memRequirements;
 	vkGetBufferMemoryRequirements(_device, buffer, &memRequirements);
 
-	VkMemoryAllocateInfo allocInfo{};
-	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	allocInfo.allocationSize = memRequirements.size;
-	allocInfo.memoryTypeIndex = find_memory_type(memRequirements.memoryTypeBits, properties);
+	MemoryAllocation bufferMemory = _memoryAllocator.allocate(memRequirements, find_memory_type(memRequirements.memoryTypeBits, properties), MemoryResource::Buffer, strategy);
 
-	VK_ASSERT(vkAllocateMemory(_device, &allocInfo, nullptr, &bufferMemory), "Failed to allocate buffer memory.");
+	if (bufferMemory.memory == VK_NULL_HANDLE)
+	{
+		MINTY_ABORT("Failed to allocate buffer memory.");
+	}
 
-	VK_ASSERT(vkBindBufferMemory(_device, buffer, bufferMemory, 0), "Failed to bind buffer memory.");
+	VK_ASSERT(vkBindBufferMemory(_device, buffer, bufferMemory.memory, bufferMemory.offset), "Failed to bind buffer memory.");
 
 	AssetEngine& assets = AssetEngine::instance();
 	BufferBuilder builder
 	{
 		.buffer = buffer,
-		.memory = bufferMemory,
+		.allocation = bufferMemory,
 		.size = size
 	};
 	return assets.create<Buffer>(builder);
@@ -1457,22 +1796,23 @@ Ref<Buffer> Minty::RenderEngine::create_buffer_uniform(VkDeviceSize const size)
 
 void* Minty::RenderEngine::map_buffer(Ref<Buffer> const buffer) const
 {
-	void* data = nullptr;
+	// host visible blocks are persistently mapped
+	void* data = buffer->get_allocation().mapped;
 
-	VK_ASSERT(vkMapMemory(_device, buffer->get_memory(), 0, buffer->get_size(), 0, &data), "Failed to map memory for new buffer.");
+	MINTY_ASSERT(data != nullptr);
 
 	return data;
 }
 
 void Minty::RenderEngine::unmap_buffer(Ref<Buffer> const buffer) const
 {
-	vkUnmapMemory(_device, buffer->get_memory());
+	// nothing to do, the block stays mapped until it is freed
 }
 
 void Minty::RenderEngine::set_buffer(Ref<Buffer> const buffer, void const* const data)
 {
 	// set whole buffer
-	set_buffer(buffer, data, 0, buffer->get_size());
+	set_buffer(buffer, data, buffer->get_size(), 0);
 }
 
 void Minty::RenderEngine::set_buffer(Ref<Buffer> const buffer, void const* const data, VkDeviceSize const size, VkDeviceSize const offset)
@@ -1520,6 +1860,105 @@ void Minty::RenderEngine::copy_buffer(Ref<Buffer> const src, Ref<Buffer> const d
 	end_single_time_commands(commandBuffer, _commandPool);
 }
 
+void Minty::RenderEngine::copy_buffer(VkBuffer const src, VkDeviceSize const srcOffset, VkBuffer const dst, VkDeviceSize const size)
+{
+	VkCommandBuffer commandBuffer = begin_single_time_commands(_commandPool);
+
+	VkBufferCopy copyRegion{};
+	copyRegion.srcOffset = srcOffset;
+	copyRegion.size = size;
+	vkCmdCopyBuffer(commandBuffer, src, dst, 1, &copyRegion);
+
+	end_single_time_commands(commandBuffer, _commandPool);
+}
+
+UploadTicket Minty::RenderEngine::upload_buffer(Ref<Buffer> const buffer, void const* const data, VkDeviceSize const size)
+{
+	RingAllocation staged = stage_upload(data, size);
+
+	return _uploadQueue.copy_buffer(staged.buffer, staged.offset, buffer->get_buffer(), size);
+}
+
+UploadTicket Minty::RenderEngine::upload_image(VkImage const image, void const* const data, VkDeviceSize const size, uint32_t const width, uint32_t const height)
+{
+	RingAllocation staged = stage_upload(data, size);
+
+	return _uploadQueue.copy_buffer_to_image(staged.buffer, staged.offset, image, width, height);
+}
+
+RingAllocation Minty::RenderEngine::stage_upload(void const* const data, VkDeviceSize const size)
+{
+	// copy through the upload ring, if there is room
+	RingAllocation staged = stage(data, size);
+
+	if (staged.buffer)
+	{
+		return staged;
+	}
+
+	// too big for the ring, so use a temporary staging buffer, which is destroyed once the upload is complete
+	Ref<Buffer> stagingBuffer = create_buffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryStrategy::Linear);
+	set_buffer(stagingBuffer, data, size, 0);
+	_uploadQueue.keep(stagingBuffer);
+
+	return RingAllocation
+	{
+		.buffer = stagingBuffer->get_buffer(),
+		.offset = 0,
+		.mapped = nullptr,
+	};
+}
+
+RingAllocation Minty::RenderEngine::stage(void const* const data, VkDeviceSize const size)
+{
+	return _uploadRing.upload(data, size, _stagingAlignment);
+}
+
+RingAllocation Minty::RenderEngine::upload_uniform(void const* const data, VkDeviceSize const size)
+{
+	// remember where the uniforms for this frame start, everything before them is used by submitted frames or staged uploads
+	if (_uniformSerial != _uploadRing.get_serial())
+	{
+		_uniformSerial = _uploadRing.get_serial();
+		_uniformStart = _uploadRing.get_position();
+	}
+
+	RingAllocation allocation = _uploadRing.upload(data, size, _uniformAlignment);
+
+	if (allocation.buffer)
+	{
+		return allocation;
+	}
+
+	// the ring is full, so submit the staged uploads, and wait for them and the frames in flight to finish
+	_uploadQueue.flush();
+	sync();
+	_uploadQueue.update();
+
+	// now only the uniforms for this frame are still needed
+	_uploadRing.retire_all();
+	_uploadRing.retire_to(_uniformStart);
+
+	allocation = _uploadRing.upload(data, size, _uniformAlignment);
+
+	if (!allocation.buffer)
+	{
+		MINTY_ERROR_FORMAT("Failed to upload {} bytes of uniform data: the uniforms for this frame fill the upload ring.", size);
+	}
+
+	return allocation;
+}
+
+RingBuffer const& Minty::RenderEngine::get_upload_ring() const
+{
+	return _uploadRing;
+}
+
+UploadQueue& Minty::RenderEngine::get_upload_queue()
+{
+	return _uploadQueue;
+}
+
 void Minty::RenderEngine::destroy_buffer(Ref<Buffer> const buffer)
 {
 	AssetEngine& assets = AssetEngine::instance();
@@ -1693,6 +2132,20 @@ void RenderEngine::destroy()
 
 	sync();
 
+	// finish any uploads, and free their staging buffers
+	_uploadQueue.destroy();
+
+	// free the sprite instance buffers
+	_spriteBatch.clear();
+	for (Ref<Buffer>& instanceBuffer : _spriteInstanceBuffers)
+	{
+		if (instanceBuffer)
+		{
+			destroy_buffer(instanceBuffer);
+			instanceBuffer = nullptr;
+		}
+	}
+
 	// clean up vulkan
 	cleanup_swap_chain();
 
@@ -1704,6 +2157,10 @@ void RenderEngine::destroy()
 	}
 	vkDestroyCommandPool(_device, _commandPool, nullptr);
 	vkDestroyRenderPass(_device, _renderPass, nullptr);
+	_uploadRing.destroy();
+	vkDestroyBuffer(_device, _uploadBuffer, nullptr);
+	_memoryAllocator.free(_uploadMemory);
+	_memoryAllocator.destroy();
 	vkDestroyDevice(_device, nullptr);
 	if (enableValidationLayers) {
 		DestroyDebugUtilsMessengerEXT(_vkInstance, _debugMessenger, nullptr);
@@ -1733,9 +2190,15 @@ void Minty::RenderEngine::bind(VkCommandBuffer const commandBuffer)
 	descriptorSets[DESCRIPTOR_SET_SHADER_PASS] = shaderPass.get_descriptor_set().at(_frame);
 	descriptorSets[DESCRIPTOR_SET_MATERIAL] = material.get_descriptor_set(0).at(_frame);
 
+	// get offsets for any dynamic uniform buffers, in set order
+	std::vector<uint32_t> dynamicOffsets;
+	shader.get_global_descriptor_set().get_dynamic_offsets(_frame, dynamicOffsets);
+	shaderPass.get_descriptor_set().get_dynamic_offsets(_frame, dynamicOffsets);
+	material.get_descriptor_set(0).get_dynamic_offsets(_frame, dynamicOffsets);
+
 	// bind pipeline and descriptor sets
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shaderPass.get_pipeline());
-	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shader.get_pipeline_layout(), 0, DESCRIPTOR_SET_COUNT, descriptorSets.data(), 0, nullptr);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shader.get_pipeline_layout(), 0, DESCRIPTOR_SET_COUNT, descriptorSets.data(), static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 }
 
 void Minty::RenderEngine::bind(VkCommandBuffer const commandBuffer, Ref<Material> const material, uint32_t const pass)
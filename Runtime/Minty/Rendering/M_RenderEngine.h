@@ -6,6 +6,11 @@
 #include "Minty/Core/M_Window.h"
 #include "Minty/Rendering/M_Viewport.h"
 #include "Minty/Rendering/M_Buffer.h"
+#include "Minty/Rendering/M_MemoryAllocator.h"
+#include "Minty/Rendering/M_RingBuffer.h"
+#include "Minty/Rendering/M_UploadQueue.h"
+#include "Minty/Rendering/M_SpriteBatch.h"
+#include "Minty/Rendering/M_RenderQueue.h"
 #include "Minty/Entities/M_Entity.h"
 #include "Minty/Types/M_Matrix.h"
 #include "Minty/Rendering/M_Mesh.h"
@@ -18,6 +23,7 @@
 #include <set>
 #include <unordered_set>
 #include <optional>
+#include <span>
 #include <string>
 #include <cstring>
 #include <filesystem>
@@ -27,6 +33,7 @@ namespace Minty
 	struct QueueFamilyIndices {
 		std::optional<uint32_t> graphicsFamily;
 		std::optional<uint32_t> presentFamily;
+		std::optional<uint32_t> transferFamily;
 
 		bool isComplete()
 		{
@@ -91,6 +98,7 @@ namespace Minty
 		VkQueue _graphicsQueue;
 		VkSurfaceKHR _surface;
 		VkQueue _presentQueue;
+		VkQueue _transferQueue;
 		VkSwapchainKHR _swapChain;
 		std::vector<VkImage> _swapChainImages;
 		VkFormat _swapChainImageFormat;
@@ -108,9 +116,70 @@ namespace Minty
 		uint32_t _frame;
 
 		VkImage _depthImage;
-		VkDeviceMemory _depthImageMemory;
+		MemoryAllocation _depthImageMemory;
 		VkImageView _depthImageView;
 
+		// device memory that buffers and images are sub-allocated from
+		VulkanMemorySource _memorySource;
+		MemoryAllocator _memoryAllocator;
+
+		// persistently mapped buffer that per-frame uniform data and staging uploads are written to
+		VkBuffer _uploadBuffer;
+		MemoryAllocation _uploadMemory;
+		RingBuffer _uploadRing;
+		VkDeviceSize _uniformAlignment;
+		VkDeviceSize _stagingAlignment;
+
+		// where the uniforms for the frame being recorded start in the upload ring, and the serial of that frame
+		VkDeviceSize _uniformStart;
+		uint64_t _uniformSerial;
+
+		// batches buffer and image uploads, on the transfer queue
+		UploadQueue _uploadQueue;
+
+		// the queue families that resources written by the transfer queue are shared with, or empty if the graphics queue does transfers
+		std::vector<uint32_t> _sharedQueueFamilies;
+
+		// a mesh to draw this frame
+		struct MeshDraw
+		{
+			Matrix4 transform;
+			MeshComponent const* mesh;
+		};
+
+		// a world sprite to draw this frame, before it has been sorted
+		struct SpriteInstance
+		{
+			Ref<Material> material;
+			SpritePushData data;
+		};
+
+		// a UI sprite to draw this frame
+		struct UIDraw
+		{
+			UITransformComponent const* ui;
+			SpriteComponent const* sprite;
+		};
+
+		// the draws for this frame, and the queues that sort them
+		RenderQueue _meshQueue;
+		std::vector<MeshDraw> _meshDraws;
+		RenderQueue _spriteQueue;
+		std::vector<SpriteInstance> _spriteInstances;
+		RenderQueue _uiQueue;
+		std::vector<UIDraw> _uiDraws;
+
+		// the camera being drawn with, used to find the depth of each mesh
+		Vector3 _cameraPosition;
+		Vector3 _cameraForward;
+		float _cameraFar;
+
+		// the world sprites to draw this frame, grouped into instanced draws
+		SpriteBatch _spriteBatch;
+
+		// storage buffers that the sprite instance data is written to, one per frame in the flight
+		std::array<Ref<Buffer>, MAX_FRAMES_IN_FLIGHT> _spriteInstanceBuffers;
+
 		static RenderEngine* _instance;
 	public:
 		/// <summary>
@@ -162,6 +231,24 @@ namespace Minty
 		/// <returns></returns>
 		VkRenderPass get_render_pass() const;
 
+		/// <summary>
+		/// Gets the MemoryAllocator that buffers and images are allocated from.
+		/// </summary>
+		/// <returns></returns>
+		MemoryAllocator& get_memory_allocator();
+
+		/// <summary>
+		/// Gets the usage of the device memory that buffers and images are allocated from.
+		/// </summary>
+		/// <returns></returns>
+		MemoryStatistics get_memory_statistics() const;
+
+		/// <summary>
+		/// Gets the world sprites drawn in the last frame, and the instanced draws they were grouped into.
+		/// </summary>
+		/// <returns></returns>
+		SpriteBatch const& get_sprite_batch() const;
+
 		/// <summary>
 		/// Gets the current frame index.
 		/// </summary>
@@ -223,6 +310,21 @@ namespace Minty
 		/// </summary>
 		void create_logical_device();
 
+		/// <summary>
+		/// Creates the allocator that buffers and images get their device memory from.
+		/// </summary>
+		void create_memory_allocator();
+
+		/// <summary>
+		/// Creates the ring buffer that per-frame uniform data and staging uploads are written to.
+		/// </summary>
+		void create_upload_ring();
+
+		/// <summary>
+		/// Creates the queue that buffer and image uploads are batched into.
+		/// </summary>
+		void create_upload_queue();
+
 		/// <summary>
 		/// Creates the swap chain.
 		/// </summary>
@@ -331,8 +433,9 @@ namespace Minty
 		/// <param name="size">The size of the buffer.</param>
 		/// <param name="usage">How the buffer will be used.</param>
 		/// <param name="properties">The memory properties.</param>
+		/// <param name="strategy">How the memory for the buffer will be used. Use Linear for short lived buffers, such as staging buffers.</param>
 		/// <returns>The ID of the new buffer.</returns>
-		Ref<Buffer> create_buffer(VkDeviceSize const size, VkBufferUsageFlags const usage, VkMemoryPropertyFlags const properties);
+		Ref<Buffer> create_buffer(VkDeviceSize const size, VkBufferUsageFlags const usage, VkMemoryPropertyFlags const properties, MemoryStrategy const strategy = MemoryStrategy::FreeList);
 
 		/// <summary>
 		/// Creates a uniform buffer.
@@ -348,14 +451,14 @@ namespace Minty
 		void destroy_buffer(Ref<Buffer> const buffer);
 
 		/// <summary>
-		/// Maps the buffer data to a pointer in memory.
+		/// Maps the buffer data to a pointer in memory. Host visible buffers stay mapped for as long as they live, so this does not call into the device.
 		/// </summary>
 		/// <param name="id">The ID of the buffer to map.</param>
 		/// <returns>A pointer to the buffer data in memory.</returns>
 		void* map_buffer(Ref<Buffer> const buffer) const;
 
 		/// <summary>
-		/// Unmaps the buffer data from memory. The invalidates the pointer given from map_buffer for the same ID.
+		/// Unmaps the buffer data from memory. The pointer given from map_buffer should no longer be used after this is called.
 		/// </summary>
 		/// <param name="id">The ID of the buffer to unmap.</param>
 		void unmap_buffer(Ref<Buffer> const buffer) const;
@@ -391,6 +494,72 @@ namespace Minty
 		/// <param name="size">The number of bytes to copy.</param>
 		void copy_buffer(Ref<Buffer> const src, Ref<Buffer> const dst, VkDeviceSize const size);
 
+		/// <summary>
+		/// Copies a range of the src buffer to the start of the dst buffer.
+		/// </summary>
+		/// <param name="src">The source buffer.</param>
+		/// <param name="srcOffset">The offset within the source buffer, in bytes.</param>
+		/// <param name="dst">The destination buffer.</param>
+		/// <param name="size">The number of bytes to copy.</param>
+		void copy_buffer(VkBuffer const src, VkDeviceSize const srcOffset, VkBuffer const dst, VkDeviceSize const size);
+
+		/// <summary>
+		/// Copies the given data into a device local buffer, through the upload ring when it fits, otherwise through a temporary staging buffer.
+		/// The copy is recorded into the upload queue, and is submitted with the rest of its batch.
+		/// </summary>
+		/// <param name="buffer">The buffer to copy the data to.</param>
+		/// <param name="data">The data to copy.</param>
+		/// <param name="size">The number of bytes to copy.</param>
+		/// <returns>The ticket to check if the upload is complete.</returns>
+		UploadTicket upload_buffer(Ref<Buffer> const buffer, void const* const data, VkDeviceSize const size);
+
+		/// <summary>
+		/// Copies the given pixel data into an image, through the upload ring when it fits, otherwise through a temporary staging buffer.
+		/// The image is left ready to be sampled by shaders. The copy is recorded into the upload queue, and is submitted with the rest of its batch.
+		/// </summary>
+		/// <param name="image">The image to copy the data to.</param>
+		/// <param name="data">The pixel data to copy.</param>
+		/// <param name="size">The number of bytes to copy.</param>
+		/// <param name="width">The width of the image.</param>
+		/// <param name="height">The height of the image.</param>
+		/// <returns>The ticket to check if the upload is complete.</returns>
+		UploadTicket upload_image(VkImage const image, void const* const data, VkDeviceSize const size, uint32_t const width, uint32_t const height);
+
+		/// <summary>
+		/// Copies the given data into the upload ring, so it can be used as the source of a transfer command.
+		/// </summary>
+		/// <param name="data">The data to copy.</param>
+		/// <param name="size">The number of bytes to copy.</param>
+		/// <returns>The range within the upload ring, or an empty allocation if it did not fit.</returns>
+		RingAllocation stage(void const* const data, VkDeviceSize const size);
+
+		/// <summary>
+		/// Copies the given uniform data into the upload ring, for the frame being recorded. Used with dynamic uniform buffers.
+		/// If the ring is full, waits for the device and for any staged uploads, so the space they used can be given back.
+		/// </summary>
+		/// <param name="data">The data to copy.</param>
+		/// <param name="size">The number of bytes to copy.</param>
+		/// <returns>The range within the upload ring, or an empty allocation if the uniforms for this frame fill the whole ring.</returns>
+		RingAllocation upload_uniform(void const* const data, VkDeviceSize const size);
+
+	private:
+		// stages the given data for an upload, in the ring if it fits, otherwise in a staging buffer that the upload queue keeps until it is done
+		RingAllocation stage_upload(void const* const data, VkDeviceSize const size);
+
+	public:
+
+		/// <summary>
+		/// Gets the ring buffer that per-frame uniform data and staging uploads are written to.
+		/// </summary>
+		/// <returns></returns>
+		RingBuffer const& get_upload_ring() const;
+
+		/// <summary>
+		/// Gets the queue that buffer and image uploads are batched into.
+		/// </summary>
+		/// <returns></returns>
+		UploadQueue& get_upload_queue();
+
 #pragma endregion
 
 #pragma region Drawing
@@ -401,12 +570,29 @@ namespace Minty
 	private:
 		void draw_scene(VkCommandBuffer commandBuffer);
 
+		// collects the meshes into the mesh queue, and starts sorting them
+		void prepare_meshes();
+
+		void draw_meshes(VkCommandBuffer commandBuffer);
+
 		void draw_mesh(VkCommandBuffer commandBuffer, Matrix4 const& transformationMatrix, MeshComponent const& meshComponent);
 
-		void draw_sprite(VkCommandBuffer commandBuffer, TransformComponent const& transformComponent, SpriteComponent const& spriteComponent);
+		// collects the world sprites into the sprite queue, starts sorting them, and makes sure the instance buffer for this frame can hold them
+		void prepare_sprites();
+
+		// groups the sorted world sprites into the sprite batch, writes their instance data, and draws them
+		void draw_sprites(VkCommandBuffer commandBuffer);
+
+		// collects the UI sprites into the UI queue, and starts sorting them
+		void prepare_ui_sprites();
+
+		void draw_ui_sprites(VkCommandBuffer commandBuffer);
 
 		void draw_ui(VkCommandBuffer commandBuffer, UITransformComponent const& uiComponent, SpriteComponent const& spriteComponent);
 
+		// gets the quantized distance of the given position in front of the camera, for sort keys
+		uint32_t get_depth(Vector3 const& position) const;
+
 #pragma endregion
 
 #pragma region Helper
@@ -423,8 +609,8 @@ namespace Minty
 		/// <param name="usage">How the image will be used.</param>
 		/// <param name="properties">The properties of the image.</param>
 		/// <param name="image">The image object to update/create values in.</param>
-		/// <param name="imageMemory">The memory location of where the image is stored.</param>
-		void create_image(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory);
+		/// <param name="imageMemory">The memory location of where the image is stored. Must be freed using the MemoryAllocator.</param>
+		void create_image(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, MemoryAllocation& imageMemory);
 
 		/// <summary>
 		/// Changes the image layout.
@@ -442,7 +628,8 @@ namespace Minty
 		/// <param name="image">The image to copy the data to.</param>
 		/// <param name="width">The width of the image.</param>
 		/// <param name="height">The height of the image.</param>
-		void copy_buffer_to_image(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+		/// <param name="offset">The offset of the data within the buffer, in bytes.</param>
+		void copy_buffer_to_image(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, VkDeviceSize offset = 0);
 
 		/// <summary>
 		/// Creates an image view, so the image can be seen.
@@ -465,7 +652,7 @@ namespace Minty
 		/// </summary>
 		/// <param name="code">The code loaded from a .spv file.</param>
 		/// <returns>The shader module.</returns>
-		VkShaderModule create_shader_module(std::vector<char> const& code) const;
+		VkShaderModule create_shader_module(std::span<char const> const code) const;
 
 #pragma endregion
 
@@ -0,0 +1,148 @@
+#include "pch.h"
+#include "Minty/Rendering/M_RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace Minty;
+
+// bit layout of a key, from most to least significant: layer 16, order 16, shader 12, material 12, depth 8
+constexpr uint32_t KEY_LAYER_SHIFT = 48;
+constexpr uint32_t KEY_ORDER_SHIFT = 32;
+constexpr uint32_t KEY_SHADER_SHIFT = 20;
+constexpr uint32_t KEY_MATERIAL_SHIFT = 8;
+constexpr uint32_t KEY_DEPTH_SHIFT = 0;
+
+constexpr uint32_t KEY_ID_MAX = (1u << 12) - 1;
+constexpr uint32_t KEY_DEPTH_MAX = (1u << 8) - 1;
+
+// the number of bits sorted by each radix pass
+constexpr uint32_t RADIX_BITS = 8;
+constexpr uint32_t RADIX_SIZE = 1u << RADIX_BITS;
+constexpr uint32_t RADIX_PASSES = 64 / RADIX_BITS;
+
+// maps a signed value to 16 unsigned bits, keeping the order
+static uint64_t to_key_field(int const value)
+{
+	return static_cast<uint64_t>(std::clamp(value, -32768, 32767) + 32768);
+}
+
+Minty::RenderQueue::~RenderQueue()
+{
+	wait();
+}
+
+uint64_t Minty::RenderQueue::make_key(int const layer, int const order, uint32_t const shader, uint32_t const material, uint32_t const depth)
+{
+	return
+		(to_key_field(layer) << KEY_LAYER_SHIFT) |
+		(to_key_field(order) << KEY_ORDER_SHIFT) |
+		(static_cast<uint64_t>(std::min(shader, KEY_ID_MAX)) << KEY_SHADER_SHIFT) |
+		(static_cast<uint64_t>(std::min(material, KEY_ID_MAX)) << KEY_MATERIAL_SHIFT) |
+		(static_cast<uint64_t>(std::min(depth, KEY_DEPTH_MAX)) << KEY_DEPTH_SHIFT);
+}
+
+uint32_t Minty::RenderQueue::get_id(void const* const object)
+{
+	auto [it, added] = _ids.try_emplace(object, static_cast<uint32_t>(_ids.size()));
+
+	return it->second;
+}
+
+void Minty::RenderQueue::clear()
+{
+	MINTY_ASSERT(_job.done());
+
+	_items.clear();
+	_ids.clear();
+}
+
+void Minty::RenderQueue::push(uint64_t const key, uint32_t const index)
+{
+	MINTY_ASSERT(_job.done());
+
+	_items.push_back(RenderQueueItem
+		{
+			.key = key,
+			.index = index,
+		});
+}
+
+void Minty::RenderQueue::sort()
+{
+	radix_sort(_items, _scratch);
+}
+
+void Minty::RenderQueue::sort_async()
+{
+	MINTY_ASSERT(_job.done());
+
+	// not worth a job
+	if (_items.size() < 2) return;
+
+	_job = JobSystem::instance().schedule([this]()
+		{
+			sort();
+		});
+}
+
+void Minty::RenderQueue::wait()
+{
+	if (!_job.valid()) return;
+
+	JobSystem::instance().wait(_job);
+	_job = JobHandle();
+}
+
+void Minty::RenderQueue::radix_sort(std::vector<RenderQueueItem>& items, std::vector<RenderQueueItem>& scratch)
+{
+	size_t const count = items.size();
+
+	if (count < 2) return;
+
+	scratch.resize(count);
+
+	// count every digit up front, so passes where every key has the same digit can be skipped
+	std::array<std::array<size_t, RADIX_SIZE>, RADIX_PASSES> histograms{};
+	for (RenderQueueItem const& item : items)
+	{
+		for (uint32_t pass = 0; pass < RADIX_PASSES; pass++)
+		{
+			histograms[pass][(item.key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)]++;
+		}
+	}
+
+	std::vector<RenderQueueItem>* source = &items;
+	std::vector<RenderQueueItem>* destination = &scratch;
+
+	for (uint32_t pass = 0; pass < RADIX_PASSES; pass++)
+	{
+		std::array<size_t, RADIX_SIZE>& histogram = histograms[pass];
+		uint32_t const shift = pass * RADIX_BITS;
+
+		// every key has the same digit, so this pass would not move anything
+		if (histogram[((*source)[0].key >> shift) & (RADIX_SIZE - 1)] == count) continue;
+
+		// turn counts into starting offsets
+		size_t offset = 0;
+		for (size_t& bucket : histogram)
+		{
+			size_t bucketCount = bucket;
+			bucket = offset;
+			offset += bucketCount;
+		}
+
+		for (RenderQueueItem const& item : *source)
+		{
+			(*destination)[histogram[(item.key >> shift) & (RADIX_SIZE - 1)]++] = item;
+		}
+
+		std::swap(source, destination);
+	}
+
+	// make sure the result ends up in the given items
+	if (source != &items)
+	{
+		items.swap(scratch);
+	}
+}
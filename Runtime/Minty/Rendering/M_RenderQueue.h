@@ -0,0 +1,128 @@
+#pragma once
+#include "Minty/Types/M_Object.h"
+
+#include "Minty/Multithreading/M_JobSystem.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace Minty
+{
+	/// <summary>
+	/// One draw within a RenderQueue.
+	/// </summary>
+	struct RenderQueueItem
+	{
+		/// <summary>
+		/// The sort key of the draw.
+		/// </summary>
+		uint64_t key;
+
+		/// <summary>
+		/// The index of the draw's data, as given when it was pushed.
+		/// </summary>
+		uint32_t index;
+	};
+
+	/// <summary>
+	/// Sorts the draws for a frame by a 64-bit key, so they can be recorded in order with as few pipeline and descriptor set binds as possible.
+	///
+	/// Keys sort ascending by layer, then order, then shader, then material, then depth.
+	/// Only the keys and indices are stored, so the data for each draw is kept by the caller.
+	/// Sorting can be done on a worker thread, in which case the RenderQueue must not be touched until wait() is called.
+	/// </summary>
+	class RenderQueue
+		: public Object
+	{
+	private:
+		std::vector<RenderQueueItem> _items;
+
+		// used as the second buffer while sorting
+		std::vector<RenderQueueItem> _scratch;
+
+		// dense IDs for the objects used within the keys, in the order they were first seen this frame
+		std::unordered_map<void const*, uint32_t> _ids;
+
+		// the job sorting the items, if any
+		JobHandle _job;
+
+	public:
+		RenderQueue() = default;
+
+		~RenderQueue();
+
+		RenderQueue(RenderQueue const& other) = delete;
+
+		RenderQueue& operator=(RenderQueue const& other) = delete;
+
+		/// <summary>
+		/// Packs the given values into a sort key. Values outside of the range of their field are clamped.
+		/// </summary>
+		/// <param name="layer">The layer, 16 bits, signed.</param>
+		/// <param name="order">The order within the layer, 16 bits, signed.</param>
+		/// <param name="shader">The ID of the shader, 12 bits.</param>
+		/// <param name="material">The ID of the material, 12 bits.</param>
+		/// <param name="depth">The quantized depth, 8 bits.</param>
+		/// <returns>The sort key.</returns>
+		static uint64_t make_key(int const layer, int const order, uint32_t const shader, uint32_t const material, uint32_t const depth);
+
+		/// <summary>
+		/// Gets a small ID for the given object, to be used in a sort key. The same object gets the same ID until this RenderQueue is cleared.
+		/// </summary>
+		/// <param name="object"></param>
+		/// <returns></returns>
+		uint32_t get_id(void const* const object);
+
+		/// <summary>
+		/// Removes all of the draws, and forgets all of the IDs.
+		/// </summary>
+		void clear();
+
+		/// <summary>
+		/// Adds a draw.
+		/// </summary>
+		/// <param name="key">The sort key of the draw.</param>
+		/// <param name="index">The index of the draw's data.</param>
+		void push(uint64_t const key, uint32_t const index);
+
+		/// <summary>
+		/// Sorts the draws by key, on this thread. Draws with equal keys keep the order they were pushed in.
+		/// </summary>
+		void sort();
+
+		/// <summary>
+		/// Sorts the draws by key, on a worker thread.
+		/// </summary>
+		void sort_async();
+
+		/// <summary>
+		/// Waits for the draws to finish sorting, if they are being sorted on a worker thread.
+		/// </summary>
+		void wait();
+
+		/// <summary>
+		/// Gets the draws, sorted if sort() or wait() has been called.
+		/// </summary>
+		/// <returns></returns>
+		std::vector<RenderQueueItem> const& get_items() const { return _items; }
+
+		/// <summary>
+		/// Gets the number of draws.
+		/// </summary>
+		/// <returns></returns>
+		size_t size() const { return _items.size(); }
+
+		/// <summary>
+		/// Checks if there are no draws.
+		/// </summary>
+		/// <returns></returns>
+		bool empty() const { return _items.empty(); }
+
+		/// <summary>
+		/// Sorts the given items by key, using a least significant digit radix sort. Stable.
+		/// </summary>
+		/// <param name="items">The items to sort.</param>
+		/// <param name="scratch">A second buffer to sort with.</param>
+		static void radix_sort(std::vector<RenderQueueItem>& items, std::vector<RenderQueueItem>& scratch);
+	};
+}
\ No newline at end of file
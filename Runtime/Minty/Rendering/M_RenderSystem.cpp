@@ -22,6 +22,13 @@ using namespace Minty;
 using namespace Minty::vk;
 using namespace Minty::Builtin;
 
+Minty::RenderSystem::RenderSystem(Scene& scene)
+	: System::System("Render", scene)
+{
+	// only updates the camera, but stays on the main thread with the renderer
+	declare_reads<CameraComponent, TransformComponent, EnabledComponent>();
+}
+
 void Minty::RenderSystem::update(Time const time)
 {
 	// do nothing if no camera
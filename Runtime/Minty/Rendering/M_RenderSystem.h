@@ -30,8 +30,7 @@ namespace Minty
 		Entity _camera = NULL_ENTITY;
 
 	public:
-		RenderSystem(Scene& scene)
-			: System::System("Render", scene) {}
+		RenderSystem(Scene& scene);
 
 		~RenderSystem() = default;
 
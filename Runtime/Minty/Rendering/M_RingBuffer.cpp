@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "Minty/Rendering/M_RingBuffer.h"
+
+using namespace Minty;
+
+Minty::RingBuffer::RingBuffer()
+	: _buffer(VK_NULL_HANDLE)
+	, _mapped()
+	, _size()
+	, _head()
+	, _tail()
+	, _frameEnds()
+	, _serial(1)
+{}
+
+void Minty::RingBuffer::init(VkBuffer const buffer, void* const mapped, VkDeviceSize const size)
+{
+	_buffer = buffer;
+	_mapped = static_cast<Byte*>(mapped);
+	_size = size;
+	_head = 0;
+	_tail = 0;
+	_frameEnds.fill(0);
+	_serial = 1;
+}
+
+void Minty::RingBuffer::destroy()
+{
+	_buffer = VK_NULL_HANDLE;
+	_mapped = nullptr;
+	_size = 0;
+	_head = 0;
+	_tail = 0;
+	_frameEnds.fill(0);
+}
+
+RingAllocation Minty::RingBuffer::allocate(VkDeviceSize const size, VkDeviceSize const alignment)
+{
+	if (!_mapped || !size || size > _size) return RingAllocation();
+
+	VkDeviceSize position = (_head + alignment - 1) & ~(alignment - 1);
+	VkDeviceSize offset = position % _size;
+
+	// does not fit before the end, so skip to the start of the buffer
+	if (offset + size > _size)
+	{
+		position += _size - offset;
+		offset = 0;
+	}
+
+	// would overwrite a range that is still in use
+	if (position + size - _tail > _size) return RingAllocation();
+
+	_head = position + size;
+
+	return RingAllocation
+	{
+		.buffer = _buffer,
+		.offset = offset,
+		.mapped = _mapped + offset,
+	};
+}
+
+RingAllocation Minty::RingBuffer::upload(void const* const data, VkDeviceSize const size, VkDeviceSize const alignment)
+{
+	RingAllocation allocation = allocate(size, alignment);
+
+	if (allocation.mapped)
+	{
+		memcpy(allocation.mapped, data, static_cast<size_t>(size));
+	}
+
+	return allocation;
+}
+
+void Minty::RingBuffer::end_frame(uint32_t const frame)
+{
+	_frameEnds.at(frame) = _head;
+	_serial++;
+}
+
+void Minty::RingBuffer::retire(uint32_t const frame)
+{
+	// frames finish in order, so everything before this frame's end is free
+	_tail = std::max(_tail, _frameEnds.at(frame));
+}
+
+void Minty::RingBuffer::retire_all()
+{
+	// everything submitted is done, but anything allocated for the frame being recorded is still needed
+	for (VkDeviceSize const end : _frameEnds)
+	{
+		_tail = std::max(_tail, end);
+	}
+}
+
+void Minty::RingBuffer::retire_to(VkDeviceSize const position)
+{
+	_tail = std::max(_tail, std::min(position, _head));
+}
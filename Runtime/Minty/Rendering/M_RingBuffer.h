@@ -0,0 +1,136 @@
+#pragma once
+#include "Minty/Types/M_Object.h"
+#include "Minty/Core/M_Constants.h"
+
+#include "Minty/Libraries/M_Vulkan.h"
+
+#include <array>
+
+namespace Minty
+{
+	/// <summary>
+	/// A range of memory within a RingBuffer.
+	/// </summary>
+	struct RingAllocation
+	{
+		/// <summary>
+		/// The buffer that the range is within, or VK_NULL_HANDLE if the allocation failed.
+		/// </summary>
+		VkBuffer buffer = VK_NULL_HANDLE;
+
+		/// <summary>
+		/// The offset of the range within the buffer, in bytes.
+		/// </summary>
+		VkDeviceSize offset = 0;
+
+		/// <summary>
+		/// The start of the range in host memory.
+		/// </summary>
+		void* mapped = nullptr;
+	};
+
+	/// <summary>
+	/// Hands out short lived ranges of a persistently mapped buffer, such as per-frame uniform data and staging uploads.
+	///
+	/// Allocating is a pointer bump. The ranges used by a frame are given back once the fence for that frame has been waited on.
+	/// Only keeps track of which ranges are used, so the buffer itself is owned by the RenderEngine.
+	/// </summary>
+	class RingBuffer
+		: public Object
+	{
+	private:
+		VkBuffer _buffer;
+		Byte* _mapped;
+		VkDeviceSize _size;
+
+		// the positions of the next allocation, and of the oldest allocation still in use
+		// these only ever increase, the offset within the buffer is the position % _size
+		VkDeviceSize _head;
+		VkDeviceSize _tail;
+
+		// the head when each frame in the flight was submitted
+		std::array<VkDeviceSize, MAX_FRAMES_IN_FLIGHT> _frameEnds;
+
+		// the number of frames submitted, plus one
+		uint64_t _serial;
+
+	public:
+		RingBuffer();
+
+		/// <summary>
+		/// Initializes this RingBuffer.
+		/// </summary>
+		/// <param name="buffer">The buffer to allocate from.</param>
+		/// <param name="mapped">The start of the buffer in host memory.</param>
+		/// <param name="size">The size of the buffer, in bytes. Must be a multiple of any alignment that is allocated with.</param>
+		void init(VkBuffer const buffer, void* const mapped, VkDeviceSize const size);
+
+		/// <summary>
+		/// Resets this RingBuffer. The buffer must be destroyed separately.
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// Allocates a range within the buffer, for the frame currently being recorded.
+		/// </summary>
+		/// <param name="size">The size of the range, in bytes.</param>
+		/// <param name="alignment">The alignment of the range, in bytes. Must be a power of two.</param>
+		/// <returns>The allocation, or an empty allocation if the buffer is full.</returns>
+		RingAllocation allocate(VkDeviceSize const size, VkDeviceSize const alignment);
+
+		/// <summary>
+		/// Allocates a range within the buffer, and copies the given data into it.
+		/// </summary>
+		/// <param name="data">The data to copy.</param>
+		/// <param name="size">The size of the data, in bytes.</param>
+		/// <param name="alignment">The alignment of the range, in bytes. Must be a power of two.</param>
+		/// <returns>The allocation, or an empty allocation if the buffer is full.</returns>
+		RingAllocation upload(void const* const data, VkDeviceSize const size, VkDeviceSize const alignment);
+
+		/// <summary>
+		/// Marks everything allocated so far as used by the given frame. Called once the frame has been submitted.
+		/// </summary>
+		/// <param name="frame">The index of the frame within the flight.</param>
+		void end_frame(uint32_t const frame);
+
+		/// <summary>
+		/// Gives back everything that was used by the given frame. Called once the fence for the frame has been waited on.
+		/// </summary>
+		/// <param name="frame">The index of the frame within the flight.</param>
+		void retire(uint32_t const frame);
+
+		/// <summary>
+		/// Gives back everything that was used by the submitted frames. Called once the device is idle.
+		/// </summary>
+		void retire_all();
+
+		/// <summary>
+		/// Gives back everything allocated before the given position, including anything allocated for the frame being recorded.
+		/// Only called once nothing before that position is in use.
+		/// </summary>
+		/// <param name="position">A position given by get_position.</param>
+		void retire_to(VkDeviceSize const position);
+
+		/// <summary>
+		/// Gets the serial of the frame currently being recorded. Allocations made with a different serial may no longer be valid.
+		/// </summary>
+		/// <returns></returns>
+		uint64_t get_serial() const { return _serial; }
+
+		/// <summary>
+		/// Gets the position that the next allocation will be made at, or after.
+		/// </summary>
+		/// <returns></returns>
+		VkDeviceSize get_position() const { return _head; }
+
+		VkBuffer get_buffer() const { return _buffer; }
+
+		VkDeviceSize get_size() const { return _size; }
+
+		/// <summary>
+		/// Gets the number of bytes that are still in use.
+		/// </summary>
+		/// <returns></returns>
+		VkDeviceSize get_used_size() const { return _head - _tail; }
+	};
+}
\ No newline at end of file
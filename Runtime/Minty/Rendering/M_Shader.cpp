@@ -110,6 +110,11 @@ DescriptorSet const& Minty::Shader::get_global_descriptor_set() const
 	return _descriptorSet;
 }
 
+bool Minty::Shader::has_uniform_constant(String const& name) const
+{
+	return _uniformConstantInfos.contains(name);
+}
+
 void Minty::Shader::update_push_constant(VkCommandBuffer const commandBuffer, void const* const value, uint32_t const size, uint32_t const offset)
 {
 	// get info of push constant
@@ -404,6 +409,26 @@ DescriptorSet Minty::Shader::create_descriptor_set(uint32_t const set, bool cons
 
 				break;
 			}
+			case VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+			{
+				// no buffer, the values are copied into the upload ring when bound
+				data.values.resize(static_cast<size_t>(info.size));
+				data.dynamicOffset = 0;
+				data.uploadSerial = 0;
+
+				// not empty by default
+				data.empty = false;
+
+				break;
+			}
+			case VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+			{
+				// no buffer, one is given to it later
+
+				// empty by default, until the buffer id is set
+
+				break;
+			}
 			case VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
 			{
 				// resize image infos
@@ -93,6 +93,13 @@ namespace Minty
 		/// <returns></returns>
 		DescriptorSet const& get_global_descriptor_set() const;
 
+		/// <summary>
+		/// Checks if this Shader has a uniform constant with the given name, in any set.
+		/// </summary>
+		/// <param name="name"></param>
+		/// <returns></returns>
+		bool has_uniform_constant(String const& name) const;
+
 		/// <summary>
 		/// Updates the push constant.
 		/// </summary>
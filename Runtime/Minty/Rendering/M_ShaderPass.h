@@ -4,6 +4,7 @@
 #include "Minty/Rendering/M_DescriptorSet.h"
 
 #include "Minty/Libraries/M_Vulkan.h"
+#include <span>
 
 namespace Minty
 {
@@ -20,7 +21,10 @@ namespace Minty
 		struct ShaderStageInfo
 		{
 			VkShaderStageFlagBits stage;
-			std::vector<char> code;
+			/// <summary>
+			/// A view of the SPIR-V code. Must stay valid until the ShaderPass has been created.
+			/// </summary>
+			std::span<char const> code;
 			String entry;
 		};
 
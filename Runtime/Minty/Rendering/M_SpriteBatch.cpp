@@ -0,0 +1,30 @@
+#include "pch.h"
+#include "Minty/Rendering/M_SpriteBatch.h"
+
+using namespace Minty;
+
+void Minty::SpriteBatch::clear()
+{
+	_instances.clear();
+	_draws.clear();
+}
+
+void Minty::SpriteBatch::add(Ref<Material> const& material, SpritePushData const& instance)
+{
+	// extend the last draw, if it uses the same material
+	if (!_draws.empty() && _draws.back().material == material)
+	{
+		_draws.back().instanceCount++;
+	}
+	else
+	{
+		_draws.push_back(SpriteDraw
+			{
+				.material = material,
+				.firstInstance = static_cast<uint32_t>(_instances.size()),
+				.instanceCount = 1,
+			});
+	}
+
+	_instances.push_back(instance);
+}
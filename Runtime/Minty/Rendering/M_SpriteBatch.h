@@ -0,0 +1,91 @@
+#pragma once
+#include "Minty/Types/M_Object.h"
+
+#include "Minty/Rendering/M_SpritePushData.h"
+
+#include <vector>
+
+namespace Minty
+{
+	class Material;
+
+	/// <summary>
+	/// A run of sprite instances that can be drawn with one instanced draw call.
+	/// </summary>
+	struct SpriteDraw
+	{
+		/// <summary>
+		/// The Material that every instance in the draw uses.
+		/// </summary>
+		Ref<Material> material;
+
+		/// <summary>
+		/// The index of the first instance within the SpriteBatch.
+		/// </summary>
+		uint32_t firstInstance;
+
+		/// <summary>
+		/// The number of instances in the draw.
+		/// </summary>
+		uint32_t instanceCount;
+	};
+
+	/// <summary>
+	/// Collects the sprites to draw in a frame, and groups neighboring sprites that share a Material into instanced draws.
+	///
+	/// Sprites are drawn in the order they were added, so only neighbors are grouped, which keeps the layer order intact.
+	/// Does not touch the GPU, so it can be used without a RenderEngine.
+	/// </summary>
+	class SpriteBatch
+		: public Object
+	{
+	private:
+		std::vector<SpritePushData> _instances;
+		std::vector<SpriteDraw> _draws;
+
+	public:
+		SpriteBatch() = default;
+
+		/// <summary>
+		/// Removes all of the sprites, so the next frame can be collected.
+		/// </summary>
+		void clear();
+
+		/// <summary>
+		/// Adds a sprite to draw after the others.
+		/// </summary>
+		/// <param name="material">The Material the sprite is drawn with.</param>
+		/// <param name="instance">The per-sprite data.</param>
+		void add(Ref<Material> const& material, SpritePushData const& instance);
+
+		/// <summary>
+		/// Gets the per-sprite data for every sprite, in draw order.
+		/// </summary>
+		/// <returns></returns>
+		std::vector<SpritePushData> const& get_instances() const { return _instances; }
+
+		/// <summary>
+		/// Gets the instanced draws, in draw order.
+		/// </summary>
+		/// <returns></returns>
+		std::vector<SpriteDraw> const& get_draws() const { return _draws; }
+
+		/// <summary>
+		/// Gets the number of sprites in this SpriteBatch.
+		/// </summary>
+		/// <returns></returns>
+		uint32_t get_instance_count() const { return static_cast<uint32_t>(_instances.size()); }
+
+		/// <summary>
+		/// Gets the number of draw calls needed to draw every sprite in this SpriteBatch.
+		/// </summary>
+		/// <returns></returns>
+		uint32_t get_draw_count() const { return static_cast<uint32_t>(_draws.size()); }
+
+		/// <summary>
+		/// Checks if this SpriteBatch has no sprites.
+		/// </summary>
+		/// <returns></returns>
+		bool empty() const { return _instances.empty(); }
+	};
+}
\ No newline at end of file
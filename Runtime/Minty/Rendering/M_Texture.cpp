@@ -23,13 +23,14 @@ Texture::Texture(TextureBuilder const& builder)
 	, _view()
 	, _memory()
 	, _sampler()
+	, _uploadTicket()
 {
 	// determine how to load data
 	stbi_uc* pixels = reinterpret_cast<stbi_uc*>(builder.pixelData);
 	bool allocated = false;
 
 	Path const& path = builder.path;
-	bool fromFilePathSize = path.string().size();
+	bool fromFilePathSize = path.string().size() && !pixels;
 
 	if (fromFilePathSize)
 	{
@@ -39,13 +40,12 @@ Texture::Texture(TextureBuilder const& builder)
 			return;
 		}
 
-		// get data from file: pixels, width, height, color channels
-		int channels;
-
+		// get data from file: pixels, width, height
 		AssetEngine& assets = AssetEngine::instance();
-		std::vector<Byte> fileData = assets.read_file_bytes(path);
+		std::vector<char> buffer;
+		std::span<char const> fileData = assets.read_file_view(path, buffer);
 		//pixels = stbi_load(absPath.c_str(), &_width, &_height, &channels, static_cast<int>(builder.pixelFormat));
-		pixels = stbi_load_from_memory(fileData.data(), static_cast<int>(fileData.size()), &_width, &_height, &channels, static_cast<int>(builder.pixelFormat));
+		pixels = reinterpret_cast<stbi_uc*>(load_pixels(fileData, builder.pixelFormat, _width, _height));
 
 		// if no pixels, error
 		if (!pixels)
@@ -82,48 +82,28 @@ Texture::Texture(TextureBuilder const& builder)
 
 	RenderEngine& renderEngine = RenderEngine::instance();
 
-	// copy to device via a staging buffer
-
-	// create a buffer that can be used as the source of a transfer command
-	// the memory can be mapped, and specify that flush is not needed (we do not need to flush to make writes)
-	Ref<Buffer> stagingBuffer = renderEngine.create_buffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
 	VkDevice device = renderEngine.get_device();
 
-	// map memory and copy it to buffer memory
+	// image data
+	_format = static_cast<VkFormat>(builder.format);
+
+	// create the image on gpu
+	renderEngine.create_image(_width, _height, _format, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, _image, _memory);
 
-	void* mappedData = renderEngine.map_buffer(stagingBuffer);
-	memcpy(mappedData, pixels, static_cast<size_t>(imageSize));
-	renderEngine.unmap_buffer(stagingBuffer);
+	// copy pixel data to image, and prep it for rendering
+	// this is batched with the other uploads, so the pixels are staged now, but copied later
+	_uploadTicket = renderEngine.upload_image(_image, pixels, imageSize, static_cast<uint32_t>(_width), static_cast<uint32_t>(_height));
 
 	// done with the pixels from file
 	if (fromFilePathSize)
 	{
-		stbi_image_free(pixels);
+		free_pixels(reinterpret_cast<Color*>(pixels));
 	}
 	else if (allocated)
 	{
 		delete[] pixels;
 	}
 
-	// image data
-	_format = static_cast<VkFormat>(builder.format);
-
-	// create the image on gpu
-	renderEngine.create_image(_width, _height, _format, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, _image, _memory);
-
-	// prep texture for copying
-	renderEngine.change_image_layout(_image, _format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-	// copy pixel data to image
-	renderEngine.copy_buffer_to_image(stagingBuffer->get_buffer(), _image, _width, _height);
-
-	// prep texture for rendering
-	renderEngine.change_image_layout(_image, _format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-	// cleanup staging buffer, no longer needed
-	renderEngine.destroy_buffer(stagingBuffer);
-
 	// create view, so the shaders can access the image data
 	_view = renderEngine.create_image_view(_image, _format, VK_IMAGE_ASPECT_COLOR_BIT);
 
@@ -170,6 +150,22 @@ Minty::Texture::~Texture()
 	destroy();
 }
 
+Color* Minty::Texture::load_pixels(std::span<char const> const data, PixelFormat const pixelFormat, int& width, int& height)
+{
+	int channels;
+	return reinterpret_cast<Color*>(stbi_load_from_memory(reinterpret_cast<stbi_uc const*>(data.data()), static_cast<int>(data.size()), &width, &height, &channels, static_cast<int>(pixelFormat)));
+}
+
+void Minty::Texture::free_pixels(Color* const pixels)
+{
+	stbi_image_free(pixels);
+}
+
+bool Minty::Texture::is_ready() const
+{
+	return RenderEngine::instance().get_upload_queue().is_complete(_uploadTicket);
+}
+
 void Minty::Texture::destroy()
 {
 	if (!_width && !_height) return; // already destroyed
@@ -178,10 +174,13 @@ void Minty::Texture::destroy()
 
 	VkDevice device = renderer.get_device();
 
+	// cannot destroy the image while it is still being copied to
+	renderer.get_upload_queue().wait(_uploadTicket);
+
 	vkDestroySampler(device, _sampler, nullptr);
 	vkDestroyImageView(device, _view, nullptr);
 	vkDestroyImage(device, _image, nullptr);
-	vkFreeMemory(device, _memory, nullptr);
+	renderer.get_memory_allocator().free(_memory);
 
 	_width = 0;
 	_height = 0;
@@ -189,5 +188,4 @@ void Minty::Texture::destroy()
 	_sampler = VK_NULL_HANDLE;
 	_view = VK_NULL_HANDLE;
 	_image = VK_NULL_HANDLE;
-	_memory = VK_NULL_HANDLE;
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "Minty/Types/M_Color.h"
 #include "Minty/Rendering/M_PixelFormat.h"
+#include "Minty/Rendering/M_MemoryAllocator.h"
+#include "Minty/Rendering/M_UploadQueue.h"
 #include "Minty/Libraries/M_Vulkan.h"
 
 namespace Minty
@@ -19,7 +21,7 @@ namespace Minty
 		/// </summary>
 		Path path;
 		/// <summary>
-		/// The raw pixel data for the Texture.
+		/// The raw pixel data for the Texture. If set, it is used instead of loading the file at the path, and it is not freed by the Texture.
 		/// </summary>
 		Color* pixelData;
 		/// <summary>
@@ -64,9 +66,12 @@ namespace Minty
 		VkFormat _format;
 		VkImage _image;
 		VkImageView _view;
-		VkDeviceMemory _memory;
+		MemoryAllocation _memory;
 		VkSampler _sampler;
 
+		// the upload of the pixel data
+		UploadTicket _uploadTicket;
+
 	public:
 		/// <summary>
 		/// Creates an empty Texture.
@@ -87,6 +92,22 @@ namespace Minty
 		/// </summary>
 		void destroy();
 
+		/// <summary>
+		/// Decodes the pixels from the given image file data. Does not use the GPU, so it can be called from any thread.
+		/// </summary>
+		/// <param name="data">The image file data.</param>
+		/// <param name="pixelFormat">The format to read the pixels in.</param>
+		/// <param name="width">The width of the image, in pixels.</param>
+		/// <param name="height">The height of the image, in pixels.</param>
+		/// <returns>The decoded pixels, which must be freed using free_pixels, or null on failure.</returns>
+		static Color* load_pixels(std::span<char const> const data, PixelFormat const pixelFormat, int& width, int& height);
+
+		/// <summary>
+		/// Frees pixels that were decoded using load_pixels.
+		/// </summary>
+		/// <param name="pixels"></param>
+		static void free_pixels(Color* const pixels);
+
 		/// <summary>
 		/// Gets the width of this Texture in pixels.
 		/// </summary>
@@ -121,13 +142,19 @@ namespace Minty
 		/// Gets the device memory of this Texture.
 		/// </summary>
 		/// <returns></returns>
-		VkDeviceMemory get_device_memory() const { return _memory; }
+		VkDeviceMemory get_device_memory() const { return _memory.memory; }
 
 		/// <summary>
 		/// Gets the sampler of this Texture.
 		/// </summary>
 		/// <returns></returns>
 		VkSampler get_sampler() const { return _sampler; }
+
+		/// <summary>
+		/// Checks if the pixel data has finished uploading to the GPU.
+		/// </summary>
+		/// <returns></returns>
+		bool is_ready() const;
 	};
 }
 
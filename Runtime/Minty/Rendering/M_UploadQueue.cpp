@@ -0,0 +1,312 @@
+#include "pch.h"
+#include "Minty/Rendering/M_UploadQueue.h"
+
+#include "Minty/Rendering/M_RenderEngine.h"
+
+using namespace Minty;
+
+Minty::UploadQueue::UploadQueue()
+	: _device(VK_NULL_HANDLE)
+	, _queue(VK_NULL_HANDLE)
+	, _commandPool(VK_NULL_HANDLE)
+	, _batch()
+	, _recording()
+	, _submitted()
+	, _free()
+	, _signaled()
+	, _waited()
+	, _freeSemaphores()
+	, _nextTicket(1)
+	, _completedTicket()
+{}
+
+Minty::UploadQueue::~UploadQueue()
+{
+	destroy();
+}
+
+void Minty::UploadQueue::init(VkDevice const device, VkQueue const queue, uint32_t const queueFamily)
+{
+	_device = device;
+	_queue = queue;
+
+	VkCommandPoolCreateInfo poolInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+		.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+		.queueFamilyIndex = queueFamily,
+	};
+
+	VK_ASSERT(vkCreateCommandPool(_device, &poolInfo, nullptr, &_commandPool), "Failed to create upload command pool.");
+}
+
+void Minty::UploadQueue::destroy()
+{
+	if (_device == VK_NULL_HANDLE) return;
+
+	// finish everything
+	flush();
+	vkQueueWaitIdle(_queue);
+	update();
+
+	for (Batch& batch : _free)
+	{
+		vkDestroyFence(_device, batch.fence, nullptr);
+	}
+	_free.clear();
+
+	// free all semaphores
+	for (auto& waited : _waited)
+	{
+		_freeSemaphores.insert(_freeSemaphores.end(), waited.begin(), waited.end());
+		waited.clear();
+	}
+	_freeSemaphores.insert(_freeSemaphores.end(), _signaled.begin(), _signaled.end());
+	_signaled.clear();
+
+	for (VkSemaphore const semaphore : _freeSemaphores)
+	{
+		vkDestroySemaphore(_device, semaphore, nullptr);
+	}
+	_freeSemaphores.clear();
+
+	// also frees the command buffers
+	vkDestroyCommandPool(_device, _commandPool, nullptr);
+
+	_commandPool = VK_NULL_HANDLE;
+	_queue = VK_NULL_HANDLE;
+	_device = VK_NULL_HANDLE;
+}
+
+UploadTicket Minty::UploadQueue::copy_buffer(VkBuffer const src, VkDeviceSize const srcOffset, VkBuffer const dst, VkDeviceSize const size)
+{
+	begin();
+
+	VkBufferCopy copyRegion
+	{
+		.srcOffset = srcOffset,
+		.dstOffset = 0,
+		.size = size,
+	};
+	vkCmdCopyBuffer(_batch.commandBuffer, src, dst, 1, &copyRegion);
+
+	return _batch.ticket;
+}
+
+UploadTicket Minty::UploadQueue::copy_buffer_to_image(VkBuffer const src, VkDeviceSize const srcOffset, VkImage const image, uint32_t const width, uint32_t const height)
+{
+	begin();
+
+	VkImageMemoryBarrier barrier
+	{
+		.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+		.srcAccessMask = 0,
+		.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+		.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+		.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+		.image = image,
+		.subresourceRange =
+		{
+			.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+			.baseMipLevel = 0,
+			.levelCount = 1,
+			.baseArrayLayer = 0,
+			.layerCount = 1,
+		},
+	};
+
+	// prep image for copying
+	vkCmdPipelineBarrier(_batch.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	VkBufferImageCopy region
+	{
+		.bufferOffset = srcOffset,
+		.bufferRowLength = 0,
+		.bufferImageHeight = 0,
+		.imageSubresource =
+		{
+			.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+			.mipLevel = 0,
+			.baseArrayLayer = 0,
+			.layerCount = 1,
+		},
+		.imageOffset = { 0, 0, 0 },
+		.imageExtent = { width, height, 1 },
+	};
+	vkCmdCopyBufferToImage(_batch.commandBuffer, src, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+	// prep image for rendering
+	// the transfer queue cannot wait on shader stages, so the semaphore the frame waits on makes the writes visible instead
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = 0;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	vkCmdPipelineBarrier(_batch.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	return _batch.ticket;
+}
+
+void Minty::UploadQueue::keep(Ref<Buffer> const buffer)
+{
+	begin();
+
+	_batch.stagingBuffers.push_back(buffer);
+}
+
+void Minty::UploadQueue::flush()
+{
+	if (!_recording) return;
+
+	_recording = false;
+
+	VK_ASSERT(vkEndCommandBuffer(_batch.commandBuffer), "Failed to record upload command buffer.");
+
+	// get a semaphore for the next frame to wait on
+	VkSemaphore semaphore;
+	if (_freeSemaphores.empty())
+	{
+		VkSemaphoreCreateInfo semaphoreInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+		};
+
+		VK_ASSERT(vkCreateSemaphore(_device, &semaphoreInfo, nullptr, &semaphore), "Failed to create upload semaphore.");
+	}
+	else
+	{
+		semaphore = _freeSemaphores.back();
+		_freeSemaphores.pop_back();
+	}
+
+	VkSubmitInfo submitInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+		.commandBufferCount = 1,
+		.pCommandBuffers = &_batch.commandBuffer,
+		.signalSemaphoreCount = 1,
+		.pSignalSemaphores = &semaphore,
+	};
+
+	VK_ASSERT(vkQueueSubmit(_queue, 1, &submitInfo, _batch.fence), "Failed to submit upload command buffer.");
+
+	_signaled.push_back(semaphore);
+	_submitted.push_back(std::move(_batch));
+	_batch = Batch();
+}
+
+void Minty::UploadQueue::update()
+{
+	// batches complete in the order they were submitted
+	while (!_submitted.empty() && vkGetFenceStatus(_device, _submitted.front().fence) == VK_SUCCESS)
+	{
+		complete(_submitted.front());
+		_submitted.pop_front();
+	}
+}
+
+bool Minty::UploadQueue::is_complete(UploadTicket const ticket) const
+{
+	return ticket <= _completedTicket;
+}
+
+void Minty::UploadQueue::wait(UploadTicket const ticket)
+{
+	if (is_complete(ticket)) return;
+
+	// submit it, if it is the one being recorded
+	if (_recording && ticket >= _batch.ticket)
+	{
+		flush();
+	}
+
+	while (!_submitted.empty() && _submitted.front().ticket <= ticket)
+	{
+		Batch& batch = _submitted.front();
+
+		vkWaitForFences(_device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+
+		complete(batch);
+		_submitted.pop_front();
+	}
+}
+
+void Minty::UploadQueue::take_semaphores(uint32_t const frame, std::vector<VkSemaphore>& semaphores)
+{
+	semaphores.insert(semaphores.end(), _signaled.begin(), _signaled.end());
+
+	std::vector<VkSemaphore>& waited = _waited.at(frame);
+	waited.insert(waited.end(), _signaled.begin(), _signaled.end());
+
+	_signaled.clear();
+}
+
+void Minty::UploadQueue::retire(uint32_t const frame)
+{
+	std::vector<VkSemaphore>& waited = _waited.at(frame);
+
+	_freeSemaphores.insert(_freeSemaphores.end(), waited.begin(), waited.end());
+
+	waited.clear();
+}
+
+void Minty::UploadQueue::begin()
+{
+	if (_recording) return;
+
+	// reuse a complete batch, if any
+	if (_free.empty())
+	{
+		VkCommandBufferAllocateInfo allocInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+			.commandPool = _commandPool,
+			.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+			.commandBufferCount = 1,
+		};
+
+		VK_ASSERT(vkAllocateCommandBuffers(_device, &allocInfo, &_batch.commandBuffer), "Failed to allocate upload command buffer.");
+
+		VkFenceCreateInfo fenceInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+		};
+
+		VK_ASSERT(vkCreateFence(_device, &fenceInfo, nullptr, &_batch.fence), "Failed to create upload fence.");
+	}
+	else
+	{
+		_batch = std::move(_free.back());
+		_free.pop_back();
+
+		vkResetCommandBuffer(_batch.commandBuffer, 0);
+		vkResetFences(_device, 1, &_batch.fence);
+	}
+
+	_batch.ticket = _nextTicket++;
+	_recording = true;
+
+	VkCommandBufferBeginInfo beginInfo
+	{
+		.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+		.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+	};
+
+	VK_ASSERT(vkBeginCommandBuffer(_batch.commandBuffer, &beginInfo), "Failed to begin upload command buffer.");
+}
+
+void Minty::UploadQueue::complete(Batch& batch)
+{
+	_completedTicket = std::max(_completedTicket, batch.ticket);
+
+	// staging buffers are no longer needed
+	RenderEngine& renderer = RenderEngine::instance();
+	for (Ref<Buffer> const& buffer : batch.stagingBuffers)
+	{
+		renderer.destroy_buffer(buffer);
+	}
+	batch.stagingBuffers.clear();
+
+	_free.push_back(std::move(batch));
+}
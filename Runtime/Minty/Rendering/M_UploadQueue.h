@@ -0,0 +1,160 @@
+#pragma once
+#include "Minty/Types/M_Object.h"
+#include "Minty/Core/M_Constants.h"
+
+#include "Minty/Rendering/M_Buffer.h"
+#include "Minty/Libraries/M_Vulkan.h"
+
+#include <array>
+#include <deque>
+#include <vector>
+
+namespace Minty
+{
+	/// <summary>
+	/// Identifies the batch that an upload was recorded into. 0 means there is nothing to wait for.
+	/// </summary>
+	typedef uint64_t UploadTicket;
+
+	/// <summary>
+	/// Records buffer and image uploads into one command buffer, and submits them together, instead of submitting and waiting for each copy.
+	///
+	/// Each submitted batch signals a semaphore, which the next frame waits on before it uses any of the uploaded resources.
+	/// Uses a dedicated transfer queue, when the device has one.
+	/// </summary>
+	class UploadQueue
+		: public Object
+	{
+	private:
+		struct Batch
+		{
+			UploadTicket ticket;
+			VkCommandBuffer commandBuffer;
+			VkFence fence;
+
+			// staging buffers to destroy once the batch is complete
+			std::vector<Ref<Buffer>> stagingBuffers;
+		};
+
+		VkDevice _device;
+		VkQueue _queue;
+		VkCommandPool _commandPool;
+
+		// the batch being recorded, if _recording is true
+		Batch _batch;
+		bool _recording;
+
+		// batches that have been submitted, in the order they were submitted
+		std::deque<Batch> _submitted;
+
+		// batches that are complete, and can be recorded into again
+		std::vector<Batch> _free;
+
+		// semaphores signaled by submitted batches, that no frame has waited on yet
+		std::vector<VkSemaphore> _signaled;
+
+		// semaphores waited on by each frame in the flight
+		std::array<std::vector<VkSemaphore>, MAX_FRAMES_IN_FLIGHT> _waited;
+
+		// semaphores that can be signaled again
+		std::vector<VkSemaphore> _freeSemaphores;
+
+		// the ticket of the next batch to be recorded
+		UploadTicket _nextTicket;
+
+		// the ticket of the newest batch that is complete
+		UploadTicket _completedTicket;
+
+	public:
+		UploadQueue();
+
+		~UploadQueue();
+
+		UploadQueue(UploadQueue const& other) = delete;
+
+		UploadQueue& operator=(UploadQueue const& other) = delete;
+
+		/// <summary>
+		/// Initializes this UploadQueue.
+		/// </summary>
+		/// <param name="device">The device to record commands on.</param>
+		/// <param name="queue">The queue to submit the uploads to.</param>
+		/// <param name="queueFamily">The family of the queue.</param>
+		void init(VkDevice const device, VkQueue const queue, uint32_t const queueFamily);
+
+		/// <summary>
+		/// Waits for all uploads to finish, then destroys all of the Vulkan objects.
+		/// </summary>
+		void destroy();
+
+		/// <summary>
+		/// Records a copy from one buffer to another.
+		/// </summary>
+		/// <param name="src">The buffer to copy from.</param>
+		/// <param name="srcOffset">The offset within the source buffer, in bytes.</param>
+		/// <param name="dst">The buffer to copy to.</param>
+		/// <param name="size">The number of bytes to copy.</param>
+		/// <returns>The ticket of the batch that the copy was recorded into.</returns>
+		UploadTicket copy_buffer(VkBuffer const src, VkDeviceSize const srcOffset, VkBuffer const dst, VkDeviceSize const size);
+
+		/// <summary>
+		/// Records a copy from a buffer to the whole of an image. The image is moved from an undefined layout, to be ready to be sampled by shaders.
+		/// </summary>
+		/// <param name="src">The buffer to copy from.</param>
+		/// <param name="srcOffset">The offset within the source buffer, in bytes.</param>
+		/// <param name="image">The image to copy to.</param>
+		/// <param name="width">The width of the image.</param>
+		/// <param name="height">The height of the image.</param>
+		/// <returns>The ticket of the batch that the copy was recorded into.</returns>
+		UploadTicket copy_buffer_to_image(VkBuffer const src, VkDeviceSize const srcOffset, VkImage const image, uint32_t const width, uint32_t const height);
+
+		/// <summary>
+		/// Keeps the given staging buffer alive until the batch being recorded is complete, then destroys it.
+		/// </summary>
+		/// <param name="buffer"></param>
+		void keep(Ref<Buffer> const buffer);
+
+		/// <summary>
+		/// Submits the batch being recorded, if any.
+		/// </summary>
+		void flush();
+
+		/// <summary>
+		/// Checks which submitted batches are complete, and destroys their staging buffers.
+		/// </summary>
+		void update();
+
+		/// <summary>
+		/// Checks if the batch with the given ticket is complete.
+		/// </summary>
+		/// <param name="ticket"></param>
+		/// <returns></returns>
+		bool is_complete(UploadTicket const ticket) const;
+
+		/// <summary>
+		/// Waits for the batch with the given ticket to complete. Submits it first, if it is still being recorded.
+		/// </summary>
+		/// <param name="ticket"></param>
+		void wait(UploadTicket const ticket);
+
+		/// <summary>
+		/// Adds the semaphores that the given frame must wait on before using any uploaded resources.
+		/// </summary>
+		/// <param name="frame">The index of the frame within the flight.</param>
+		/// <param name="semaphores">The list of semaphores to add to.</param>
+		void take_semaphores(uint32_t const frame, std::vector<VkSemaphore>& semaphores);
+
+		/// <summary>
+		/// Recycles the semaphores that the given frame waited on. Called once the fence for the frame has been waited on.
+		/// </summary>
+		/// <param name="frame">The index of the frame within the flight.</param>
+		void retire(uint32_t const frame);
+
+	private:
+		// starts recording a batch, if not already recording
+		void begin();
+
+		// finishes the given batch, and makes it free to record into again
+		void complete(Batch& batch);
+	};
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Minty/Core/M_Window.h"
 #include "Minty/Assets/M_AssetEngine.h"
 #include "Minty/Entities/M_EntityRegistry.h"
+#include "Minty/Entities/M_TransformHierarchy.h"
 #include "Minty/Systems/M_SystemRegistry.h"
 
 #include "Minty/Components/M_TransformComponent.h"
@@ -25,6 +26,7 @@ using namespace Minty;
 Minty::Scene::Scene(SceneBuilder const& builder)
 	: Asset(builder.id, builder.path)
 	, _entities(new EntityRegistry(*this))
+	, _transforms(new TransformHierarchy(*_entities))
 	, _systems(new SystemRegistry(*this))
 	, _loaded()
 	, _registeredAssets()
@@ -34,6 +36,7 @@ Minty::Scene::Scene(SceneBuilder const& builder)
 
 Minty::Scene::~Scene()
 {
+	delete _transforms;
 	delete _entities;
 	delete _systems;
 }
@@ -41,6 +44,7 @@ Minty::Scene::~Scene()
 Minty::Scene::Scene(Scene&& other) noexcept
 	: Asset(std::move(other))
 	, _entities(std::move(other._entities))
+	, _transforms(std::move(other._transforms))
 	, _systems(std::move(other._systems))
 	, _loaded(std::move(other._loaded))
 	, _registeredAssets(std::move(other._registeredAssets))
@@ -53,6 +57,7 @@ Scene& Minty::Scene::operator=(Scene&& other) noexcept
 	if (this != &other)
 	{
 		_entities = std::move(other._entities);
+		_transforms = std::move(other._transforms);
 		_systems = std::move(other._systems);
 		_loaded = std::move(other._loaded);
 		_registeredAssets = std::move(other._registeredAssets);
@@ -130,31 +135,8 @@ void Minty::Scene::update(Time const time)
 
 void Minty::Scene::sort()
 {
-	EntityRegistry const* er = _entities;
-
-	// sort relationships
-	_entities->sort<RelationshipComponent>([er](Entity const left, Entity const right)
-		{
-			RelationshipComponent const& leftR = er->get<RelationshipComponent>(left);
-			RelationshipComponent const& rightR = er->get<RelationshipComponent>(right);
-
-			if (rightR.parent == left) return true;
-
-			if (leftR.next == right) return true;
-
-			if (leftR.parent == rightR.parent && leftR.index < rightR.index) return true;
-
-			// check for grandparents
-			Entity parent = er->get_parent(rightR.parent);
-			while (parent != NULL_ENTITY)
-			{
-				if (left == parent) return true;
-
-				parent = er->get_parent(parent);
-			}
-
-			return left < right;
-		});
+	// only re-orders the relationships if the hierarchy changed
+	_entities->sort_hierarchy();
 }
 
 void Minty::Scene::fixed_update(Time const time)
@@ -162,9 +144,8 @@ void Minty::Scene::fixed_update(Time const time)
 	if (Application::instance().get_mode() == ApplicationMode::Normal)
 	{
 		// update systems
+		// transforms are updated once per frame in finalize, not every fixed step
 		_systems->fixed_update(time);
-
-		// TODO: update transforms...
 	}
 }
 
@@ -183,36 +164,8 @@ void Minty::Scene::finalize()
 	// sort the hierarchy
 	sort();
 
-	// update dirty transform group with relationships
-	auto view = _entities->view<DirtyComponent const, TransformComponent, RelationshipComponent const>();
-	view.use<RelationshipComponent const>();
-	for (auto [entity, dirty, transform, relationship] : view.each())
-	{
-		// if parent, apply local to parent global for this global
-		// if no parent, set global to local
-		if (relationship.parent != NULL_ENTITY)
-		{
-			// parent
-
-			// get parent Transform, if any
-			if (TransformComponent* parentTransform = _entities->try_get<TransformComponent>(relationship.parent))
-			{
-				transform.globalMatrix = parentTransform->globalMatrix * transform.get_local_matrix();
-
-				continue;
-			}
-		}
-
-		// no parent
-		transform.globalMatrix = transform.get_local_matrix();
-	}
-	
-	// update dirty transform group with no relationships
-	for (auto [entity, dirty, transform] : _entities->view<DirtyComponent const, TransformComponent>(entt::exclude<RelationshipComponent>).each())
-	{
-		// no parent, set to self matrix
-		transform.globalMatrix = transform.get_local_matrix();
-	}
+	// update dirty transforms, and their children, one depth at a time
+	_transforms->update();
 
 	Window& window = Window::main();
 	RectF windowRect(0, 0, window.get_frame_width(), window.get_frame_height());
@@ -324,11 +277,19 @@ void Minty::Scene::load_registered_assets()
 	// load each asset into the engine and save its ID so it can be unloaded later
 	AssetEngine& assets = AssetEngine::instance();
 
+	// start loading all of them at once, they are created in order, so dependencies are created first
+	std::vector<AssetHandle<Asset>> handles;
+	handles.reserve(_unloadedAssets.size());
 	for (auto const& path : _unloadedAssets)
 	{
-		if (Ref<Asset> asset = assets.load_asset(path))
+		handles.push_back(assets.load_async<Asset>(path));
+	}
+
+	for (size_t i = 0; i < handles.size(); i++)
+	{
+		if (Ref<Asset> asset = handles.at(i).get())
 		{
-			AssetData& data = _registeredAssets.at(path);
+			AssetData& data = _registeredAssets.at(_unloadedAssets.at(i));
 
 			_loadedAssets.emplace(asset->get_id());
 			data.id = asset->get_id();
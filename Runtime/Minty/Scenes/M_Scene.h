@@ -9,6 +9,7 @@
 namespace Minty
 {
 	class EntityRegistry;
+	class TransformHierarchy;
 	class SystemRegistry;
 	class AssetEngine;
 
@@ -34,6 +35,7 @@ namespace Minty
 
 	private:
 		EntityRegistry* _entities;
+		TransformHierarchy* _transforms;
 		SystemRegistry* _systems;
 		bool _loaded;
 
@@ -6,6 +6,7 @@
 #include "Minty/Scripting/M_ScriptObject.h"
 #include "Minty/Scripting/M_ScriptEngine.h"
 #include "Minty/Scripting/M_ScriptArguments.h"
+#include "Minty/Entities/M_EntityRegistry.h"
 
 using namespace Minty;
 
@@ -14,9 +15,24 @@ Minty::ScriptClass::ScriptClass(String const& namespaceName, String const& class
 	, _name(className)
 	, _assembly(&assembly)
 	, _class()
+	, _methods()
+	, _thunks()
+	, _componentTypeId(ERROR_COMPONENT_TYPE_ID)
 {
 	MonoImage* image = mono_assembly_get_image(assembly._assembly);
 	_class = mono_class_from_name(image, namespaceName.c_str(), className.c_str());
+
+	if (!_class) return;
+
+	// find the engine methods once, so they do not need to be looked up by name each time they are called
+	ScriptEngine& engine = ScriptEngine::instance();
+	for (size_t i = 0; i < SCRIPT_METHOD_COUNT; i++)
+	{
+		MonoMethod* method = engine.get_method(_class, to_string(static_cast<ScriptMethod>(i)));
+
+		_methods[i] = method;
+		_thunks[i] = method ? reinterpret_cast<ScriptMethodThunk>(mono_method_get_unmanaged_thunk(method)) : nullptr;
+	}
 }
 
 String Minty::ScriptClass::get_full_name() const
@@ -102,8 +118,29 @@ bool Minty::ScriptClass::has_method(String const& name) const
 	return ScriptEngine::instance().get_method(_class, name);
 }
 
+bool Minty::ScriptClass::has_method(ScriptMethod const method) const
+{
+	return _methods[static_cast<size_t>(method)];
+}
+
+ScriptMethodThunk Minty::ScriptClass::get_thunk(ScriptMethod const method) const
+{
+	return _thunks[static_cast<size_t>(method)];
+}
+
 MonoType* Minty::ScriptClass::get_type() const
 {
 	String fullName = get_full_name();
 	return mono_reflection_type_from_name(fullName.data(), _assembly->_image);
 }
+
+ComponentTypeID Minty::ScriptClass::get_component_type_id() const
+{
+	// find it once, so the Component can be found without looking up its name each time
+	if (_componentTypeId == ERROR_COMPONENT_TYPE_ID)
+	{
+		_componentTypeId = EntityRegistry::get_component_type_id(_name);
+	}
+
+	return _componentTypeId;
+}
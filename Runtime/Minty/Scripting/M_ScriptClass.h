@@ -2,6 +2,8 @@
 #include "Minty/Types/M_Object.h"
 
 #include "Minty/Scripting/M_ScriptObject.h"
+#include "Minty/Scripting/M_ScriptMethod.h"
+#include <array>
 
 struct _MonoClass;
 typedef struct _MonoClass MonoClass;
@@ -9,6 +11,8 @@ struct _MonoObject;
 typedef struct _MonoObject MonoObject;
 struct _MonoType;
 typedef struct _MonoType MonoType;
+struct _MonoMethod;
+typedef struct _MonoMethod MonoMethod;
 
 namespace Minty
 {
@@ -21,6 +25,7 @@ namespace Minty
 		: public Object
 	{
 		friend class ScriptObject;
+		friend class ScriptEngine;
 
 	private:
 		// all the data is stored on the C# side
@@ -30,6 +35,13 @@ namespace Minty
 		ScriptAssembly* _assembly;
 		MonoClass* _class;
 
+		// the engine methods, found once when the class is loaded, or null if the class does not have them
+		std::array<MonoMethod*, SCRIPT_METHOD_COUNT> _methods;
+		std::array<ScriptMethodThunk, SCRIPT_METHOD_COUNT> _thunks;
+
+		// the type ID this class was registered with in the EntityRegistry, found the first time it is needed
+		mutable ComponentTypeID _componentTypeId;
+
 	public:
 		ScriptClass(String const& namespaceName, String const& className, ScriptAssembly& assembly);
 
@@ -55,6 +67,26 @@ namespace Minty
 
 		bool has_method(String const& name) const;
 
+		/// <summary>
+		/// Checks if this class has the given engine method.
+		/// </summary>
+		/// <param name="method"></param>
+		/// <returns></returns>
+		bool has_method(ScriptMethod const method) const;
+
+		/// <summary>
+		/// Gets the unmanaged thunk to the given engine method.
+		/// </summary>
+		/// <param name="method"></param>
+		/// <returns>The thunk, or null if this class does not have the method.</returns>
+		ScriptMethodThunk get_thunk(ScriptMethod const method) const;
+
 		MonoType* get_type() const;
+
+		/// <summary>
+		/// Gets the type ID of this class within the EntityRegistry, if it is a Component or Script.
+		/// </summary>
+		/// <returns>The type ID, or ERROR_COMPONENT_TYPE_ID if this class has not been registered.</returns>
+		ComponentTypeID get_component_type_id() const;
 	};
 }
\ No newline at end of file
@@ -12,7 +12,7 @@ using namespace Minty;
 
 void Minty::ScriptEventComponent::invoke(ScriptComponent const& script) const
 {
-	String method = get_method_name();
+	ScriptMethod method = get_method();
 
 	for (ID const id : scriptIds)
 	{
@@ -22,7 +22,7 @@ void Minty::ScriptEventComponent::invoke(ScriptComponent const& script) const
 
 void Minty::ScriptEventComponent::invoke(ScriptComponent const& script, std::unordered_set<String> const& componentNames) const
 {
-	String method = get_method_name();
+	ScriptMethod method = get_method();
 
 	for (String const& name : componentNames)
 	{
@@ -36,7 +36,7 @@ void Minty::ScriptEventComponent::invoke(ScriptComponent const& script, std::uno
 
 void Minty::ScriptEventComponent::invoke(ScriptComponent const& script, String const& componentName) const
 {
-	String method = get_method_name();
+	ScriptMethod method = get_method();
 
 	ID id = script.scripts.find(componentName);
 
@@ -41,123 +41,132 @@ namespace Minty
 
 		void invoke(ScriptComponent const& script, String const& componentName) const;
 
-		virtual char const* get_method_name() const = 0;
+		virtual ScriptMethod get_method() const = 0;
 	};
 
 	struct ScriptOnLoadComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONLOAD;
+			return ScriptMethod::OnLoad;
 		}
 	};
 
 	struct ScriptOnEnableComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONENABLE;
+			return ScriptMethod::OnEnable;
 		}
 	};
 
 	struct ScriptOnUpdateComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONUPDATE;
+			return ScriptMethod::OnUpdate;
+		}
+	};
+
+	struct ScriptOnFixedUpdateComponent
+		: public ScriptEventComponent
+	{
+		ScriptMethod get_method() const override
+		{
+			return ScriptMethod::OnFixedUpdate;
 		}
 	};
 
 	struct ScriptOnDisableComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONDISABLE;
+			return ScriptMethod::OnDisable;
 		}
 	};
 
 	struct ScriptOnUnloadComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONUNLOAD;
+			return ScriptMethod::OnUnload;
 		}
 	};
 
 	struct ScriptOnDestroyComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONDESTROY;
+			return ScriptMethod::OnDestroy;
 		}
 	};
 
 	struct ScriptOnPointerEnterComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONPOINTERENTER;
+			return ScriptMethod::OnPointerEnter;
 		}
 	};
 
 	struct ScriptOnPointerHoverComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONPOINTERHOVER;
+			return ScriptMethod::OnPointerHover;
 		}
 	};
 
 	struct ScriptOnPointerExitComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONPOINTEREXIT;
+			return ScriptMethod::OnPointerExit;
 		}
 	};
 
 	struct ScriptOnPointerMoveComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONPOINTERMOVE;
+			return ScriptMethod::OnPointerMove;
 		}
 	};
 
 	struct ScriptOnPointerDownComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONPOINTERDOWN;
+			return ScriptMethod::OnPointerDown;
 		}
 	};
 
 	struct ScriptOnPointerUpComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONPOINTERUP;
+			return ScriptMethod::OnPointerUp;
 		}
 	};
 
 	struct ScriptOnPointerClickComponent
 		: public ScriptEventComponent
 	{
-		char const* get_method_name() const override
+		ScriptMethod get_method() const override
 		{
-			return SCRIPT_METHOD_NAME_ONPOINTERCLICK;
+			return ScriptMethod::OnPointerClick;
 		}
 	};
 }
\ No newline at end of file
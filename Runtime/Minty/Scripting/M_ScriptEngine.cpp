@@ -50,6 +50,12 @@ Minty::ScriptEngine::ScriptEngine()
 	, _rootDomain()
 	, _appDomain()
 	, _assemblies()
+	, _idToName()
+	, _nameToId()
+	, _idToObject()
+	, _batchUpdate()
+	, _batchHandle()
+	, _batchCapacity()
 {
 	MINTY_ASSERT_MESSAGE(!_instance, "There should only be one ScriptEngine.");
 
@@ -76,6 +82,8 @@ Minty::ScriptEngine::~ScriptEngine()
 {
 	// mono_gc_collect(mono_gc_max_generation());
 
+	reset_batch();
+
 	// unload all assemblies
 	for (auto& pair : _assemblies)
 	{
@@ -154,6 +162,9 @@ void Minty::ScriptEngine::reload_assembly(String const& name)
 
 void Minty::ScriptEngine::unload_assembly(String const& name)
 {
+	// the batch method and array may belong to this assembly
+	reset_batch();
+
 	// delete assembly if there is one
 	auto found = _assemblies.find(name);
 	if (found != _assemblies.end())
@@ -438,6 +449,17 @@ void Minty::ScriptEngine::invoke_method(MonoObject* const object, MonoMethod* co
 	}
 }
 
+void Minty::ScriptEngine::invoke_thunk(MonoObject* const object, ScriptMethodThunk const thunk) const
+{
+	MonoObject* exception = nullptr;
+	thunk(object, &exception);
+
+	if (exception)
+	{
+		MINTY_ERROR(get_exception_message(exception));
+	}
+}
+
 String Minty::ScriptEngine::get_exception_message(MonoObject* const exception) const
 {
 	if (!exception) {
@@ -679,6 +701,67 @@ void Minty::ScriptEngine::destroy_object(UUID id)
 	}
 }
 
+void Minty::ScriptEngine::update_batch(std::vector<MonoObject*> const& objects)
+{
+	if (objects.empty()) return;
+
+	// find the managed method once
+	if (!_batchUpdate)
+	{
+		ScriptClass const* batchClass = find_class(ASSEMBLY_ENGINE_NAME, SCRIPT_BATCH_CLASS_NAME);
+		MINTY_ASSERT(batchClass != nullptr);
+
+		MonoMethod* method = get_method(batchClass->_class, SCRIPT_BATCH_METHOD_NAME_UPDATE, 2);
+		MINTY_ASSERT(method != nullptr);
+
+		_batchUpdate = reinterpret_cast<ScriptBatchThunk>(mono_method_get_unmanaged_thunk(method));
+	}
+
+	// grow the array if needed, it is reused between calls
+	if (objects.size() > _batchCapacity)
+	{
+		ScriptClass const* scriptClass = find_class(ASSEMBLY_ENGINE_NAME, "Script");
+		MINTY_ASSERT(scriptClass != nullptr);
+
+		if (_batchHandle) mono_gchandle_free(_batchHandle);
+
+		_batchCapacity = std::max(objects.size(), _batchCapacity * 2);
+		MonoArray* newArray = mono_array_new(_appDomain, scriptClass->_class, static_cast<uintptr_t>(_batchCapacity));
+		_batchHandle = mono_gchandle_new(reinterpret_cast<MonoObject*>(newArray), false);
+	}
+
+	// the array may be moved by the GC, so get it each time
+	MonoArray* array = reinterpret_cast<MonoArray*>(mono_gchandle_get_target(_batchHandle));
+
+	for (size_t i = 0; i < objects.size(); i++)
+	{
+		mono_array_setref(array, i, objects[i]);
+	}
+
+	MonoObject* exception = nullptr;
+	_batchUpdate(array, static_cast<int>(objects.size()), &exception);
+
+	if (exception)
+	{
+		MINTY_ERROR(get_exception_message(exception));
+	}
+
+	// do not keep the objects alive
+	for (size_t i = 0; i < objects.size(); i++)
+	{
+		mono_array_setref(array, i, nullptr);
+	}
+}
+
+void Minty::ScriptEngine::reset_batch()
+{
+	if (_batchHandle) mono_gchandle_free(_batchHandle);
+
+	_batchUpdate = nullptr;
+	_batchHandle = 0;
+	_batchCapacity = 0;
+}
+
 void Minty::ScriptEngine::register_script_id(UUID const id, String const& name)
 {
 	_idToName[id] = name;
@@ -3,6 +3,7 @@
 
 #include "Minty/Scripting/M_Accessibility.h"
 #include "Minty/Scripting/M_ScriptAssembly.h"
+#include "Minty/Scripting/M_ScriptMethod.h"
 #include <unordered_map>
 #include <unordered_set>
 
@@ -44,6 +45,11 @@ namespace Minty
 		std::unordered_map<String, UUID> _nameToId;
 		std::unordered_map<UUID, ScriptObject> _idToObject;
 
+		// the managed method that updates a batch of Scripts, and the array used to pass the Scripts to it
+		ScriptBatchThunk _batchUpdate;
+		uint32_t _batchHandle;
+		size_t _batchCapacity;
+
 		static ScriptEngine* _instance;
 	public:
 		ScriptEngine();
@@ -141,6 +147,9 @@ namespace Minty
 
 		void invoke_method(MonoObject* const object, MonoMethod* const method, std::vector<void*>& arguments) const;
 
+		// calls the thunk directly, without going through mono_runtime_invoke
+		void invoke_thunk(MonoObject* const object, ScriptMethodThunk const thunk) const;
+
 		String get_exception_message(MonoObject* const exception) const;
 
 		MonoObject* create_instance(MonoClass* const classType) const;
@@ -182,6 +191,16 @@ namespace Minty
 
 		void destroy_object(UUID id);
 
+		/// <summary>
+		/// Calls OnUpdate on each of the given objects, with one call into the engine assembly, which loops over them.
+		/// </summary>
+		/// <param name="objects">The objects, which must all be of the same ScriptClass.</param>
+		void update_batch(std::vector<MonoObject*> const& objects);
+
+	private:
+		// forgets the batch method and array, so they are found again in the next loaded assembly
+		void reset_batch();
+
 #pragma endregion
 
 #pragma region IDs
@@ -44,6 +44,7 @@
 #include "Minty/Rendering/M_RenderableComponent.h"
 #include "Minty/Scripting/M_ScriptComponent.h"
 #include "Minty/Rendering/M_SpriteComponent.h"
+#include "Minty/Components/M_TagComponent.h"
 #include "Minty/Components/M_TransformComponent.h"
 #include "Minty/UI/M_UITransformComponent.h"
 
@@ -59,6 +60,28 @@ struct ScriptEngineData
 
 static ScriptEngineData _data;
 
+/// <summary>
+/// The Entity cached by a managed Entity, so the internal calls do not need to find it by its ID.
+/// Matches EntityHandle in the engine assembly.
+/// </summary>
+struct ScriptEntityHandle
+{
+	uint32_t entity;
+	uint32_t generation;
+};
+
+/// <summary>
+/// The local transform of an Entity, as it is copied in bulk to and from scripts.
+/// Matches TransformData in the engine assembly.
+/// </summary>
+struct ScriptTransformData
+{
+	Vector3 localPosition;
+	Vector4 localRotation;
+	Vector3 localScale;
+};
+static_assert(sizeof(ScriptTransformData) == sizeof(float) * 10, "ScriptTransformData must match TransformData in the engine assembly.");
+
 constexpr static char const* INTERNAL_CLASS_NAME = "Runtime";
 
 #define ADD_INTERNAL_CALL(csharpName, cppName) mono_add_internal_call(std::format("{}.{}::{}", ASSEMBLY_ENGINE_NAME, INTERNAL_CLASS_NAME, csharpName).c_str(), cppName)
@@ -109,29 +132,49 @@ static Entity util_get_entity(UUID id)
 	return entity;
 }
 
-static CameraComponent& util_get_camera_component(UUID id)
+// gets the Entity from the handle cached by the managed Entity, or finds it by its ID and caches it, if the handle is out of date
+static Entity util_get_entity(UUID id, ScriptEntityHandle* handle)
 {
-	MINTY_ASSERT(id.valid());
-
 	EntityRegistry& registry = util_get_entity_registry();
 
+	// the cached Entity can be used if it is from this registry, and it has not been destroyed
+	if (handle->generation == registry.get_generation())
+	{
+		Entity entity = static_cast<Entity>(handle->entity);
+
+		if (registry.valid(entity)) return entity;
+	}
+
 	Entity entity = registry.find_by_id(id);
 	MINTY_ASSERT(entity != NULL_ENTITY);
 
+	handle->entity = static_cast<uint32_t>(entt::to_integral(entity));
+	handle->generation = registry.get_generation();
+
+	return entity;
+}
+
+static CameraComponent& util_get_camera_component(UUID id, ScriptEntityHandle* handle)
+{
+	MINTY_ASSERT(id.valid());
+
+	EntityRegistry& registry = util_get_entity_registry();
+
+	Entity entity = util_get_entity(id, handle);
+
 	CameraComponent* component = registry.try_get<CameraComponent>(entity);
 	MINTY_ASSERT(component != nullptr);
 
 	return *component;
 }
 
-static TransformComponent& util_get_transform_component(UUID id, bool setDirty)
+static TransformComponent& util_get_transform_component(UUID id, ScriptEntityHandle* handle, bool setDirty)
 {
 	MINTY_ASSERT(id.valid());
 
 	EntityRegistry& registry = util_get_entity_registry();
 
-	Entity entity = registry.find_by_id(id);
-	MINTY_ASSERT(entity != NULL_ENTITY);
+	Entity entity = util_get_entity(id, handle);
 
 	// if set dirty, do that
 	if (setDirty)
@@ -159,6 +202,16 @@ static float time_get_elapsed()
 	return Application::instance().get_time().elapsed;
 }
 
+static float time_get_fixed_step()
+{
+	return Application::instance().get_time().fixed.step;
+}
+
+static float time_get_fixed_alpha()
+{
+	return Application::instance().get_time().fixed.alpha;
+}
+
 #pragma endregion
 
 #pragma region Console
@@ -294,15 +347,14 @@ static void entity_set_tag(UUID id, MonoString* string)
 	registry.set_tag(entity, name);
 }
 
-static void entity_set_enabled(UUID id, bool enabled)
+static void entity_set_enabled(UUID id, ScriptEntityHandle* handle, bool enabled)
 {
 	MINTY_ASSERT(id.valid());
 
 	EntityRegistry& registry = util_get_entity_registry();
 
 	// get the entity
-	Entity entity = registry.find_by_id(id);
-	MINTY_ASSERT(entity != NULL_ENTITY);
+	Entity entity = util_get_entity(id, handle);
 
 	if (enabled)
 	{
@@ -314,15 +366,14 @@ static void entity_set_enabled(UUID id, bool enabled)
 	}
 }
 
-static bool entity_get_enabled(UUID id)
+static bool entity_get_enabled(UUID id, ScriptEntityHandle* handle)
 {
 	MINTY_ASSERT(id.valid());
 
 	EntityRegistry& registry = util_get_entity_registry();
 
 	// get the entity
-	Entity entity = registry.find_by_id(id);
-	MINTY_ASSERT(entity != NULL_ENTITY);
+	Entity entity = util_get_entity(id, handle);
 
 	return registry.all_of<EnabledComponent>(entity);
 }
@@ -347,13 +398,15 @@ static MonoObject* entity_add_component(UUID id, MonoReflectionType* reflectionT
 	}
 	ScriptClass const* scriptClass = found->second;
 
-	// get the component by name
-	ScriptObjectComponent* component = static_cast<ScriptObjectComponent*>(registry.get_by_name(scriptClass->get_name(), entity));
+	// get the component by its type
+	ComponentTypeID componentTypeId = scriptClass->get_component_type_id();
+	MINTY_ASSERT(componentTypeId != ERROR_COMPONENT_TYPE_ID);
+	ScriptObjectComponent* component = static_cast<ScriptObjectComponent*>(registry.get_by_type_id(componentTypeId, entity));
 
 	// if null, add the component
 	if (!component)
 	{
-		component = static_cast<ScriptObjectComponent*>(registry.emplace_by_name(scriptClass->get_name(), entity));
+		component = static_cast<ScriptObjectComponent*>(registry.emplace_by_type_id(componentTypeId, entity));
 	}
 
 	// create a new object for this component, if needed
@@ -382,8 +435,10 @@ static MonoObject* entity_get_component(UUID id, MonoReflectionType* reflectionT
 	}
 	ScriptClass const* scriptClass = found->second;
 
-	// get the component by name
-	ScriptObjectComponent* component = static_cast<ScriptObjectComponent*>(registry.get_by_name(scriptClass->get_name(), entity));
+	// get the component by its type
+	ComponentTypeID componentTypeId = scriptClass->get_component_type_id();
+	MINTY_ASSERT(componentTypeId != ERROR_COMPONENT_TYPE_ID);
+	ScriptObjectComponent* component = static_cast<ScriptObjectComponent*>(registry.get_by_type_id(componentTypeId, entity));
 
 	// if null, return null
 	if (!component)
@@ -578,71 +633,70 @@ static void window_restore(UUID id)
 
 #pragma region Camera
 
-static int camera_get_perspective(UUID id)
+static int camera_get_perspective(UUID id, ScriptEntityHandle* handle)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	return static_cast<int>(camera.camera.get_perspective());
 }
 
-static void camera_set_perspective(UUID id, int value)
+static void camera_set_perspective(UUID id, ScriptEntityHandle* handle, int value)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	camera.camera.set_perspective(static_cast<Perspective>(value));
 }
 
-static float camera_get_fov(UUID id)
+static float camera_get_fov(UUID id, ScriptEntityHandle* handle)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	return camera.camera.get_fov();
 }
 
-static void camera_set_fov(UUID id, float value)
+static void camera_set_fov(UUID id, ScriptEntityHandle* handle, float value)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	camera.camera.set_fov(value);
 }
 
-static float camera_get_near(UUID id)
+static float camera_get_near(UUID id, ScriptEntityHandle* handle)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	return camera.camera.get_near();
 }
 
-static void camera_set_near(UUID id, float value)
+static void camera_set_near(UUID id, ScriptEntityHandle* handle, float value)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	camera.camera.set_near(value);
 }
 
-static float camera_get_far(UUID id)
+static float camera_get_far(UUID id, ScriptEntityHandle* handle)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	return camera.camera.get_far();
 }
 
-static void camera_set_far(UUID id, float value)
+static void camera_set_far(UUID id, ScriptEntityHandle* handle, float value)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	camera.camera.set_far(value);
 }
 
-static void camera_set_as_main(UUID id)
+static void camera_set_as_main(UUID id, ScriptEntityHandle* handle)
 {
 	MINTY_ASSERT(id.valid());
 
 	Scene& scene = util_get_scene();
 	EntityRegistry& registry = scene.get_entity_registry();
 
-	Entity entity = registry.find_by_id(id);
-	MINTY_ASSERT(entity != NULL_ENTITY);
+	Entity entity = util_get_entity(id, handle);
 	MINTY_ASSERT(registry.all_of<CameraComponent>(entity));
 
 	// set main in render system
@@ -652,16 +706,16 @@ static void camera_set_as_main(UUID id)
 	renderSystem->set_camera(entity);
 }
 
-static Color::color_t camera_get_color(UUID id)
+static Color::color_t camera_get_color(UUID id, ScriptEntityHandle* handle)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	return static_cast<Color::color_t>(camera.camera.get_color());
 }
 
-static void camera_set_color(UUID id, Color::color_t value)
+static void camera_set_color(UUID id, ScriptEntityHandle* handle, Color::color_t value)
 {
-	CameraComponent& camera = util_get_camera_component(id);
+	CameraComponent& camera = util_get_camera_component(id, handle);
 
 	camera.camera.set_color(Color(value));
 }
@@ -670,69 +724,129 @@ static void camera_set_color(UUID id, Color::color_t value)
 
 #pragma region Transform
 
-static void transform_get_local_position(UUID id, Vector3* position)
+static void transform_get_local_position(UUID id, ScriptEntityHandle* handle, Vector3* position)
 {
-	TransformComponent& component = util_get_transform_component(id, false);
+	TransformComponent& component = util_get_transform_component(id, handle, false);
 
 	*position = component.localPosition;
 }
 
-static void transform_set_local_position(UUID id, Vector3* position)
+static void transform_set_local_position(UUID id, ScriptEntityHandle* handle, Vector3* position)
 {
-	TransformComponent& component = util_get_transform_component(id, true);
+	TransformComponent& component = util_get_transform_component(id, handle, true);
 
 	component.localPosition = *position;
 }
 
-static void transform_get_local_rotation(UUID id, Vector4* rotation)
+static void transform_get_local_rotation(UUID id, ScriptEntityHandle* handle, Vector4* rotation)
 {
-	TransformComponent& component = util_get_transform_component(id, false);
+	TransformComponent& component = util_get_transform_component(id, handle, false);
 
 	*rotation = Vector4(component.localRotation.y, component.localRotation.z, component.localRotation.x, component.localRotation.w);
 }
 
-static void transform_set_local_rotation(UUID id, Vector4* rotation)
+static void transform_set_local_rotation(UUID id, ScriptEntityHandle* handle, Vector4* rotation)
 {
-	TransformComponent& component = util_get_transform_component(id, true);
+	TransformComponent& component = util_get_transform_component(id, handle, true);
 
 	component.localRotation = Quaternion(rotation->w, rotation->y, rotation->z, rotation->x);
 }
 
-static void transform_get_local_scale(UUID id, Vector3* scale)
+static void transform_get_local_scale(UUID id, ScriptEntityHandle* handle, Vector3* scale)
 {
-	TransformComponent& component = util_get_transform_component(id, false);
+	TransformComponent& component = util_get_transform_component(id, handle, false);
 
 	*scale = component.localScale;
 }
 
-static void transform_set_local_scale(UUID id, Vector3* scale)
+static void transform_set_local_scale(UUID id, ScriptEntityHandle* handle, Vector3* scale)
 {
-	TransformComponent& component = util_get_transform_component(id, true);
+	TransformComponent& component = util_get_transform_component(id, handle, true);
 
 	component.localScale = *scale;
 }
 
-static void transform_get_right(UUID id, Vector3* direction)
+static void transform_get_right(UUID id, ScriptEntityHandle* handle, Vector3* direction)
 {
-	TransformComponent& component = util_get_transform_component(id, false);
+	TransformComponent& component = util_get_transform_component(id, handle, false);
 
 	*direction = component.get_right();
 }
 
-static void transform_get_up(UUID id, Vector3* direction)
+static void transform_get_up(UUID id, ScriptEntityHandle* handle, Vector3* direction)
 {
-	TransformComponent& component = util_get_transform_component(id, false);
+	TransformComponent& component = util_get_transform_component(id, handle, false);
 
 	*direction = component.get_up();
 }
 
-static void transform_get_forward(UUID id, Vector3* direction)
+static void transform_get_forward(UUID id, ScriptEntityHandle* handle, Vector3* direction)
 {
-	TransformComponent& component = util_get_transform_component(id, false);
+	TransformComponent& component = util_get_transform_component(id, handle, false);
 
 	*direction = component.get_forward();
 }
 
+static void transform_get_many(MonoArray* ids, MonoArray* transforms, int count)
+{
+	if (count <= 0) return;
+
+	MINTY_ASSERT(static_cast<uintptr_t>(count) <= mono_array_length(ids));
+	MINTY_ASSERT(static_cast<uintptr_t>(count) <= mono_array_length(transforms));
+
+	EntityRegistry& registry = util_get_entity_registry();
+
+	UUID const* idData = mono_array_addr(ids, UUID, 0);
+	ScriptTransformData* transformData = mono_array_addr(transforms, ScriptTransformData, 0);
+
+	for (int i = 0; i < count; i++)
+	{
+		Entity entity = registry.find_by_id(idData[i]);
+		MINTY_ASSERT(entity != NULL_ENTITY);
+
+		TransformComponent const& component = registry.get<TransformComponent>(entity);
+		ScriptTransformData& data = transformData[i];
+
+		data.localPosition = component.localPosition;
+		data.localRotation = Vector4(component.localRotation.y, component.localRotation.z, component.localRotation.x, component.localRotation.w);
+		data.localScale = component.localScale;
+	}
+}
+
+static void transform_set_many(MonoArray* ids, MonoArray* transforms, int count)
+{
+	if (count <= 0) return;
+
+	MINTY_ASSERT(static_cast<uintptr_t>(count) <= mono_array_length(ids));
+	MINTY_ASSERT(static_cast<uintptr_t>(count) <= mono_array_length(transforms));
+
+	EntityRegistry& registry = util_get_entity_registry();
+
+	UUID const* idData = mono_array_addr(ids, UUID, 0);
+	ScriptTransformData const* transformData = mono_array_addr(transforms, ScriptTransformData, 0);
+
+	std::vector<Entity> entities;
+	entities.reserve(static_cast<size_t>(count));
+
+	for (int i = 0; i < count; i++)
+	{
+		Entity entity = registry.find_by_id(idData[i]);
+		MINTY_ASSERT(entity != NULL_ENTITY);
+
+		TransformComponent& component = registry.get<TransformComponent>(entity);
+		ScriptTransformData const& data = transformData[i];
+
+		component.localPosition = data.localPosition;
+		component.localRotation = Quaternion(data.localRotation.w, data.localRotation.y, data.localRotation.z, data.localRotation.x);
+		component.localScale = data.localScale;
+
+		entities.push_back(entity);
+	}
+
+	// dirty them all at once
+	registry.dirty(entities);
+}
+
 #pragma endregion
 
 #pragma endregion
@@ -761,6 +875,7 @@ void Minty::ScriptLink::link()
 	register_component<RenderableComponent>(ASSEMBLY_ENGINE_NAME, "Renderable", true);
 	register_component<ScriptComponent>(ASSEMBLY_ENGINE_NAME, "Script", true);
 	register_component<SpriteComponent>(ASSEMBLY_ENGINE_NAME, "Sprite", true);
+	register_component<TagComponent>(ASSEMBLY_ENGINE_NAME, "Tag", false);
 	register_component<TransformComponent>(ASSEMBLY_ENGINE_NAME, "Transform", true);
 	register_component<UITransformComponent>(ASSEMBLY_ENGINE_NAME, "UITransform", true);
 
@@ -768,6 +883,8 @@ void Minty::ScriptLink::link()
 #pragma region Time
 	ADD_INTERNAL_CALL("Time_GetTotalTime", time_get_total);
 	ADD_INTERNAL_CALL("Time_GetElapsedTime", time_get_elapsed);
+	ADD_INTERNAL_CALL("Time_GetFixedStep", time_get_fixed_step);
+	ADD_INTERNAL_CALL("Time_GetFixedAlpha", time_get_fixed_alpha);
 #pragma endregion
 
 #pragma region Console
@@ -843,6 +960,8 @@ void Minty::ScriptLink::link()
 	ADD_INTERNAL_CALL("Transform_GetRight", transform_get_right);
 	ADD_INTERNAL_CALL("Transform_GetUp", transform_get_up);
 	ADD_INTERNAL_CALL("Transform_GetForward", transform_get_forward);
+	ADD_INTERNAL_CALL("Transform_GetMany", transform_get_many);
+	ADD_INTERNAL_CALL("Transform_SetMany", transform_set_many);
 #pragma endregion
 
 #pragma endregion
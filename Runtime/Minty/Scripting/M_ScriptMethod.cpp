@@ -0,0 +1,29 @@
+#include "pch.h"
+#include "Minty/Scripting/M_ScriptMethod.h"
+
+#include "Minty/Core/M_Constants.h"
+
+using namespace Minty;
+
+String Minty::to_string(ScriptMethod const value)
+{
+	switch (value)
+	{
+	case ScriptMethod::OnCreate: return SCRIPT_METHOD_NAME_ONCREATE;
+	case ScriptMethod::OnLoad: return SCRIPT_METHOD_NAME_ONLOAD;
+	case ScriptMethod::OnEnable: return SCRIPT_METHOD_NAME_ONENABLE;
+	case ScriptMethod::OnUpdate: return SCRIPT_METHOD_NAME_ONUPDATE;
+	case ScriptMethod::OnFixedUpdate: return SCRIPT_METHOD_NAME_ONFIXEDUPDATE;
+	case ScriptMethod::OnDisable: return SCRIPT_METHOD_NAME_ONDISABLE;
+	case ScriptMethod::OnUnload: return SCRIPT_METHOD_NAME_ONUNLOAD;
+	case ScriptMethod::OnDestroy: return SCRIPT_METHOD_NAME_ONDESTROY;
+	case ScriptMethod::OnPointerEnter: return SCRIPT_METHOD_NAME_ONPOINTERENTER;
+	case ScriptMethod::OnPointerHover: return SCRIPT_METHOD_NAME_ONPOINTERHOVER;
+	case ScriptMethod::OnPointerExit: return SCRIPT_METHOD_NAME_ONPOINTEREXIT;
+	case ScriptMethod::OnPointerMove: return SCRIPT_METHOD_NAME_ONPOINTERMOVE;
+	case ScriptMethod::OnPointerDown: return SCRIPT_METHOD_NAME_ONPOINTERDOWN;
+	case ScriptMethod::OnPointerUp: return SCRIPT_METHOD_NAME_ONPOINTERUP;
+	case ScriptMethod::OnPointerClick: return SCRIPT_METHOD_NAME_ONPOINTERCLICK;
+	default: return "";
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Minty/Types/M_Types.h"
+#include "Minty/Core/M_Macros.h"
+
+struct _MonoObject;
+typedef struct _MonoObject MonoObject;
+struct _MonoArray;
+typedef struct _MonoArray MonoArray;
+
+namespace Minty
+{
+	/// <summary>
+	/// The methods called on scripts by the engine.
+	/// </summary>
+	enum class ScriptMethod : uint8_t
+	{
+		OnCreate,
+		OnLoad,
+		OnEnable,
+		OnUpdate,
+		OnFixedUpdate,
+		OnDisable,
+		OnUnload,
+		OnDestroy,
+
+		OnPointerEnter,
+		OnPointerHover,
+		OnPointerExit,
+		OnPointerMove,
+		OnPointerDown,
+		OnPointerUp,
+		OnPointerClick,
+	};
+
+	/// <summary>
+	/// The number of ScriptMethods.
+	/// </summary>
+	constexpr size_t SCRIPT_METHOD_COUNT = static_cast<size_t>(ScriptMethod::OnPointerClick) + 1;
+
+	/// <summary>
+	/// An unmanaged thunk to a C# instance method with no parameters, which can be called directly.
+	/// </summary>
+#ifdef MINTY_WINDOWS
+	typedef void(__stdcall* ScriptMethodThunk)(MonoObject* object, MonoObject** exception);
+#else
+	typedef void(*ScriptMethodThunk)(MonoObject* object, MonoObject** exception);
+#endif
+
+	/// <summary>
+	/// An unmanaged thunk to the C# method that calls a method on an array of Scripts.
+	/// </summary>
+#ifdef MINTY_WINDOWS
+	typedef void(__stdcall* ScriptBatchThunk)(MonoArray* scripts, int count, MonoObject** exception);
+#else
+	typedef void(*ScriptBatchThunk)(MonoArray* scripts, int count, MonoObject** exception);
+#endif
+
+	String to_string(ScriptMethod const value);
+}
\ No newline at end of file
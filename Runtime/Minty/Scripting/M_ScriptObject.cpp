@@ -95,6 +95,26 @@ bool Minty::ScriptObject::try_invoke(String const& name, ScriptArguments& argume
 	return true;
 }
 
+void Minty::ScriptObject::invoke(ScriptMethod const method) const
+{
+	ScriptMethodThunk thunk = _script->get_thunk(method);
+
+	MINTY_ASSERT(thunk != nullptr);
+
+	ScriptEngine::instance().invoke_thunk(data(), thunk);
+}
+
+bool Minty::ScriptObject::try_invoke(ScriptMethod const method) const
+{
+	ScriptMethodThunk thunk = _script->get_thunk(method);
+
+	if (thunk == nullptr) return false;
+
+	ScriptEngine::instance().invoke_thunk(data(), thunk);
+
+	return true;
+}
+
 ScriptClass const& Minty::ScriptObject::get_class() const
 {
 	return *_script;
@@ -134,6 +154,40 @@ MonoObject* Minty::ScriptObject::data() const
 	//return mono_gchandle_get_target(_handle);
 }
 
+void Minty::ScriptObject::copy_fields(ScriptObject const& other) const
+{
+	MINTY_ASSERT(_script == other._script);
+
+	ScriptEngine& engine = ScriptEngine::instance();
+
+	// use the assembly to retrieve all of the fields for this object
+	std::vector<MonoClassField*> publicFields = engine.get_fields(_script->_class, Accessibility::Public);
+
+	MonoObject* source = other.data();
+	MonoObject* destination = data();
+
+	// copy the same fields that would be serialized, without converting them to text
+	for (MonoClassField* const field : publicFields)
+	{
+		MonoTypeEnum fieldTypeEnum = static_cast<MonoTypeEnum>(mono_type_get_type(engine.get_field_type(field)));
+
+		switch (fieldTypeEnum)
+		{
+		case MONO_TYPE_I4: // int
+		case MONO_TYPE_U4: // uint
+		case MONO_TYPE_R4: // float
+		{
+			uint32_t value;
+			engine.get_field_value(source, field, &value);
+			engine.set_field_value(destination, field, &value);
+			break;
+		}
+		default:
+			MINTY_TODO_FORMAT("ScriptObject::copy_fields(): missing type {}.", static_cast<int>(fieldTypeEnum));
+		}
+	}
+}
+
 void Minty::ScriptObject::serialize(Writer& writer) const
 {
 	ScriptEngine& engine = ScriptEngine::instance();
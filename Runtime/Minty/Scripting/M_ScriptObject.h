@@ -2,6 +2,7 @@
 #include "Minty/Components/M_ScriptObjectComponent.h"
 
 #include "Minty/Types/M_UUID.h"
+#include "Minty/Scripting/M_ScriptMethod.h"
 
 struct _MonoObject;
 typedef struct _MonoObject MonoObject;
@@ -40,6 +41,19 @@ namespace Minty
 
 		bool try_invoke(String const& name, ScriptArguments& arguments) const;
 
+		/// <summary>
+		/// Calls the given engine method, through the thunk cached by the ScriptClass. The class must have the method.
+		/// </summary>
+		/// <param name="method"></param>
+		void invoke(ScriptMethod const method) const;
+
+		/// <summary>
+		/// Calls the given engine method, through the thunk cached by the ScriptClass, if the class has the method.
+		/// </summary>
+		/// <param name="method"></param>
+		/// <returns>True if the method was called.</returns>
+		bool try_invoke(ScriptMethod const method) const;
+
 		ScriptClass const& get_class() const;
 		
 		void set_field(String const& name, void* const value) const;
@@ -52,6 +66,12 @@ namespace Minty
 
 		MonoObject* data() const;
 
+		/// <summary>
+		/// Copies the values of the serializable fields from the given ScriptObject, which must be of the same class.
+		/// </summary>
+		/// <param name="other"></param>
+		void copy_fields(ScriptObject const& other) const;
+
 	public:
 		void serialize(Writer& writer) const override;
 		void deserialize(Reader const& reader) override;
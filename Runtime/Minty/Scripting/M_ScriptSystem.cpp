@@ -15,19 +15,28 @@ using namespace Minty;
 
 Minty::ScriptSystem::ScriptSystem(Scene& scene)
 	: System("Script", scene)
-{}
+	, _batched(false)
+	, _batches()
+{
+	// scripts may do anything to the Entities, but do not need the whole engine to themselves
+	declare_structural();
+	declare_writes<ScriptComponent, ScriptOnLoadComponent, ScriptOnEnableComponent, ScriptOnUpdateComponent, ScriptOnFixedUpdateComponent, ScriptOnDisableComponent, ScriptOnUnloadComponent, TriggerScriptEvents>();
+	declare_reads<EnabledComponent>();
+}
 
 void Minty::ScriptSystem::load()
 {
 	System::load();
 
+	_batches.clear();
+
 	EntityRegistry& registry = get_entity_registry();
 
 	for (auto [entity, script, onload, enabled] : registry.view<ScriptComponent const, ScriptOnLoadComponent const, EnabledComponent const>().each())
 	{
 		for (auto const id : onload.scriptIds)
 		{
-			script.scripts.at(id).invoke(SCRIPT_METHOD_NAME_ONLOAD);
+			script.scripts.at(id).invoke(ScriptMethod::OnLoad);
 		}
 	}
 
@@ -35,7 +44,7 @@ void Minty::ScriptSystem::load()
 	{
 		for (auto const id : onenable.scriptIds)
 		{
-			script.scripts.at(id).invoke(SCRIPT_METHOD_NAME_ONENABLE);
+			script.scripts.at(id).invoke(ScriptMethod::OnEnable);
 		}
 	}
 
@@ -52,7 +61,7 @@ void Minty::ScriptSystem::update(Time const time)
 	{
 		for (auto const id : onload.scriptIds)
 		{
-			script.scripts.at(id).invoke(SCRIPT_METHOD_NAME_ONLOAD);
+			script.scripts.at(id).invoke(ScriptMethod::OnLoad);
 		}
 	}
 
@@ -60,25 +69,70 @@ void Minty::ScriptSystem::update(Time const time)
 	{
 		for (auto const id : onenable.scriptIds)
 		{
-			script.scripts.at(id).invoke(SCRIPT_METHOD_NAME_ONENABLE);
+			script.scripts.at(id).invoke(ScriptMethod::OnEnable);
 		}
 	}
 
 	// remove triggers
 	registry.clear<TriggerScriptEvents>();
 
-	// update as per normal
-	for (auto [entity, script, onupdate, enabled] : registry.view<ScriptComponent const, ScriptOnUpdateComponent const, EnabledComponent const>().each())
+	if (_batched)
+	{
+		// group the objects by class, so each class is updated with one call
+		for (auto& [script, objects] : _batches)
+		{
+			objects.clear();
+		}
+
+		for (auto [entity, script, onupdate, enabled] : registry.view<ScriptComponent const, ScriptOnUpdateComponent const, EnabledComponent const>().each())
+		{
+			for (auto const id : onupdate.scriptIds)
+			{
+				ScriptObject const& scriptObject = script.scripts.at(id);
+				_batches[&scriptObject.get_class()].push_back(scriptObject.data());
+			}
+		}
+
+		ScriptEngine& engine = ScriptEngine::instance();
+		for (auto const& [script, objects] : _batches)
+		{
+			engine.update_batch(objects);
+		}
+	}
+	else
 	{
-		for (auto const id : onupdate.scriptIds)
+		// update as per normal
+		for (auto [entity, script, onupdate, enabled] : registry.view<ScriptComponent const, ScriptOnUpdateComponent const, EnabledComponent const>().each())
 		{
-			script.scripts.at(id).invoke(SCRIPT_METHOD_NAME_ONUPDATE);
+			for (auto const id : onupdate.scriptIds)
+			{
+				script.scripts.at(id).invoke(ScriptMethod::OnUpdate);
+			}
 		}
 	}
 	
 	// unloading handled in finalize
 }
 
+bool Minty::ScriptSystem::has_fixed_update() const
+{
+	return !get_entity_registry().view<ScriptOnFixedUpdateComponent const>().empty();
+}
+
+void Minty::ScriptSystem::fixed_update(Time const time)
+{
+	EntityRegistry& registry = get_entity_registry();
+
+	// the thunks are cached on each ScriptClass, so this is a direct call per Script each step
+	for (auto [entity, script, onfixedupdate, enabled] : registry.view<ScriptComponent const, ScriptOnFixedUpdateComponent const, EnabledComponent const>().each())
+	{
+		for (auto const id : onfixedupdate.scriptIds)
+		{
+			script.scripts.at(id).invoke(ScriptMethod::OnFixedUpdate);
+		}
+	}
+}
+
 void Minty::ScriptSystem::unload()
 {
 	EntityRegistry& registry = get_entity_registry();
@@ -87,7 +141,7 @@ void Minty::ScriptSystem::unload()
 	{
 		for (auto const id : onload.scriptIds)
 		{
-			script.scripts.at(id).invoke(SCRIPT_METHOD_NAME_ONDISABLE);
+			script.scripts.at(id).invoke(ScriptMethod::OnDisable);
 		}
 	}
 
@@ -95,9 +149,19 @@ void Minty::ScriptSystem::unload()
 	{
 		for (auto const id : onunload.scriptIds)
 		{
-			script.scripts.at(id).invoke(SCRIPT_METHOD_NAME_ONUNLOAD);
+			script.scripts.at(id).invoke(ScriptMethod::OnUnload);
 		}
 	}
 
 	System::unload();
 }
+
+void Minty::ScriptSystem::serialize(Writer& writer) const
+{
+	writer.write("batched", _batched);
+}
+
+void Minty::ScriptSystem::deserialize(Reader const& reader)
+{
+	_batched = reader.read_bool("batched");
+}
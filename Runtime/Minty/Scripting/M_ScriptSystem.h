@@ -3,22 +3,59 @@
 
 #include "Minty/Types/M_Types.h"
 #include "Minty/Types/M_Time.h"
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
+
+struct _MonoObject;
+typedef struct _MonoObject MonoObject;
 
 namespace Minty
 {
+	class ScriptClass;
+
 	class ScriptSystem
 		: public System
 	{
+	private:
+		// if true, OnUpdate is called once per ScriptClass, instead of once per ScriptObject
+		bool _batched;
+
+		// the objects to update for each ScriptClass, reused each frame
+		std::unordered_map<ScriptClass const*, std::vector<MonoObject*>> _batches;
+
 	public:
 		ScriptSystem(Scene& scene);
 
+		/// <summary>
+		/// Sets if the Scripts are updated in batches, with one call into the engine assembly per ScriptClass.
+		/// Batched Scripts are updated in groups by class, rather than in Entity order.
+		/// </summary>
+		/// <param name="batched"></param>
+		void set_batched(bool const batched) { _batched = batched; }
+
+		/// <summary>
+		/// Checks if the Scripts are updated in batches.
+		/// </summary>
+		/// <returns></returns>
+		bool is_batched() const { return _batched; }
+
 		void load() override;
 
 		void update(Time const time) override;
 
-		//void fixed_update() override;
+		/// <summary>
+		/// Checks if any Script has an OnFixedUpdate method, so the fixed update can be skipped when none do.
+		/// </summary>
+		/// <returns></returns>
+		bool has_fixed_update() const override;
+
+		void fixed_update(Time const time) override;
 
 		void unload() override;
+
+	public:
+		void serialize(Writer& writer) const override;
+		void deserialize(Reader const& reader) override;
 	};
 }
\ No newline at end of file
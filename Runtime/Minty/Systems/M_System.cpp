@@ -13,6 +13,29 @@
 
 using namespace Minty;
 
+bool Minty::SystemAccess::conflicts_with(SystemAccess const& other) const
+{
+	if (exclusive || other.exclusive) return true;
+
+	// adding or removing components can move any component, so it conflicts with any use of components
+	bool const usesComponents = structural || !reads.empty() || !writes.empty();
+	bool const otherUsesComponents = other.structural || !other.reads.empty() || !other.writes.empty();
+	if ((structural && otherUsesComponents) || (other.structural && usesComponents)) return true;
+
+	// a write conflicts with any other use of the same component
+	for (TypeID const& type : writes)
+	{
+		if (other.writes.contains(type) || other.reads.contains(type)) return true;
+	}
+
+	for (TypeID const& type : other.writes)
+	{
+		if (reads.contains(type)) return true;
+	}
+
+	return false;
+}
+
 EntityRegistry& Minty::System::get_entity_registry() const
 {
 	return get_scene().get_entity_registry();
@@ -13,23 +13,88 @@ namespace Minty
 	class EntityRegistry;
 	class SystemRegistry;
 
+	/// <summary>
+	/// Ensures the storage for a component type exists in an EntityRegistry.
+	/// </summary>
+	typedef void (*SystemStorageFunc)(EntityRegistry& registry);
+
+	// creates the storage for T, if it does not exist yet
+	// the registry type is a template argument so that EntityRegistry only needs to be complete where this is used
+	template<typename T, typename Registry = EntityRegistry>
+	void system_storage(Registry& registry)
+	{
+		registry.template storage<T>();
+	}
+
+	/// <summary>
+	/// Describes which components a System uses while updating, so the SystemRegistry knows which Systems can run at the same time.
+	/// </summary>
+	struct SystemAccess
+	{
+		/// <summary>
+		/// The component types that are only read.
+		/// </summary>
+		std::unordered_set<TypeID> reads;
+
+		/// <summary>
+		/// The component types that are written to.
+		/// </summary>
+		std::unordered_set<TypeID> writes;
+
+		/// <summary>
+		/// Creates the storage for each read and written component type, so it is never created while Systems run at the same time.
+		/// </summary>
+		std::vector<SystemStorageFunc> storages;
+
+		/// <summary>
+		/// If true, the System may use anything, so it never runs at the same time as another System.
+		/// </summary>
+		bool exclusive = true;
+
+		/// <summary>
+		/// If true, the System may add or remove components of any type, or create or destroy Entities, such as by running Scripts.
+		/// It never runs at the same time as a System that uses any components, but may run alongside Systems that use none.
+		/// </summary>
+		bool structural = false;
+
+		/// <summary>
+		/// If true, the System must run on the main thread.
+		/// </summary>
+		bool mainThread = true;
+
+		/// <summary>
+		/// Checks if this access conflicts with the other access, meaning the two cannot run at the same time.
+		/// </summary>
+		/// <param name="other"></param>
+		/// <returns></returns>
+		bool conflicts_with(SystemAccess const& other) const;
+	};
+
 	/// <summary>
 	/// The base class for systems, which provide functionality and conduct the behavior of the ECS engine.
 	/// </summary>
 	class System
 		: public SceneObject
 	{
+		friend class SystemRegistry;
+
 	private:
 		// is this system enabled?
 		bool _enabled;
 
+		// true if the type of this system overrides fixed_update, set by the SystemRegistry when it creates the system
+		bool _fixedUpdate;
+
 		String _name;
+
+		// the components used by this system while updating
+		SystemAccess _access;
 	public:
 		/// <summary>
 		/// Creates a new System.
 		/// </summary>
 		System(String const& name, Scene& scene)
-			: SceneObject(scene), _enabled(true), _name(name) {}
+			: SceneObject(scene), _enabled(true), _fixedUpdate(false), _name(name) {}
 
 		virtual ~System() = default;
 
@@ -58,6 +123,65 @@ namespace Minty
 		/// <returns></returns>
 		bool is_enabled() const { return _enabled; }
 
+		/// <summary>
+		/// Gets the components this System uses while updating.
+		/// </summary>
+		/// <returns></returns>
+		SystemAccess const& get_access() const { return _access; }
+
+	protected:
+		/// <summary>
+		/// Declares that this System only reads the given component types while updating.
+		/// Systems that declare their access are no longer exclusive, and may run at the same time as other Systems.
+		/// </summary>
+		/// <typeparam name="...Ts"></typeparam>
+		template<typename... Ts>
+		void declare_reads()
+		{
+			_access.exclusive = false;
+			(declare_access<Ts>(_access.reads), ...);
+		}
+
+		/// <summary>
+		/// Declares that this System writes to the given component types while updating.
+		/// Systems that declare their access are no longer exclusive, and may run at the same time as other Systems.
+		/// </summary>
+		/// <typeparam name="...Ts"></typeparam>
+		template<typename... Ts>
+		void declare_writes()
+		{
+			_access.exclusive = false;
+			(declare_access<Ts>(_access.writes), ...);
+		}
+
+		/// <summary>
+		/// Declares that this System may add or remove components of any type, or create or destroy Entities, while updating.
+		/// Systems that declare their access are no longer exclusive, and may run at the same time as Systems that use no components.
+		/// </summary>
+		void declare_structural()
+		{
+			_access.exclusive = false;
+			_access.structural = true;
+		}
+
+		/// <summary>
+		/// Sets if this System must run on the main thread. True by default.
+		/// </summary>
+		/// <param name="mainThread"></param>
+		void set_main_thread(bool const mainThread) { _access.mainThread = mainThread; }
+
+	private:
+		template<typename T>
+		void declare_access(std::unordered_set<TypeID>& types)
+		{
+			if (types.emplace(typeid(T)).second)
+			{
+				_access.storages.push_back(&system_storage<T>);
+			}
+		}
+
+	public:
+
 		/// <summary>
 		/// Called when the Scene is being loaded.
 		/// </summary>
@@ -68,6 +192,13 @@ namespace Minty
 		/// </summary>
 		virtual void update(Time const time) {}
 
+		/// <summary>
+		/// Checks if this System has any work to do in fixed_update. The SystemRegistry skips the fixed update when no System does.
+		/// By default, this is true if the type of this System overrides fixed_update.
+		/// </summary>
+		/// <returns></returns>
+		virtual bool has_fixed_update() const { return _fixedUpdate; }
+
 		/// <summary>
 		/// Does one fixed frame of work on the System.
 		/// </summary>
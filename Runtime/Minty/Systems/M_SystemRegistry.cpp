@@ -2,6 +2,9 @@
 #include "Minty/Systems/M_SystemRegistry.h"
 
 #include "Minty/Systems/M_System.h"
+#include "Minty/Scenes/M_Scene.h"
+#include "Minty/Entities/M_EntityRegistry.h"
+#include "Minty/Multithreading/M_JobSystem.h"
 #include "Minty/Tools/M_Console.h"
 #include "Minty/Tools/M_Parse.h"
 #include "Minty/Serialization/M_Reader.h"
@@ -27,6 +30,11 @@ namespace Minty
 		, _orderedSystems(std::move(other._orderedSystems))
 		, _allSystems(std::move(other._allSystems))
 		, _typeLookup(std::move(other._typeLookup))
+		, _schedule()
+		, _scheduleDirty(true)
+		, _timings()
+		, _criticalPathTime()
+		, _criticalPath()
 	{}
 
 	SystemRegistry& SystemRegistry::operator=(SystemRegistry&& other) noexcept
@@ -37,6 +45,11 @@ namespace Minty
 			_orderedSystems = std::move(other._orderedSystems);
 			_allSystems = std::move(other._allSystems);
 			_typeLookup = std::move(other._typeLookup);
+			_schedule.clear();
+			_scheduleDirty = true;
+			_timings.clear();
+			_criticalPathTime = 0.0f;
+			_criticalPath.clear();
 		}
 
 		return *this;
@@ -54,18 +67,9 @@ namespace Minty
 		_typeLookup.emplace(typeid(*system), system);
 
 		// add to ordered list for updating
-		auto found = _orderedSystems.find(priority);
-		if (found == _orderedSystems.end())
-		{
-			// new list
-			_orderedSystems.emplace(priority, std::set<System*>());
-			_orderedSystems.at(priority).emplace(system);
-		}
-		else
-		{
-			// existing list
-			found->second.emplace(system);
-		}
+		_orderedSystems[priority].push_back(system);
+
+		_scheduleDirty = true;
 
 		return system;
 	}
@@ -90,7 +94,7 @@ namespace Minty
 
 			for (auto& pair : _orderedSystems)
 			{
-				auto found2 = pair.second.find(found->second);
+				auto found2 = std::find(pair.second.begin(), pair.second.end(), found->second);
 
 				if (found2 != pair.second.end())
 				{
@@ -99,6 +103,8 @@ namespace Minty
 			}
 
 			_allSystems.erase(name);
+
+			_scheduleDirty = true;
 		}
 	}
 
@@ -120,24 +126,31 @@ namespace Minty
 
 	void SystemRegistry::update(Time const time)
 	{
-		for (auto& pair : _orderedSystems)
-		{
-			for (System* const system : pair.second)
-			{
-				system->update(time);
-			}
-		}
+		run([time](System& system) { system.update(time); }, true);
 	}
 
 	void SystemRegistry::fixed_update(Time const time)
 	{
-		for (auto& pair : _orderedSystems)
+		// skip the whole schedule if no system would do anything, since this can run several times per frame
+		bool any = false;
+		for (auto const& pair : _allSystems)
 		{
-			for (System* const system : pair.second)
+			if (pair.second->has_fixed_update())
 			{
-				system->fixed_update(time);
+				any = true;
+				break;
 			}
 		}
+
+		if (!any) return;
+
+		run([time](System& system)
+			{
+				if (system.has_fixed_update())
+				{
+					system.fixed_update(time);
+				}
+			}, false);
 	}
 
 	void SystemRegistry::unload()
@@ -162,6 +175,221 @@ namespace Minty
 		_allSystems.clear();
 		_orderedSystems.clear();
 		_typeLookup.clear();
+
+		_schedule.clear();
+		_scheduleDirty = true;
+		_timings.clear();
+		_criticalPathTime = 0.0f;
+		_criticalPath.clear();
+	}
+
+	void SystemRegistry::build_schedule()
+	{
+		_schedule.clear();
+		_schedule.reserve(_allSystems.size());
+
+		for (auto const& pair : _orderedSystems)
+		{
+			for (System* const system : pair.second)
+			{
+				ScheduledSystem scheduled
+				{
+					.system = system,
+				};
+
+				// wait for every earlier system that cannot run at the same time as this one
+				for (size_t i = 0; i < _schedule.size(); i++)
+				{
+					if (system->get_access().conflicts_with(_schedule.at(i).system->get_access()))
+					{
+						scheduled.dependencies.push_back(i);
+					}
+				}
+
+				_schedule.push_back(std::move(scheduled));
+			}
+		}
+
+		_scheduleDirty = false;
+	}
+
+	void SystemRegistry::run(std::function<void(System&)> const& func, bool const record)
+	{
+		if (_scheduleDirty)
+		{
+			build_schedule();
+		}
+
+		size_t const count = _schedule.size();
+
+		if (record)
+		{
+			_timings.resize(count);
+		}
+
+		if (!count)
+		{
+			_criticalPathTime = 0.0f;
+			_criticalPath.clear();
+			return;
+		}
+
+		// create any missing component storage now, since that is not safe while systems run at the same time
+		EntityRegistry& registry = get_scene().get_entity_registry();
+		for (ScheduledSystem const& scheduled : _schedule)
+		{
+			for (SystemStorageFunc const storage : scheduled.system->get_access().storages)
+			{
+				storage(registry);
+			}
+		}
+
+		TimePoint const start = Time::now();
+
+		auto runSystem = [this, &func, record, start](size_t const index)
+			{
+				System* const system = _schedule.at(index).system;
+
+				TimePoint const systemStart = Time::now();
+				func(*system);
+
+				if (record)
+				{
+					_timings.at(index) = SystemTiming
+					{
+						.system = system,
+						.start = Time::calculate_duration_seconds(start, systemStart),
+						.duration = Time::calculate_duration_seconds(systemStart, Time::now()),
+					};
+				}
+			};
+
+		// worker systems are scheduled as soon as everything they wait on is scheduled or done
+		// main thread systems run in order, but only after every worker system that can be scheduled has been,
+		// so a main thread system never holds back a worker system that does not depend on it
+		JobSystem& jobSystem = JobSystem::instance();
+		std::vector<JobHandle> jobs(count);
+		std::vector<bool> ran(count, false);
+		std::vector<size_t> pending;
+		std::vector<size_t> mainThread;
+		std::vector<JobHandle> dependencies;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			if (_schedule.at(i).system->get_access().mainThread)
+			{
+				mainThread.push_back(i);
+			}
+			else
+			{
+				pending.push_back(i);
+			}
+		}
+
+		// schedules the pending worker systems whose dependencies are all scheduled, or ran on the main thread
+		auto schedulePending = [this, &jobSystem, &jobs, &ran, &pending, &dependencies, &runSystem]()
+			{
+				size_t kept = 0;
+				for (size_t const i : pending)
+				{
+					ScheduledSystem const& scheduled = _schedule.at(i);
+
+					bool ready = true;
+					dependencies.clear();
+					for (size_t const dependency : scheduled.dependencies)
+					{
+						if (_schedule.at(dependency).system->get_access().mainThread)
+						{
+							ready = ran.at(dependency);
+						}
+						else
+						{
+							// pending worker systems come before this one, so they were checked first
+							ready = jobs.at(dependency).valid();
+							dependencies.push_back(jobs.at(dependency));
+						}
+
+						if (!ready) break;
+					}
+
+					if (ready)
+					{
+						jobs.at(i) = jobSystem.schedule([&runSystem, i]() { runSystem(i); }, dependencies);
+					}
+					else
+					{
+						pending.at(kept++) = i;
+					}
+				}
+				pending.resize(kept);
+			};
+
+		schedulePending();
+
+		for (size_t const i : mainThread)
+		{
+			// every worker system this depends on comes before it, so it has been scheduled by now
+			dependencies.clear();
+			for (size_t const dependency : _schedule.at(i).dependencies)
+			{
+				dependencies.push_back(jobs.at(dependency));
+			}
+			jobSystem.wait(dependencies);
+
+			runSystem(i);
+			ran.at(i) = true;
+
+			schedulePending();
+		}
+
+		MINTY_ASSERT(pending.empty());
+
+		jobSystem.wait(jobs);
+
+		if (record)
+		{
+			find_critical_path();
+		}
+	}
+
+	void SystemRegistry::find_critical_path()
+	{
+		size_t const count = _schedule.size();
+
+		// the longest time to finish each system, following its dependencies
+		std::vector<float> finish(count);
+		std::vector<size_t> previous(count, count);
+
+		size_t last = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			float longest = 0.0f;
+			for (size_t const dependency : _schedule.at(i).dependencies)
+			{
+				if (finish.at(dependency) > longest)
+				{
+					longest = finish.at(dependency);
+					previous.at(i) = dependency;
+				}
+			}
+
+			finish.at(i) = longest + _timings.at(i).duration;
+
+			if (finish.at(i) > finish.at(last))
+			{
+				last = i;
+			}
+		}
+
+		_criticalPathTime = finish.at(last);
+
+		// walk back from the system that finished last
+		_criticalPath.clear();
+		for (size_t i = last; i < count; i = previous.at(i))
+		{
+			_criticalPath.push_back(_schedule.at(i).system);
+		}
+		std::reverse(_criticalPath.begin(), _criticalPath.end());
 	}
 
 	std::vector<String> SystemRegistry::get_registered_systems()
@@ -1,16 +1,35 @@
 #pragma once
 #include "Minty/Scenes/M_SceneObject.h"
 
+#include "Minty/Systems/M_System.h"
 #include "Minty/Types/M_Time.h"
 #include <map>
 #include <unordered_map>
-#include <set>
 #include <functional>
 #include <vector>
 
 namespace Minty
 {
-	class System;
+	/// <summary>
+	/// How long one System took during the last update.
+	/// </summary>
+	struct SystemTiming
+	{
+		/// <summary>
+		/// The System that was updated.
+		/// </summary>
+		System const* system;
+
+		/// <summary>
+		/// When the System started, in seconds since the start of the update.
+		/// </summary>
+		float start;
+
+		/// <summary>
+		/// How long the System took, in seconds.
+		/// </summary>
+		float duration;
+	};
 
 	/// <summary>
 	/// Holds and managers data relevant to systems.
@@ -23,18 +42,35 @@ namespace Minty
 		typedef std::function<System* (Scene& scene)> SystemFunc;
 
 	private:
-		// the systems to manage
-		std::map<int, std::set<System*>> _orderedSystems;
+		// a system in the schedule, and the systems before it that it must wait for
+		struct ScheduledSystem
+		{
+			System* system;
+			std::vector<size_t> dependencies;
+		};
+
+		// the systems to manage, in the order they were added within each priority
+		std::map<int, std::vector<System*>> _orderedSystems;
 		std::map<String const, System*> _allSystems;
 		std::unordered_map<TypeID, System*> _typeLookup;
 
+		// the systems in update order, with the dependencies between them
+		// rebuilt when the systems change
+		std::vector<ScheduledSystem> _schedule;
+		bool _scheduleDirty;
+
+		// timings from the last update
+		std::vector<SystemTiming> _timings;
+		float _criticalPathTime;
+		std::vector<System const*> _criticalPath;
+
 		static std::map<String const, SystemFunc const> _systemTypes;
 	public:
 		/// <summary>
 		/// Creates an empty SystemRegistry.
 		/// </summary>
 		SystemRegistry(Scene& scene)
-			: SceneObject(scene) {}
+			: SceneObject(scene), _scheduleDirty(true), _criticalPathTime() {}
 
 		~SystemRegistry();
 
@@ -103,14 +139,35 @@ namespace Minty
 
 		/// <summary>
 		/// Runs the update method on each System within this SystemRegistry.
+		/// 
+		/// Systems run in priority order, except Systems that do not conflict, based on their SystemAccess, which may run at the same time on the JobSystem.
 		/// </summary>
 		void update(Time const time);
 
 		/// <summary>
-		/// Runs the fixedUpdate method on each System within this SystemRegistry.
+		/// Runs the fixedUpdate method on each System within this SystemRegistry, the same way as update.
+		/// Does nothing if no System has any fixed update work to do.
 		/// </summary>
 		void fixed_update(Time const time);
 
+		/// <summary>
+		/// Gets how long each System took during the last update, in update order.
+		/// </summary>
+		/// <returns></returns>
+		std::vector<SystemTiming> const& get_timings() const { return _timings; }
+
+		/// <summary>
+		/// Gets the longest chain of dependent Systems during the last update, which limits how fast the update can be.
+		/// </summary>
+		/// <returns></returns>
+		std::vector<System const*> const& get_critical_path() const { return _criticalPath; }
+
+		/// <summary>
+		/// Gets the total time of the critical path during the last update, in seconds.
+		/// </summary>
+		/// <returns></returns>
+		float get_critical_path_time() const { return _criticalPathTime; }
+
 		/// <summary>
 		/// Runs the unload method on each System within this SystemRegistry.
 		/// </summary>
@@ -121,6 +178,16 @@ namespace Minty
 		/// </summary>
 		void clear();
 
+	private:
+		// finds the dependencies between the systems
+		void build_schedule();
+
+		// runs the given function on each system, following the schedule
+		void run(std::function<void(System&)> const& func, bool const record);
+
+		// finds the critical path from the recorded timings
+		void find_critical_path();
+
 	public:
 		/// <summary>
 		/// Registers the System, so the System can be dynamically created by name.
@@ -184,7 +251,15 @@ namespace Minty
 			return;
 		}
 
-		_systemTypes.emplace(name, [](Scene& scene) { return new T(scene); });
+		_systemTypes.emplace(name, [](Scene& scene) -> System*
+			{
+				T* system = new T(scene);
+
+				// only systems that override fixed_update need the fixed update to run
+				system->_fixedUpdate = !std::is_same_v<decltype(&T::fixed_update), decltype(&System::fixed_update)>;
+
+				return system;
+			});
 
 		MINTY_INFO(std::format("Registered system {}.", name));
 	}
@@ -1,21 +1,309 @@
 #include "pch.h"
 #include "Minty/Tools/M_Compression.h"
 
+#include "Minty/Core/M_Base.h"
+#include "Minty/Tools/M_Console.h"
+
 #include <zlib.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
 
 using namespace Minty;
 
+namespace
+{
+    // LZ4 block format, see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+    // blocks are written without a frame, since the wrap entry already stores both sizes
+
+    // the shortest match that can be encoded
+    constexpr size_t LZ4_MIN_MATCH = 4;
+    // the last match must start at least this many bytes before the end of the block
+    constexpr size_t LZ4_MF_LIMIT = 12;
+    // the last bytes of the block are always literals
+    constexpr size_t LZ4_LAST_LITERALS = 5;
+    // the furthest back a match can be
+    constexpr size_t LZ4_MAX_DISTANCE = 65535;
+    // the number of bits used to hash 4 bytes into the match table
+    constexpr uint32_t LZ4_HASH_BITS = 16;
+
+    uint32_t lz4_read32(Byte const* const data)
+    {
+        uint32_t value;
+        memcpy(&value, data, sizeof(uint32_t));
+        return value;
+    }
+
+    uint32_t lz4_hash(uint32_t const value)
+    {
+        return (value * 2654435761u) >> (32 - LZ4_HASH_BITS);
+    }
+
+    // writes a length that did not fit in its 4 bits of the token
+    Byte* lz4_write_length(Byte* output, size_t length)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            *output++ = 255;
+        }
+        *output++ = static_cast<Byte>(length);
+        return output;
+    }
+
+    unsigned long lz4_compress_bound(unsigned long const sourceSize)
+    {
+        return sourceSize + sourceSize / 255 + 16;
+    }
+
+    // LZ4 has a single level here, so the level is only used to decide whether to compress at all, which the caller already did
+    int lz4_compress(void* const destination, unsigned long& destinationSize, void const* const source, unsigned long const sourceSize, CompressionLevel const level)
+    {
+        if (destinationSize < lz4_compress_bound(sourceSize)) return -1;
+
+        Byte const* const input = static_cast<Byte const*>(source);
+        Byte const* const inputEnd = input + sourceSize;
+        Byte* output = static_cast<Byte*>(destination);
+
+        // writes a sequence of literals, followed by a match if matchLength is not 0
+        auto write_sequence = [&output](Byte const* const literals, size_t const literalLength, size_t const offset, size_t const matchLength)
+            {
+                Byte* token = output++;
+                *token = static_cast<Byte>(std::min<size_t>(literalLength, 15) << 4);
+                if (literalLength >= 15) output = lz4_write_length(output, literalLength - 15);
+                if (literalLength) memcpy(output, literals, literalLength);
+                output += literalLength;
+
+                if (!matchLength) return;
+
+                *output++ = static_cast<Byte>(offset & 0xff);
+                *output++ = static_cast<Byte>(offset >> 8);
+                size_t const length = matchLength - LZ4_MIN_MATCH;
+                *token |= static_cast<Byte>(std::min<size_t>(length, 15));
+                if (length >= 15) output = lz4_write_length(output, length - 15);
+            };
+
+        Byte const* anchor = input;
+
+        if (sourceSize > LZ4_MF_LIMIT)
+        {
+            // the last position a match can start at, and the last position a match can reach
+            Byte const* const matchLimit = inputEnd - LZ4_MF_LIMIT;
+            Byte const* const matchEnd = inputEnd - LZ4_LAST_LITERALS;
+
+            // position + 1 of the last time each hash was seen, 0 if never
+            std::vector<uint32_t> table(size_t(1) << LZ4_HASH_BITS, 0);
+
+            Byte const* position = input;
+            uint32_t misses = 0;
+            while (position < matchLimit)
+            {
+                uint32_t const value = lz4_read32(position);
+                uint32_t& slot = table[lz4_hash(value)];
+                Byte const* const candidate = slot ? input + (slot - 1) : nullptr;
+                slot = static_cast<uint32_t>(position - input) + 1;
+
+                if (!candidate || static_cast<size_t>(position - candidate) > LZ4_MAX_DISTANCE || lz4_read32(candidate) != value)
+                {
+                    // skip ahead faster the longer nothing is found, like the reference encoder
+                    position += 1 + (misses++ >> 6);
+                    continue;
+                }
+                misses = 0;
+
+                // extend the match backwards over the pending literals
+                Byte const* start = position;
+                Byte const* match = candidate;
+                while (start > anchor && match > input && start[-1] == match[-1])
+                {
+                    start--;
+                    match--;
+                }
+
+                // extend the match forwards
+                Byte const* end = position + LZ4_MIN_MATCH;
+                match = candidate + LZ4_MIN_MATCH;
+                while (end < matchEnd && *end == *match)
+                {
+                    end++;
+                    match++;
+                }
+
+                write_sequence(anchor, static_cast<size_t>(start - anchor), static_cast<size_t>(position - candidate), static_cast<size_t>(end - start));
+
+                anchor = end;
+                position = end;
+            }
+        }
+
+        // the rest are literals
+        write_sequence(anchor, static_cast<size_t>(inputEnd - anchor), 0, 0);
+
+        destinationSize = static_cast<unsigned long>(output - static_cast<Byte*>(destination));
+        return 0;
+    }
+
+    int lz4_uncompress(void* const destination, unsigned long& destinationSize, void const* const source, unsigned long& sourceSize)
+    {
+        Byte const* input = static_cast<Byte const*>(source);
+        Byte const* const inputEnd = input + sourceSize;
+        Byte* const outputStart = static_cast<Byte*>(destination);
+        Byte* output = outputStart;
+        Byte* const outputEnd = output + destinationSize;
+
+        // reads a length that did not fit in its 4 bits of the token, false if the data ended
+        auto read_length = [&input, inputEnd](size_t& length)
+            {
+                Byte next;
+                do
+                {
+                    if (input >= inputEnd) return false;
+                    next = *input++;
+                    length += next;
+                } while (next == 255);
+                return true;
+            };
+
+        while (input < inputEnd)
+        {
+            Byte const token = *input++;
+
+            // copy the literals
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !read_length(literalLength)) return -1;
+            if (literalLength > static_cast<size_t>(inputEnd - input) || literalLength > static_cast<size_t>(outputEnd - output)) return -1;
+            if (literalLength) memcpy(output, input, literalLength);
+            input += literalLength;
+            output += literalLength;
+
+            // the last sequence has no match
+            if (input == inputEnd) break;
+
+            // copy the match
+            if (inputEnd - input < 2) return -1;
+            size_t const offset = static_cast<size_t>(input[0]) | (static_cast<size_t>(input[1]) << 8);
+            input += 2;
+            if (!offset || offset > static_cast<size_t>(output - outputStart)) return -1;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !read_length(matchLength)) return -1;
+            matchLength += LZ4_MIN_MATCH;
+            if (matchLength > static_cast<size_t>(outputEnd - output)) return -1;
+
+            Byte const* match = output - offset;
+            if (offset >= matchLength)
+            {
+                memcpy(output, match, matchLength);
+                output += matchLength;
+            }
+            else
+            {
+                // overlaps with itself, so copy forwards one at a time to repeat the pattern
+                for (size_t i = 0; i < matchLength; i++)
+                {
+                    *output++ = *match++;
+                }
+            }
+        }
+
+        destinationSize = static_cast<unsigned long>(output - outputStart);
+        sourceSize = static_cast<unsigned long>(input - static_cast<Byte const*>(source));
+        return 0;
+    }
+
+    // codec ID -> functions, empty if not registered
+    std::array<CompressionFuncs, 256>& get_codecs()
+    {
+        static std::array<CompressionFuncs, 256> codecs = []()
+            {
+                std::array<CompressionFuncs, 256> result{};
+                result[static_cast<size_t>(CompressionCodec::Zlib)] = CompressionFuncs
+                {
+                    .name = "Zlib",
+                    .bound = Minty::compress_bound,
+                    .compress = Minty::compress,
+                    .uncompress = Minty::uncompress,
+                };
+                result[static_cast<size_t>(CompressionCodec::LZ4)] = CompressionFuncs
+                {
+                    .name = "LZ4",
+                    .bound = lz4_compress_bound,
+                    .compress = lz4_compress,
+                    .uncompress = lz4_uncompress,
+                };
+                return result;
+            }();
+
+        return codecs;
+    }
+
+    // gets the registered functions for the given codec, or null if not registered
+    CompressionFuncs const* find_codec(CompressionCodec const codec)
+    {
+        CompressionFuncs const& funcs = get_codecs()[static_cast<size_t>(codec)];
+
+        if (!funcs.bound || !funcs.compress || !funcs.uncompress)
+        {
+            MINTY_ERROR_FORMAT("Compression codec {} is not registered.", static_cast<int>(codec));
+            return nullptr;
+        }
+
+        return &funcs;
+    }
+}
+
+void Minty::register_compression_codec(CompressionCodec const codec, CompressionFuncs const& funcs)
+{
+    get_codecs()[static_cast<size_t>(codec)] = funcs;
+}
+
+bool Minty::is_compression_codec_registered(CompressionCodec const codec)
+{
+    CompressionFuncs const& funcs = get_codecs()[static_cast<size_t>(codec)];
+    return funcs.bound && funcs.compress && funcs.uncompress;
+}
+
+char const* Minty::get_compression_codec_name(CompressionCodec const codec)
+{
+    CompressionFuncs const& funcs = get_codecs()[static_cast<size_t>(codec)];
+    return funcs.name ? funcs.name : "Unknown";
+}
+
 unsigned long Minty::compress_bound(unsigned long const sourceSize)
 {
     return compressBound(sourceSize);
 }
 
-int Minty::compress(void* const destination, unsigned long& destinationSize, void* const source, unsigned long const sourceSize, CompressionLevel const level)
+int Minty::compress(void* const destination, unsigned long& destinationSize, void const* const source, unsigned long const sourceSize, CompressionLevel const level)
+{
+    return compress2(static_cast<Bytef*>(destination), &destinationSize, static_cast<Bytef const*>(source), sourceSize, static_cast<int>(level));
+}
+
+int Minty::uncompress(void* const destination, unsigned long& destinationSize, void const* const source, unsigned long& sourceSize)
 {
-    return compress2(static_cast<Bytef*>(destination), &destinationSize, static_cast<Bytef*>(source), sourceSize, static_cast<int>(level));
+    return uncompress2(static_cast<Bytef*>(destination), &destinationSize, static_cast<Bytef const*>(source), &sourceSize);
 }
 
-int Minty::uncompress(void* const destination, unsigned long& destinationSize, void* const source, unsigned long& sourceSize)
+unsigned long Minty::compress_bound(CompressionCodec const codec, unsigned long const sourceSize)
 {
-    return uncompress2(static_cast<Bytef*>(destination), &destinationSize, static_cast<Bytef*>(source), &sourceSize);
+    CompressionFuncs const* funcs = find_codec(codec);
+    if (!funcs) return 0;
+
+    return funcs->bound(sourceSize);
+}
+
+int Minty::compress(CompressionCodec const codec, void* const destination, unsigned long& destinationSize, void const* const source, unsigned long const sourceSize, CompressionLevel const level)
+{
+    CompressionFuncs const* funcs = find_codec(codec);
+    if (!funcs) return -1;
+
+    return funcs->compress(destination, destinationSize, source, sourceSize, level);
+}
+
+int Minty::uncompress(CompressionCodec const codec, void* const destination, unsigned long& destinationSize, void const* const source, unsigned long& sourceSize)
+{
+    CompressionFuncs const* funcs = find_codec(codec);
+    if (!funcs) return -1;
+
+    return funcs->uncompress(destination, destinationSize, source, sourceSize);
 }
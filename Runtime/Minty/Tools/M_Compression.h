@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace Minty
 {
 	/// <summary>
@@ -47,6 +49,80 @@ namespace Minty
 		Default = Level6,
 	};
 
+	/// <summary>
+	/// The algorithm used to compress data being stored in a wrap file.
+	/// </summary>
+	enum class CompressionCodec : uint8_t
+	{
+		/// <summary>
+		/// zlib (deflate). The default, and the codec used by all older wrap files.
+		/// </summary>
+		Zlib = 0,
+
+		/// <summary>
+		/// LZ4 (raw block). Compresses less than zlib, but uncompresses several times faster.
+		/// </summary>
+		LZ4 = 1,
+	};
+
+	/// <summary>
+	/// The settings used to compress a file being stored in a wrap file.
+	/// </summary>
+	struct CompressionSettings
+	{
+		/// <summary>
+		/// The codec to compress with.
+		/// </summary>
+		CompressionCodec codec = CompressionCodec::Zlib;
+
+		/// <summary>
+		/// The level to compress with. If None, the data is stored as is.
+		/// </summary>
+		CompressionLevel level = CompressionLevel::Default;
+	};
+
+	typedef unsigned long (*CompressionBoundFunc)(unsigned long const sourceSize);
+	typedef int (*CompressionCompressFunc)(void* const destination, unsigned long& destinationSize, void const* const source, unsigned long const sourceSize, CompressionLevel const level);
+	typedef int (*CompressionUncompressFunc)(void* const destination, unsigned long& destinationSize, void const* const source, unsigned long& sourceSize);
+
+	/// <summary>
+	/// The functions that implement a CompressionCodec.
+	/// </summary>
+	struct CompressionFuncs
+	{
+		/// <summary>
+		/// The name of the codec.
+		/// </summary>
+		char const* name;
+
+		CompressionBoundFunc bound;
+		CompressionCompressFunc compress;
+		CompressionUncompressFunc uncompress;
+	};
+
+	/// <summary>
+	/// Registers the functions for the given codec, so data can be compressed and uncompressed with it. Replaces any existing functions.
+	/// 
+	/// Codecs should be registered before any data is compressed or uncompressed, as the registry is not synchronized.
+	/// </summary>
+	/// <param name="codec">The codec ID, as stored within wrap files.</param>
+	/// <param name="funcs">The functions that implement the codec.</param>
+	void register_compression_codec(CompressionCodec const codec, CompressionFuncs const& funcs);
+
+	/// <summary>
+	/// Checks if the given codec has been registered.
+	/// </summary>
+	/// <param name="codec"></param>
+	/// <returns></returns>
+	bool is_compression_codec_registered(CompressionCodec const codec);
+
+	/// <summary>
+	/// Gets the name of the given codec.
+	/// </summary>
+	/// <param name="codec"></param>
+	/// <returns>The name, or "Unknown" if the codec is not registered.</returns>
+	char const* get_compression_codec_name(CompressionCodec const codec);
+
 	/// <summary>
 	/// Given the size of the uncompressed data, returns the size of the compressed data array.
 	/// </summary>
@@ -63,7 +139,7 @@ namespace Minty
 	/// <param name="sourceSize"></param>
 	/// <param name="level"></param>
 	/// <returns>0 on success.</returns>
-	int compress(void* const destination, unsigned long& destinationSize, void* const source, unsigned long const sourceSize, CompressionLevel const level = CompressionLevel::Default);
+	int compress(void* const destination, unsigned long& destinationSize, void const* const source, unsigned long const sourceSize, CompressionLevel const level = CompressionLevel::Default);
 
 	/// <summary>
 	/// Uncompresses the given data from source to destination.
@@ -73,5 +149,36 @@ namespace Minty
 	/// <param name="source"></param>
 	/// <param name="sourceSize"></param>
 	/// <returns>0 on success.</returns>
-	int uncompress(void* const destination, unsigned long& destinationSize, void* const source, unsigned long& sourceSize);
+	int uncompress(void* const destination, unsigned long& destinationSize, void const* const source, unsigned long& sourceSize);
+
+	/// <summary>
+	/// Given the size of the uncompressed data, returns the size of the compressed data array, using the given codec.
+	/// </summary>
+	/// <param name="codec"></param>
+	/// <param name="sourceSize"></param>
+	/// <returns>The size of the compressed data array, in bytes, or 0 if the codec is not registered.</returns>
+	unsigned long compress_bound(CompressionCodec const codec, unsigned long const sourceSize);
+
+	/// <summary>
+	/// Compresses the given data from source to destination, using the given codec.
+	/// </summary>
+	/// <param name="codec"></param>
+	/// <param name="destination"></param>
+	/// <param name="destinationSize"></param>
+	/// <param name="source"></param>
+	/// <param name="sourceSize"></param>
+	/// <param name="level"></param>
+	/// <returns>0 on success.</returns>
+	int compress(CompressionCodec const codec, void* const destination, unsigned long& destinationSize, void const* const source, unsigned long const sourceSize, CompressionLevel const level = CompressionLevel::Default);
+
+	/// <summary>
+	/// Uncompresses the given data from source to destination, using the given codec.
+	/// </summary>
+	/// <param name="codec"></param>
+	/// <param name="destination"></param>
+	/// <param name="destinationSize"></param>
+	/// <param name="source"></param>
+	/// <param name="sourceSize"></param>
+	/// <returns>0 on success.</returns>
+	int uncompress(CompressionCodec const codec, void* const destination, unsigned long& destinationSize, void const* const source, unsigned long& sourceSize);
 }
\ No newline at end of file
@@ -4,6 +4,33 @@
 
 namespace Minty
 {
+	/// <summary>
+	/// Holds the timing for the fixed step simulation.
+	/// </summary>
+	struct FixedTime
+	{
+		/// <summary>
+		/// The length of one fixed step, in seconds.
+		/// </summary>
+		float step;
+
+		/// <summary>
+		/// The total simulated time in seconds, from all of the fixed steps so far.
+		/// </summary>
+		float total;
+
+		/// <summary>
+		/// The number of fixed steps ran this frame.
+		/// </summary>
+		uint32_t steps;
+
+		/// <summary>
+		/// How far the frame is between the last fixed step and the next one, from 0 to 1.
+		/// Used to interpolate between the last two simulated states when rendering.
+		/// </summary>
+		float alpha;
+	};
+
 	struct Time
 	{
 		/// <summary>
@@ -16,6 +43,11 @@ namespace Minty
 		/// </summary>
 		float elapsed;
 
+		/// <summary>
+		/// The fixed step timing.
+		/// </summary>
+		FixedTime fixed;
+
 		/// <summary>
 		/// Gets the TimePoint for now.
 		/// </summary>
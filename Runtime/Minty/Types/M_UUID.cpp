@@ -2,13 +2,97 @@
 #include "Minty/Types/M_UUID.h"
 
 #include "Minty/Tools/M_Encoding.h"
+#include <atomic>
+#include <chrono>
 #include <random>
 
 using namespace Minty;
 
-static std::random_device randomDevice;
-static std::mt19937_64 randomEngine(randomDevice());
-static std::uniform_int_distribution<uint64_t> uniformDistribution;
+// steps the state, and returns a well mixed value from it
+static uint64_t splitmix64(uint64_t& state)
+{
+	uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
+
+// random for each run of the program, so each run generates different UUIDs
+static uint64_t get_process_salt()
+{
+	static uint64_t const salt = []()
+		{
+			std::random_device randomDevice;
+			uint64_t value = (static_cast<uint64_t>(randomDevice()) << 32) ^ static_cast<uint64_t>(randomDevice());
+			return value ^ static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+		}();
+
+	return salt;
+}
+
+/// <summary>
+/// A xoshiro256** generator, used to generate the UUIDs on a single thread.
+/// </summary>
+class UUIDGenerator
+{
+private:
+	uint64_t _state[4];
+
+	// the number of generators created, so each thread is seeded differently
+	static std::atomic<uint64_t> _count;
+
+public:
+	UUIDGenerator()
+	{
+		uint64_t index = _count.fetch_add(1, std::memory_order_relaxed);
+		uint64_t seed = get_process_salt() ^ splitmix64(index);
+
+		for (uint64_t& state : _state)
+		{
+			state = splitmix64(seed);
+		}
+	}
+
+	uint64_t next()
+	{
+		uint64_t const result = rotate_left(_state[1] * 5, 7) * 9;
+		uint64_t const t = _state[1] << 17;
+
+		_state[2] ^= _state[0];
+		_state[3] ^= _state[1];
+		_state[1] ^= _state[2];
+		_state[0] ^= _state[3];
+
+		_state[2] ^= t;
+		_state[3] = rotate_left(_state[3], 45);
+
+		return result;
+	}
+
+private:
+	static uint64_t rotate_left(uint64_t const value, int const shift)
+	{
+		return (value << shift) | (value >> (64 - shift));
+	}
+};
+
+std::atomic<uint64_t> UUIDGenerator::_count = 0;
+
+// each thread has its own generator, so no locking is needed
+static thread_local UUIDGenerator generator;
+
+// gets the next valid UUID value from the given generator
+static uint64_t next_uuid(UUIDGenerator& uuidGenerator)
+{
+	uint64_t value;
+
+	do
+	{
+		value = uuidGenerator.next();
+	} while (value == INVALID_UUID);
+
+	return value;
+}
 
 bool Minty::UUID::operator==(UUID const other) const
 {
@@ -37,7 +121,18 @@ bool Minty::UUID::operator!() const
 
 UUID Minty::UUID::create()
 {
-	return UUID(uniformDistribution(randomEngine));
+	return UUID(next_uuid(generator));
+}
+
+void Minty::UUID::create_many(std::span<UUID> const uuids)
+{
+	// get the thread's generator once for all of the UUIDs
+	UUIDGenerator& uuidGenerator = generator;
+
+	for (UUID& uuid : uuids)
+	{
+		uuid = UUID(next_uuid(uuidGenerator));
+	}
 }
 
 std::ostream& Minty::operator<<(std::ostream& stream, UUID const& object)
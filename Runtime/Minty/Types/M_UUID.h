@@ -1,6 +1,7 @@
 #pragma once
 #include "Minty/Types/M_Types.h"
 #include <cstdint>
+#include <span>
 
 namespace Minty
 {
@@ -52,8 +53,19 @@ namespace Minty
 		friend std::ostream& operator<<(std::ostream& stream, UUID const& object);
 		friend std::istream& operator>>(std::istream& stream, UUID& object);
 
+		/// <summary>
+		/// Creates a new UUID with a random, valid value.
+		/// Each thread has its own generator, so this is safe to call from any thread without locking.
+		/// </summary>
+		/// <returns></returns>
 		static UUID create();
 
+		/// <summary>
+		/// Fills the given UUIDs with new random, valid values.
+		/// </summary>
+		/// <param name="uuids">The UUIDs to fill.</param>
+		static void create_many(std::span<UUID> const uuids);
+
 	public:
 		friend String to_string(UUID const value);
 	};
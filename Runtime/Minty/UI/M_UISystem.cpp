@@ -5,11 +5,24 @@
 #include "Minty/Input/M_Input.h"
 #include "Minty/UI/M_UITransformComponent.h"
 #include "Minty/UI/M_CanvasComponent.h"
+#include "Minty/Components/M_RelationshipComponent.h"
 #include "Minty/Scripting/M_ScriptComponent.h"
 #include "Minty/Scenes/M_Scene.h"
 
 using namespace Minty;
 
+Minty::UISystem::UISystem(Scene& scene)
+	: System("UI", scene)
+	, _mousePosition()
+	, _mouseDown()
+	, _clicking()
+	, _family()
+{
+	// the pointer events run scripts, which may do anything to the Entities
+	declare_structural();
+	declare_reads<UITransformComponent, CanvasComponent, RelationshipComponent>();
+}
+
 void Minty::UISystem::update(Time const time)
 {
 	bool mouseDown = Input::get_mouse_button(MouseButton::Left) != KeyAction::Up;
@@ -22,8 +22,7 @@ namespace Minty
         std::unordered_set<Entity> _family;
 
     public:
-        UISystem(Scene& scene)
-            : System("UI", scene), _mousePosition(), _mouseDown(), _clicking(), _family() {}
+        UISystem(Scene& scene);
 
         void update(Time const time) override;
     };
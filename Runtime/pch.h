@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <future>
 #include <memory>
+#include <span>
 
 #include <type_traits>
 #include <typeindex>